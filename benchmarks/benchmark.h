@@ -0,0 +1,83 @@
+/**************************************************************************/
+/*  benchmark.h                                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "core/templates/local_vector.h"
+#include "core/typedefs.h"
+
+// Passed to every benchmark, which runs the code to measure in a loop:
+//
+//     while (p_state.next()) {
+//         // Measured code.
+//     }
+//
+// Each iteration is timed as one sample, after a few warm-up iterations which are not recorded.
+// Setup and cleanup code outside of the loop is not measured.
+class BenchmarkState {
+	uint32_t warmup_iterations = 0;
+	uint32_t sample_count = 0;
+	uint32_t iteration = 0;
+	uint64_t iteration_start = 0;
+	LocalVector<uint64_t> samples;
+	volatile uint64_t sink = 0;
+
+public:
+	bool next();
+	// Keeps the compiler from optimizing away results which are otherwise unused.
+	_FORCE_INLINE_ void keep(uint64_t p_value) { sink = sink + p_value; }
+	const LocalVector<uint64_t> &get_samples() const { return samples; }
+
+	BenchmarkState(uint32_t p_warmup_iterations, uint32_t p_sample_count);
+};
+
+typedef void (*BenchmarkFunc)(BenchmarkState &p_state);
+
+struct Benchmark {
+	const char *name = nullptr;
+	BenchmarkFunc function = nullptr;
+};
+
+int register_benchmark(const char *p_name, BenchmarkFunc p_function);
+
+#define _BENCHMARK_CONCAT_IMPL(m_a, m_b) m_a##m_b
+#define _BENCHMARK_CONCAT(m_a, m_b) _BENCHMARK_CONCAT_IMPL(m_a, m_b)
+#define _BENCHMARK_FUNC _BENCHMARK_CONCAT(_benchmark_func_, __LINE__)
+
+// Declares a benchmark named like test cases, with the area in brackets: "[HashMap] Insert".
+// Benchmarks are identified by line, so each header must declare them in its own namespace.
+#define BENCHMARK(m_name)                                                               \
+	static void _BENCHMARK_FUNC(BenchmarkState &p_state);                               \
+	[[maybe_unused]] static int _BENCHMARK_CONCAT(_benchmark_registration_, __LINE__) = \
+			register_benchmark(m_name, &_BENCHMARK_FUNC);                               \
+	static void _BENCHMARK_FUNC(BenchmarkState &p_state)
+
+#endif // BENCHMARK_H
@@ -0,0 +1,198 @@
+/**************************************************************************/
+/*  benchmark_main.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "benchmark_main.h"
+
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/os/os.h"
+#include "core/version.h"
+
+#include "benchmarks/benchmark.h"
+
+#include "benchmarks/core/bench_resource.h"
+#include "benchmarks/core/bench_string.h"
+#include "benchmarks/core/bench_templates.h"
+#include "benchmarks/core/bench_variant.h"
+#include "benchmarks/modules/bench_gdscript.h"
+#include "benchmarks/scene/bench_packed_scene.h"
+#include "benchmarks/servers/bench_navigation_server_3d.h"
+#include "benchmarks/servers/bench_physics_server_3d.h"
+
+// Benchmarks register themselves during static initialization, so the list is created on first use.
+static LocalVector<Benchmark> &_get_benchmarks() {
+	static LocalVector<Benchmark> benchmarks;
+	return benchmarks;
+}
+
+int register_benchmark(const char *p_name, BenchmarkFunc p_function) {
+	Benchmark benchmark;
+	benchmark.name = p_name;
+	benchmark.function = p_function;
+	_get_benchmarks().push_back(benchmark);
+	return 0;
+}
+
+BenchmarkState::BenchmarkState(uint32_t p_warmup_iterations, uint32_t p_sample_count) {
+	warmup_iterations = p_warmup_iterations;
+	sample_count = p_sample_count;
+	samples.reserve(p_sample_count);
+}
+
+bool BenchmarkState::next() {
+	const uint64_t now = OS::get_singleton()->get_ticks_usec();
+	if (iteration > warmup_iterations) {
+		samples.push_back(now - iteration_start);
+	}
+	if (iteration >= warmup_iterations + sample_count) {
+		return false;
+	}
+	iteration++;
+	// Taken again, so the bookkeeping above is not measured.
+	iteration_start = OS::get_singleton()->get_ticks_usec();
+	return true;
+}
+
+static Dictionary _get_benchmark_result(const String &p_name, const LocalVector<uint64_t> &p_samples) {
+	LocalVector<uint64_t> sorted = p_samples;
+	sorted.sort();
+
+	uint64_t total = 0;
+	Array samples;
+	for (const uint64_t sample : p_samples) {
+		total += sample;
+		samples.push_back(sample);
+	}
+
+	Dictionary result;
+	result["name"] = p_name;
+	result["min_usec"] = sorted[0];
+	result["median_usec"] = sorted[sorted.size() / 2];
+	result["mean_usec"] = total / sorted.size();
+	result["max_usec"] = sorted[sorted.size() - 1];
+	result["samples_usec"] = samples;
+	return result;
+}
+
+static void _print_help() {
+	OS::get_singleton()->print("Usage: --benchmarks [options]\n");
+	OS::get_singleton()->print("  --filter <text>       Only run the benchmarks whose name contains the given text (case-insensitive).\n");
+	OS::get_singleton()->print("  --samples <count>     Number of measured iterations of each benchmark (default: 10).\n");
+	OS::get_singleton()->print("  --warmup <count>      Number of iterations run before measuring (default: 2).\n");
+	OS::get_singleton()->print("  --output <file>       Save the results to the given file in JSON format.\n");
+	OS::get_singleton()->print("  --list                List the benchmarks without running them.\n");
+}
+
+int benchmark_main(int argc, char *argv[]) {
+	List<String> args;
+	for (int i = 0; i < argc; i++) {
+		args.push_back(String::utf8(argv[i]));
+	}
+	OS::get_singleton()->set_cmdline("", args, List<String>());
+
+	String filter;
+	String output_path;
+	int sample_count = 10;
+	int warmup_count = 2;
+	bool list_only = false;
+	for (const List<String>::Element *E = args.front(); E; E = E->next()) {
+		const String &arg = E->get();
+		if (arg == "--help" || arg == "-h") {
+			_print_help();
+			return 0;
+		} else if (arg == "--list") {
+			list_only = true;
+		} else if ((arg == "--filter" || arg == "--samples" || arg == "--warmup" || arg == "--output") && !E->next()) {
+			OS::get_singleton()->print("Missing argument for %s, aborting.\n", arg.utf8().get_data());
+			return 1;
+		} else if (arg == "--filter") {
+			E = E->next();
+			filter = E->get();
+		} else if (arg == "--samples") {
+			E = E->next();
+			sample_count = MAX(E->get().to_int(), 1);
+		} else if (arg == "--warmup") {
+			E = E->next();
+			warmup_count = MAX(E->get().to_int(), 0);
+		} else if (arg == "--output") {
+			E = E->next();
+			output_path = E->get();
+		}
+	}
+
+	const LocalVector<Benchmark> &benchmarks = _get_benchmarks();
+	if (benchmarks.is_empty()) {
+		OS::get_singleton()->print("No benchmarks were registered.\n");
+		return 1;
+	}
+
+	int failed = 0;
+	Array results;
+	for (const Benchmark &benchmark : benchmarks) {
+		const String name = String::utf8(benchmark.name);
+		if (!filter.is_empty() && name.findn(filter) == -1) {
+			continue;
+		}
+		if (list_only) {
+			OS::get_singleton()->print("%s\n", benchmark.name);
+			continue;
+		}
+
+		BenchmarkState state(warmup_count, sample_count);
+		benchmark.function(state);
+		if (state.get_samples().size() != uint32_t(sample_count)) {
+			OS::get_singleton()->printerr("%s: FAILED (not all samples were taken)\n", benchmark.name);
+			failed++;
+			continue;
+		}
+
+		const Dictionary result = _get_benchmark_result(name, state.get_samples());
+		results.push_back(result);
+		OS::get_singleton()->print("%s: median %s usec (min %s, max %s)\n", benchmark.name,
+				String(result["median_usec"]).utf8().get_data(), String(result["min_usec"]).utf8().get_data(), String(result["max_usec"]).utf8().get_data());
+	}
+
+	if (!output_path.is_empty() && !list_only) {
+		Dictionary report;
+		report["version"] = VERSION_FULL_BUILD;
+		report["hash"] = VERSION_HASH;
+		report["samples"] = sample_count;
+		report["warmup"] = warmup_count;
+		report["benchmarks"] = results;
+
+		Error err;
+		Ref<FileAccess> f = FileAccess::open(output_path, FileAccess::WRITE, &err);
+		ERR_FAIL_COND_V_MSG(f.is_null(), 1, "Cannot open file '" + output_path + "' to save the benchmark results.");
+		f->store_string(JSON::stringify(report, "\t", false));
+		f->store_line("");
+	}
+
+	return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,103 @@
+/**************************************************************************/
+/*  bench_resource.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCH_RESOURCE_H
+#define BENCH_RESOURCE_H
+
+#include "core/io/resource.h"
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+
+#include "benchmarks/benchmark.h"
+
+namespace BenchResource {
+
+static String save_test_resource(const String &p_extension) {
+	RandomPCG rng(1);
+
+	Ref<Resource> resource = memnew(Resource);
+	PackedVector3Array points;
+	for (int i = 0; i < 10000; i++) {
+		points.push_back(Vector3(rng.randf(), rng.randf(), rng.randf()));
+	}
+	resource->set_meta("points", points);
+
+	Dictionary dictionary;
+	for (int i = 0; i < 1000; i++) {
+		dictionary["key_" + itos(i)] = i;
+	}
+	resource->set_meta("dictionary", dictionary);
+
+	Array children;
+	for (int i = 0; i < 100; i++) {
+		Ref<Resource> child = memnew(Resource);
+		child->set_name("Child " + itos(i));
+		child->set_meta("transform", Transform3D(Basis(), Vector3(i, i, i)));
+		children.push_back(child);
+	}
+	resource->set_meta("children", children);
+
+	const String path = OS::get_singleton()->get_cache_path().path_join("benchmark_resource." + p_extension);
+	ResourceSaver::save(resource, path);
+	return path;
+}
+
+BENCHMARK("[Resource] Load binary resource") {
+	const String path = save_test_resource("res");
+
+	while (p_state.next()) {
+		Ref<Resource> resource = ResourceLoader::load(path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		p_state.keep(resource.is_valid());
+	}
+}
+
+BENCHMARK("[Resource] Load text resource") {
+	const String path = save_test_resource("tres");
+
+	while (p_state.next()) {
+		Ref<Resource> resource = ResourceLoader::load(path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		p_state.keep(resource.is_valid());
+	}
+}
+
+BENCHMARK("[Resource] Save binary resource") {
+	const String path = save_test_resource("res");
+	Ref<Resource> resource = ResourceLoader::load(path);
+
+	while (p_state.next()) {
+		p_state.keep(ResourceSaver::save(resource, path));
+	}
+}
+
+} // namespace BenchResource
+
+#endif // BENCH_RESOURCE_H
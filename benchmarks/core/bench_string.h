@@ -0,0 +1,110 @@
+/**************************************************************************/
+/*  bench_string.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCH_STRING_H
+#define BENCH_STRING_H
+
+#include "core/string/string_name.h"
+#include "core/string/ustring.h"
+#include "core/templates/vector.h"
+
+#include "benchmarks/benchmark.h"
+
+namespace BenchString {
+
+constexpr int STRING_COUNT = 10000;
+
+BENCHMARK("[String] Concatenate") {
+	while (p_state.next()) {
+		String string;
+		for (int i = 0; i < STRING_COUNT; i++) {
+			string += "item_";
+			string += itos(i);
+		}
+		p_state.keep(string.length());
+	}
+}
+
+BENCHMARK("[String] Split and join") {
+	String source;
+	for (int i = 0; i < STRING_COUNT; i++) {
+		source += "item_" + itos(i) + ",";
+	}
+
+	while (p_state.next()) {
+		Vector<String> parts = source.split(",");
+		p_state.keep(String(";").join(parts).length());
+	}
+}
+
+BENCHMARK("[String] Format and convert numbers") {
+	while (p_state.next()) {
+		int64_t sum = 0;
+		for (int i = 0; i < STRING_COUNT; i++) {
+			sum += vformat("%d", i).to_int();
+			sum += int64_t(String::num(i * 0.5).to_float());
+		}
+		p_state.keep(sum);
+	}
+}
+
+BENCHMARK("[StringName] Create from String") {
+	Vector<String> names;
+	for (int i = 0; i < STRING_COUNT; i++) {
+		names.push_back("name_" + itos(i % 1000));
+	}
+
+	while (p_state.next()) {
+		uint64_t hash = 0;
+		for (int i = 0; i < names.size(); i++) {
+			hash += StringName(names[i]).hash();
+		}
+		p_state.keep(hash);
+	}
+}
+
+BENCHMARK("[StringName] Compare") {
+	Vector<StringName> names;
+	for (int i = 0; i < 100; i++) {
+		names.push_back(StringName("name_" + itos(i)));
+	}
+
+	while (p_state.next()) {
+		uint64_t equal = 0;
+		for (int i = 0; i < STRING_COUNT * 100; i++) {
+			equal += names[i % 100] == names[(i * 7) % 100];
+		}
+		p_state.keep(equal);
+	}
+}
+
+} // namespace BenchString
+
+#endif // BENCH_STRING_H
@@ -0,0 +1,136 @@
+/**************************************************************************/
+/*  bench_templates.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCH_TEMPLATES_H
+#define BENCH_TEMPLATES_H
+
+#include "core/math/random_pcg.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/vector.h"
+
+#include "benchmarks/benchmark.h"
+
+namespace BenchTemplates {
+
+constexpr int ELEMENT_COUNT = 100000;
+
+BENCHMARK("[HashMap] Insert int keys") {
+	while (p_state.next()) {
+		HashMap<int, int> map;
+		for (int i = 0; i < ELEMENT_COUNT; i++) {
+			map.insert(i * 7, i);
+		}
+		p_state.keep(map.size());
+	}
+}
+
+BENCHMARK("[HashMap] Look up int keys") {
+	HashMap<int, int> map;
+	for (int i = 0; i < ELEMENT_COUNT; i++) {
+		map.insert(i * 7, i);
+	}
+	RandomPCG rng(1);
+
+	while (p_state.next()) {
+		uint64_t found = 0;
+		for (int i = 0; i < ELEMENT_COUNT; i++) {
+			found += map.has(rng.random(0, ELEMENT_COUNT * 7));
+		}
+		p_state.keep(found);
+	}
+}
+
+BENCHMARK("[HashMap] Insert and erase String keys") {
+	Vector<String> keys;
+	for (int i = 0; i < ELEMENT_COUNT / 10; i++) {
+		keys.push_back("key_" + itos(i));
+	}
+
+	while (p_state.next()) {
+		HashMap<String, int> map;
+		for (int i = 0; i < keys.size(); i++) {
+			map.insert(keys[i], i);
+		}
+		for (int i = 0; i < keys.size(); i += 2) {
+			map.erase(keys[i]);
+		}
+		p_state.keep(map.size());
+	}
+}
+
+BENCHMARK("[HashSet] Insert int keys") {
+	while (p_state.next()) {
+		HashSet<int> set;
+		for (int i = 0; i < ELEMENT_COUNT; i++) {
+			set.insert(i * 7);
+		}
+		p_state.keep(set.size());
+	}
+}
+
+BENCHMARK("[Vector] Push back") {
+	while (p_state.next()) {
+		Vector<int> vector;
+		for (int i = 0; i < ELEMENT_COUNT; i++) {
+			vector.push_back(i);
+		}
+		p_state.keep(vector.size());
+	}
+}
+
+BENCHMARK("[Vector] Sort") {
+	Vector<int> source;
+	RandomPCG rng(1);
+	for (int i = 0; i < ELEMENT_COUNT; i++) {
+		source.push_back(rng.rand());
+	}
+
+	while (p_state.next()) {
+		Vector<int> vector = source;
+		vector.sort();
+		p_state.keep(vector[0]);
+	}
+}
+
+BENCHMARK("[LocalVector] Push back") {
+	while (p_state.next()) {
+		LocalVector<int> vector;
+		for (int i = 0; i < ELEMENT_COUNT; i++) {
+			vector.push_back(i);
+		}
+		p_state.keep(vector.size());
+	}
+}
+
+} // namespace BenchTemplates
+
+#endif // BENCH_TEMPLATES_H
@@ -0,0 +1,155 @@
+/**************************************************************************/
+/*  bench_variant.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCH_VARIANT_H
+#define BENCH_VARIANT_H
+
+#include "core/object/class_db.h"
+#include "core/object/method_bind.h"
+#include "core/variant/variant.h"
+
+#include "benchmarks/benchmark.h"
+
+namespace BenchVariant {
+
+constexpr int CALL_COUNT = 100000;
+
+BENCHMARK("[Variant] Arithmetic operators") {
+	while (p_state.next()) {
+		Variant sum = 0;
+		for (int i = 0; i < CALL_COUNT; i++) {
+			bool valid;
+			Variant::evaluate(Variant::OP_ADD, sum, i, sum, valid);
+		}
+		p_state.keep(int64_t(sum));
+	}
+}
+
+BENCHMARK("[Variant] Call built-in method") {
+	Variant vector = Vector2(3, 4);
+	const StringName method = "length";
+
+	while (p_state.next()) {
+		double sum = 0.0;
+		for (int i = 0; i < CALL_COUNT; i++) {
+			Callable::CallError ce;
+			Variant ret;
+			vector.callp(method, nullptr, 0, ret, ce);
+			sum += double(ret);
+		}
+		p_state.keep(sum);
+	}
+}
+
+BENCHMARK("[Variant] Call validated built-in method") {
+	Variant vector = Vector2(3, 4);
+	Variant::ValidatedBuiltInMethod method = Variant::get_validated_builtin_method(Variant::VECTOR2, "length");
+
+	while (p_state.next()) {
+		double sum = 0.0;
+		for (int i = 0; i < CALL_COUNT; i++) {
+			Variant ret;
+			method(&vector, nullptr, 0, &ret);
+			sum += double(ret);
+		}
+		p_state.keep(sum);
+	}
+}
+
+BENCHMARK("[Variant] Call built-in method with ptrcall") {
+	Vector2 vector(3, 4);
+	Variant::PTRBuiltInMethod method = Variant::get_ptr_builtin_method(Variant::VECTOR2, "length");
+
+	while (p_state.next()) {
+		double sum = 0.0;
+		for (int i = 0; i < CALL_COUNT; i++) {
+			double ret; // Floats are passed as doubles.
+			method(&vector, nullptr, &ret, 0);
+			sum += ret;
+		}
+		p_state.keep(sum);
+	}
+}
+
+BENCHMARK("[Object] Call method by name") {
+	Object *object = memnew(Object);
+	object->set_meta("value", 42);
+	const StringName method = "get_meta";
+	const Variant name = "value";
+	const Variant *args[1] = { &name };
+
+	while (p_state.next()) {
+		int64_t sum = 0;
+		for (int i = 0; i < CALL_COUNT; i++) {
+			Callable::CallError ce;
+			sum += int64_t(object->callp(method, args, 1, ce));
+		}
+		p_state.keep(sum);
+	}
+
+	memdelete(object);
+}
+
+BENCHMARK("[Object] Call MethodBind") {
+	Object *object = memnew(Object);
+	MethodBind *method = ClassDB::get_method("Object", "get_instance_id");
+
+	while (p_state.next()) {
+		uint64_t sum = 0;
+		for (int i = 0; i < CALL_COUNT; i++) {
+			Callable::CallError ce;
+			sum += uint64_t(method->call(object, nullptr, 0, ce));
+		}
+		p_state.keep(sum);
+	}
+
+	memdelete(object);
+}
+
+BENCHMARK("[Object] Call MethodBind with ptrcall") {
+	Object *object = memnew(Object);
+	MethodBind *method = ClassDB::get_method("Object", "get_instance_id");
+
+	while (p_state.next()) {
+		uint64_t sum = 0;
+		for (int i = 0; i < CALL_COUNT; i++) {
+			uint64_t ret;
+			method->ptrcall(object, nullptr, &ret);
+			sum += ret;
+		}
+		p_state.keep(sum);
+	}
+
+	memdelete(object);
+}
+
+} // namespace BenchVariant
+
+#endif // BENCH_VARIANT_H
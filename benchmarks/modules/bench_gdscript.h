@@ -0,0 +1,143 @@
+/**************************************************************************/
+/*  bench_gdscript.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCH_GDSCRIPT_H
+#define BENCH_GDSCRIPT_H
+
+#include "modules/modules_enabled.gen.h" // For gdscript.
+
+#ifdef MODULE_GDSCRIPT_ENABLED
+
+#include "modules/gdscript/gdscript.h"
+
+#include "benchmarks/benchmark.h"
+
+namespace BenchGDScript {
+
+static const char *BENCHMARK_SCRIPT = R"(
+extends RefCounted
+
+func int_loop(count: int) -> int:
+	var sum := 0
+	for i in count:
+		if i % 3 == 0:
+			sum += i * 2
+		else:
+			sum -= 1
+	return sum
+
+func float_loop(count: int) -> float:
+	var x := 0.0
+	var i := 0
+	while i < count:
+		x = x * 0.5 + float(i) * 0.25
+		i += 1
+	return x
+
+func vector_loop(count: int) -> float:
+	var position := Vector2()
+	var velocity := Vector2(1, 0.5)
+	for i in count:
+		position += velocity * 0.016
+		velocity = velocity.rotated(0.01)
+	return position.length()
+
+func call_loop(count: int) -> int:
+	var sum := 0
+	for i in count:
+		sum += add(i, 1)
+	return sum
+
+func add(a: int, b: int) -> int:
+	return a + b
+
+func array_loop(count: int) -> int:
+	var array: Array[int] = []
+	for i in count:
+		array.push_back(i)
+	var sum := 0
+	for value in array:
+		sum += value
+	return sum
+
+func dictionary_loop(count: int) -> int:
+	var dictionary := {}
+	for i in count:
+		dictionary[i] = i
+	var sum := 0
+	for key in dictionary:
+		sum += dictionary[key]
+	return sum
+)";
+
+static void bench_script_function(BenchmarkState &p_state, const StringName &p_function) {
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_source_code(BENCHMARK_SCRIPT);
+	ERR_FAIL_COND_MSG(script->reload() != OK, "The benchmark script failed to compile.");
+
+	Ref<RefCounted> object = memnew(RefCounted);
+	object->set_script(script);
+	const Variant count = 100000;
+
+	while (p_state.next()) {
+		p_state.keep(int64_t(object->call(p_function, count)));
+	}
+}
+
+BENCHMARK("[GDScript] Integer loop") {
+	bench_script_function(p_state, "int_loop");
+}
+
+BENCHMARK("[GDScript] Float loop") {
+	bench_script_function(p_state, "float_loop");
+}
+
+BENCHMARK("[GDScript] Vector2 loop") {
+	bench_script_function(p_state, "vector_loop");
+}
+
+BENCHMARK("[GDScript] Function calls") {
+	bench_script_function(p_state, "call_loop");
+}
+
+BENCHMARK("[GDScript] Array loop") {
+	bench_script_function(p_state, "array_loop");
+}
+
+BENCHMARK("[GDScript] Dictionary loop") {
+	bench_script_function(p_state, "dictionary_loop");
+}
+
+} // namespace BenchGDScript
+
+#endif // MODULE_GDSCRIPT_ENABLED
+
+#endif // BENCH_GDSCRIPT_H
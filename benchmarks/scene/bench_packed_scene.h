@@ -0,0 +1,94 @@
+/**************************************************************************/
+/*  bench_packed_scene.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCH_PACKED_SCENE_H
+#define BENCH_PACKED_SCENE_H
+
+#include "scene/main/node.h"
+#include "scene/resources/packed_scene.h"
+
+#include "benchmarks/benchmark.h"
+
+namespace BenchPackedScene {
+
+static Ref<PackedScene> create_test_scene() {
+	Node *root = memnew(Node);
+	root->set_name("Root");
+	for (int i = 0; i < 20; i++) {
+		Node *branch = memnew(Node);
+		branch->set_name("Branch" + itos(i));
+		branch->set_process_priority(i);
+		root->add_child(branch);
+		branch->set_owner(root);
+		for (int j = 0; j < 10; j++) {
+			Node *leaf = memnew(Node);
+			leaf->set_name("Leaf" + itos(j));
+			leaf->set_editor_description("Leaf node " + itos(j));
+			leaf->set_meta("index", j);
+			branch->add_child(leaf);
+			leaf->set_owner(root);
+		}
+	}
+
+	Ref<PackedScene> scene;
+	scene.instantiate();
+	scene->pack(root);
+	memdelete(root);
+	return scene;
+}
+
+BENCHMARK("[PackedScene] Instantiate 221 nodes") {
+	Ref<PackedScene> scene = create_test_scene();
+
+	while (p_state.next()) {
+		for (int i = 0; i < 10; i++) {
+			Node *instance = scene->instantiate();
+			p_state.keep(instance->get_child_count());
+			memdelete(instance);
+		}
+	}
+}
+
+BENCHMARK("[PackedScene] Pack 221 nodes") {
+	Ref<PackedScene> scene = create_test_scene();
+	Node *root = scene->instantiate();
+
+	while (p_state.next()) {
+		Ref<PackedScene> packed;
+		packed.instantiate();
+		p_state.keep(packed->pack(root));
+	}
+
+	memdelete(root);
+}
+
+} // namespace BenchPackedScene
+
+#endif // BENCH_PACKED_SCENE_H
@@ -0,0 +1,121 @@
+/**************************************************************************/
+/*  bench_navigation_server_3d.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCH_NAVIGATION_SERVER_3D_H
+#define BENCH_NAVIGATION_SERVER_3D_H
+
+#include "core/math/random_pcg.h"
+#include "servers/navigation_server_3d.h"
+
+#include "benchmarks/benchmark.h"
+
+namespace BenchNavigationServer3D {
+
+constexpr int GRID_SIZE = 64;
+
+// A grid of square polygons, with walls that leave a gap every few cells.
+static Ref<NavigationMesh> create_grid_navigation_mesh() {
+	Vector<Vector3> vertices;
+	for (int z = 0; z <= GRID_SIZE; z++) {
+		for (int x = 0; x <= GRID_SIZE; x++) {
+			vertices.push_back(Vector3(x, 0, z));
+		}
+	}
+
+	Ref<NavigationMesh> navigation_mesh;
+	navigation_mesh.instantiate();
+	navigation_mesh->set_vertices(vertices);
+	for (int z = 0; z < GRID_SIZE; z++) {
+		for (int x = 0; x < GRID_SIZE; x++) {
+			if (x % 8 == 4 && z % 16 != 0) {
+				continue;
+			}
+			Vector<int> polygon;
+			polygon.push_back(z * (GRID_SIZE + 1) + x);
+			polygon.push_back((z + 1) * (GRID_SIZE + 1) + x);
+			polygon.push_back((z + 1) * (GRID_SIZE + 1) + x + 1);
+			polygon.push_back(z * (GRID_SIZE + 1) + x + 1);
+			navigation_mesh->add_polygon(polygon);
+		}
+	}
+	return navigation_mesh;
+}
+
+BENCHMARK("[NavigationServer3D] Query 100 paths") {
+	NavigationServer3D *navigation_server = NavigationServer3DManager::new_default_server();
+
+	RID map = navigation_server->map_create();
+	navigation_server->map_set_active(map, true);
+	RID region = navigation_server->region_create();
+	navigation_server->region_set_navigation_mesh(region, create_grid_navigation_mesh());
+	navigation_server->region_set_map(region, map);
+	navigation_server->process(0.0);
+
+	while (p_state.next()) {
+		RandomPCG rng(1);
+		uint64_t points = 0;
+		for (int i = 0; i < 100; i++) {
+			const Vector3 from(rng.randf() * GRID_SIZE, 0, rng.randf() * GRID_SIZE);
+			const Vector3 to(rng.randf() * GRID_SIZE, 0, rng.randf() * GRID_SIZE);
+			points += navigation_server->map_get_path(map, from, to, true).size();
+		}
+		p_state.keep(points);
+	}
+
+	navigation_server->free(region);
+	navigation_server->free(map);
+	navigation_server->process(0.0);
+	memdelete(navigation_server);
+}
+
+BENCHMARK("[NavigationServer3D] Sync map with a grid region") {
+	NavigationServer3D *navigation_server = NavigationServer3DManager::new_default_server();
+	Ref<NavigationMesh> navigation_mesh = create_grid_navigation_mesh();
+
+	RID map = navigation_server->map_create();
+	navigation_server->map_set_active(map, true);
+	RID region = navigation_server->region_create();
+	navigation_server->region_set_map(region, map);
+
+	while (p_state.next()) {
+		// Changing the mesh makes the map rebuild its connections on the next sync.
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0);
+	}
+
+	navigation_server->free(region);
+	navigation_server->free(map);
+	navigation_server->process(0.0);
+	memdelete(navigation_server);
+}
+
+} // namespace BenchNavigationServer3D
+
+#endif // BENCH_NAVIGATION_SERVER_3D_H
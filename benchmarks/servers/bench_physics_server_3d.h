@@ -0,0 +1,110 @@
+/**************************************************************************/
+/*  bench_physics_server_3d.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCH_PHYSICS_SERVER_3D_H
+#define BENCH_PHYSICS_SERVER_3D_H
+
+#include "servers/physics_server_3d.h"
+
+#include "benchmarks/benchmark.h"
+
+namespace BenchPhysicsServer3D {
+
+static void bench_falling_spheres(BenchmarkState &p_state, int p_body_count) {
+	PhysicsServer3D *physics_server = PhysicsServer3DManager::get_singleton()->new_default_server();
+	physics_server->init();
+	physics_server->set_active(true);
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+
+	RID ground_shape = physics_server->world_boundary_shape_create();
+	physics_server->shape_set_data(ground_shape, Plane(Vector3(0, 1, 0), 0));
+	RID ground = physics_server->body_create();
+	physics_server->body_set_mode(ground, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(ground, ground_shape);
+	physics_server->body_set_space(ground, space);
+
+	RID sphere_shape = physics_server->sphere_shape_create();
+	physics_server->shape_set_data(sphere_shape, 0.5);
+	LocalVector<RID> bodies;
+	LocalVector<Transform3D> start_transforms;
+	const int side = Math::ceil(Math::sqrt(double(p_body_count) / 4.0));
+	for (int i = 0; i < p_body_count; i++) {
+		RID body = physics_server->body_create();
+		physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+		physics_server->body_add_shape(body, sphere_shape);
+		physics_server->body_set_space(body, space);
+		// Stacked in layers of slightly offset spheres, so they collide while falling and settling.
+		const int layer = i / (side * side);
+		const int index = i % (side * side);
+		bodies.push_back(body);
+		start_transforms.push_back(Transform3D(Basis(), Vector3((index % side) * 1.1 + layer * 0.1, 1.0 + layer * 1.1, (index / side) * 1.1)));
+	}
+
+	while (p_state.next()) {
+		// Start from the same state for every sample.
+		for (uint32_t i = 0; i < bodies.size(); i++) {
+			physics_server->body_set_state(bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM, start_transforms[i]);
+			physics_server->body_set_state(bodies[i], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3());
+			physics_server->body_set_state(bodies[i], PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY, Vector3());
+			physics_server->body_set_state(bodies[i], PhysicsServer3D::BODY_STATE_SLEEPING, false);
+		}
+
+		for (int frame = 0; frame < 60; frame++) {
+			physics_server->sync();
+			physics_server->flush_queries();
+			physics_server->end_sync();
+			physics_server->step(1.0 / 60.0);
+		}
+	}
+
+	for (const RID &body : bodies) {
+		physics_server->free(body);
+	}
+	physics_server->free(sphere_shape);
+	physics_server->free(ground);
+	physics_server->free(ground_shape);
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+
+BENCHMARK("[PhysicsServer3D] Step 60 frames with 100 bodies") {
+	bench_falling_spheres(p_state, 100);
+}
+
+BENCHMARK("[PhysicsServer3D] Step 60 frames with 1000 bodies") {
+	bench_falling_spheres(p_state, 1000);
+}
+
+} // namespace BenchPhysicsServer3D
+
+#endif // BENCH_PHYSICS_SERVER_3D_H
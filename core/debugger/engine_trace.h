@@ -0,0 +1,103 @@
+/**************************************************************************/
+/*  engine_trace.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef ENGINE_TRACE_H
+#define ENGINE_TRACE_H
+
+#ifdef TRACE_MARKERS_ENABLED
+
+#include "core/debugger/trace_recorder.h"
+#include "core/os/os.h"
+
+// Timeline of the scopes marked with TRACE_SCOPE() on every thread, captured when
+// running with `--trace-capture <file>`.
+class EngineTrace {
+	static TraceRecorder recorder;
+
+public:
+	enum {
+		DEFAULT_EVENTS_PER_THREAD = 65536,
+	};
+
+	class Scope {
+		uint32_t name = 0;
+		uint64_t begin = 0;
+
+	public:
+		// `r_cache` keeps the index of `p_name`, so the name is only registered once per capture.
+		_FORCE_INLINE_ Scope(const char *p_name, TraceRecorder::NameCache &r_cache) {
+			if (unlikely(recorder.is_recording())) {
+				name = recorder.get_name_index(r_cache, [p_name]() { return String(p_name); });
+				begin = OS::get_singleton()->get_ticks_usec();
+			}
+		}
+		// For names changing at runtime, `p_unnamed` is used when `p_name` is empty.
+		_FORCE_INLINE_ Scope(const String &p_name, const char *p_unnamed, TraceRecorder::NameCache &r_unnamed_cache) {
+			if (unlikely(recorder.is_recording())) {
+				if (p_name.is_empty()) {
+					name = recorder.get_name_index(r_unnamed_cache, [p_unnamed]() { return String(p_unnamed); });
+				} else {
+					name = recorder.get_name_index(p_name);
+				}
+				begin = OS::get_singleton()->get_ticks_usec();
+			}
+		}
+		_FORCE_INLINE_ ~Scope() {
+			if (unlikely(begin)) {
+				recorder.record(name, begin, OS::get_singleton()->get_ticks_usec());
+			}
+		}
+	};
+
+	static _FORCE_INLINE_ bool is_capturing() { return recorder.is_recording(); }
+
+	static void start(uint32_t p_events_per_thread = DEFAULT_EVENTS_PER_THREAD);
+	static void stop();
+	static void clear();
+	static Error save(const String &p_path);
+};
+
+#define _TRACE_SCOPE_VAR(m_prefix, m_line) m_prefix##m_line
+#define _TRACE_SCOPE_NAME(m_prefix, m_line) _TRACE_SCOPE_VAR(m_prefix, m_line)
+#define TRACE_SCOPE(m_name)                                                                                                \
+	static TraceRecorder::NameCache _TRACE_SCOPE_NAME(_trace_scope_name_, __LINE__);                                       \
+	EngineTrace::Scope _TRACE_SCOPE_NAME(_trace_scope_, __LINE__)(m_name, _TRACE_SCOPE_NAME(_trace_scope_name_, __LINE__))
+#define TRACE_SCOPE_DYNAMIC(m_name, m_unnamed)                                                                                        \
+	static TraceRecorder::NameCache _TRACE_SCOPE_NAME(_trace_scope_name_, __LINE__);                                                  \
+	EngineTrace::Scope _TRACE_SCOPE_NAME(_trace_scope_, __LINE__)(m_name, m_unnamed, _TRACE_SCOPE_NAME(_trace_scope_name_, __LINE__))
+
+#else
+
+#define TRACE_SCOPE(m_name)
+#define TRACE_SCOPE_DYNAMIC(m_name, m_unnamed)
+
+#endif // TRACE_MARKERS_ENABLED
+
+#endif // ENGINE_TRACE_H
@@ -0,0 +1,272 @@
+/**************************************************************************/
+/*  trace_recorder.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "trace_recorder.h"
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+
+std::atomic<uint32_t> TraceRecorder::recorder_count = 0;
+thread_local TraceRecorder::ThreadBuffers TraceRecorder::thread_buffers;
+
+TraceRecorder::ThreadBuffers::~ThreadBuffers() {
+	// The events of exited threads are kept until the next recording starts.
+	for (ThreadBuffer *buffer : buffers) {
+		if (buffer) {
+			MutexLock lock(buffer->recorder->mutex);
+			buffer->thread_exited = true;
+		}
+	}
+}
+
+TraceRecorder::ThreadBuffer *TraceRecorder::_create_thread_buffer() {
+	MutexLock lock(mutex);
+
+	ThreadBuffer *buffer = memnew(ThreadBuffer);
+	buffer->recorder = this;
+	buffer->thread_id = Thread::get_caller_id();
+	buffers.push_back(buffer);
+
+	thread_buffers.buffers[id] = buffer;
+	return buffer;
+}
+
+void TraceRecorder::_reset_thread_buffer(ThreadBuffer *p_buffer, uint32_t p_generation) {
+	// Only called by the thread owning the buffer, while it's writing to it.
+	if (p_buffer->mask + 1 != buffer_size) {
+		if (p_buffer->events) {
+			memdelete_arr(p_buffer->events);
+		}
+		p_buffer->events = memnew_arr(Event, buffer_size);
+		p_buffer->mask = buffer_size - 1;
+	}
+	p_buffer->written = 0;
+	p_buffer->generation = p_generation;
+}
+
+void TraceRecorder::_release_exited_thread_buffers() {
+	// Must be called with the mutex locked, while not recording.
+	for (uint32_t i = 0; i < buffers.size(); i++) {
+		ThreadBuffer *buffer = buffers[i];
+		if (!buffer->thread_exited) {
+			continue;
+		}
+		if (buffer->events) {
+			memdelete_arr(buffer->events);
+		}
+		memdelete(buffer);
+		buffers.remove_at_unordered(i);
+		i--;
+	}
+}
+
+uint32_t TraceRecorder::_register_name(const String &p_name, uint32_t &r_generation) {
+	MutexLock lock(mutex);
+
+	r_generation = generation.load();
+	if (const uint32_t *index = name_indices.getptr(p_name)) {
+		return *index;
+	}
+	const uint32_t index = names.size();
+	names.push_back(p_name);
+	name_indices.insert(p_name, index);
+	return index;
+}
+
+uint32_t TraceRecorder::get_name_index(const String &p_name) {
+	ThreadBuffer *buffer = thread_buffers.buffers[id];
+	if (unlikely(!buffer)) {
+		buffer = _create_thread_buffer();
+	}
+
+	const uint32_t current_generation = generation.load(std::memory_order_acquire);
+	if (buffer->name_indices_generation != current_generation) {
+		buffer->name_indices.clear();
+		buffer->name_indices_generation = current_generation;
+	}
+	if (const uint32_t *index = buffer->name_indices.getptr(p_name)) {
+		return *index;
+	}
+
+	uint32_t name_generation = 0;
+	const uint32_t index = _register_name(p_name, name_generation);
+	if (name_generation == current_generation) {
+		buffer->name_indices.insert(p_name, index);
+	}
+	return index;
+}
+
+String TraceRecorder::get_name(uint32_t p_index) const {
+	MutexLock lock(mutex);
+	ERR_FAIL_UNSIGNED_INDEX_V(p_index, names.size(), String());
+	return names[p_index];
+}
+
+void TraceRecorder::record(uint32_t p_name, uint64_t p_begin, uint64_t p_end) {
+	ThreadBuffer *buffer = thread_buffers.buffers[id];
+	if (unlikely(!buffer)) {
+		if (!recording.load()) {
+			return;
+		}
+		buffer = _create_thread_buffer();
+	}
+
+	// Announcing the write before checking whether recording ends the race with stop(),
+	// which stops recording before waiting for the writes: either this thread sees that
+	// recording stopped, or stop() sees this write and waits for it.
+	buffer->writing.store(true);
+	if (likely(recording.load())) {
+		const uint32_t current_generation = generation.load(std::memory_order_relaxed);
+		if (unlikely(buffer->generation != current_generation)) {
+			_reset_thread_buffer(buffer, current_generation);
+		}
+		if (likely(p_begin >= start_time)) {
+			Event &event = buffer->events[buffer->written & buffer->mask];
+			event.begin = p_begin;
+			event.end = p_end;
+			event.name = p_name;
+			buffer->written++;
+		}
+	}
+	buffer->writing.store(false, std::memory_order_release);
+}
+
+void TraceRecorder::start(uint32_t p_events_per_thread) {
+	MutexLock lock(mutex);
+
+	ERR_FAIL_COND_MSG(recording.load(), "A trace is already being recorded.");
+	_release_exited_thread_buffers();
+	names.clear();
+	name_indices.clear();
+
+	// Starting a new generation makes every thread reset its buffer and register the names again.
+	generation.fetch_add(1);
+	buffer_size = next_power_of_2(MAX(p_events_per_thread, 1024u));
+	start_time = OS::get_singleton()->get_ticks_usec();
+	recording.store(true);
+}
+
+void TraceRecorder::stop() {
+	recording.store(false);
+
+	MutexLock lock(mutex);
+	for (const ThreadBuffer *buffer : buffers) {
+		while (buffer->writing.load()) {
+			// Writing an event only takes a few instructions.
+		}
+	}
+}
+
+void TraceRecorder::clear() {
+	MutexLock lock(mutex);
+
+	ERR_FAIL_COND_MSG(recording.load(), "Can't clear the trace while recording it.");
+	_release_exited_thread_buffers();
+	names.clear();
+	name_indices.clear();
+	// The buffers of the running threads are left to them, they no longer belong to the current generation.
+	generation.fetch_add(1);
+}
+
+void TraceRecorder::get_events(LocalVector<ThreadEvents> &r_threads) const {
+	MutexLock lock(mutex);
+
+	ERR_FAIL_COND_MSG(recording.load(), "Stop recording before reading the trace.");
+	const uint32_t current_generation = generation.load();
+	for (const ThreadBuffer *buffer : buffers) {
+		if (buffer->generation != current_generation || buffer->written == 0) {
+			continue;
+		}
+
+		ThreadEvents thread_events;
+		thread_events.thread_id = buffer->thread_id;
+		const uint64_t from = buffer->written > buffer->mask ? buffer->written - buffer->mask - 1 : 0;
+		thread_events.events.reserve(buffer->written - from);
+		for (uint64_t i = from; i < buffer->written; i++) {
+			const Event &event = buffer->events[i & buffer->mask];
+			// Names registered right before the recording restarted belong to the previous one.
+			if (event.name < names.size()) {
+				thread_events.events.push_back(event);
+			}
+		}
+		r_threads.push_back(thread_events);
+	}
+}
+
+Error TraceRecorder::save_chrome_trace(const String &p_path) const {
+	ERR_FAIL_COND_V_MSG(recording.load(), ERR_BUSY, "Stop recording before saving the trace.");
+
+	LocalVector<ThreadEvents> threads;
+	get_events(threads);
+
+	LocalVector<String> escaped_names;
+	{
+		MutexLock lock(mutex);
+		escaped_names.resize(names.size());
+		for (uint32_t i = 0; i < names.size(); i++) {
+			escaped_names[i] = names[i].json_escape();
+		}
+	}
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, "Cannot open file '" + p_path + "' to save the trace.");
+
+	// Chrome trace event format, which Perfetto and chrome://tracing can open.
+	f->store_line("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+	bool first = true;
+	for (const ThreadEvents &thread_events : threads) {
+		const String thread = "\"pid\":1,\"tid\":" + itos(thread_events.thread_id);
+		const String thread_name = thread_events.thread_id == Thread::get_main_id() ? "Main thread" : "Thread " + itos(thread_events.thread_id);
+		f->store_string(String(first ? "" : ",\n") + "{\"name\":\"thread_name\",\"ph\":\"M\"," + thread + ",\"args\":{\"name\":\"" + thread_name + "\"}}");
+		first = false;
+
+		for (const Event &event : thread_events.events) {
+			f->store_string(",\n{\"name\":\"" + escaped_names[event.name] + "\",\"ph\":\"X\",\"ts\":" + itos(event.begin - start_time) + ",\"dur\":" + itos(event.end - event.begin) + "," + thread + "}");
+		}
+	}
+	f->store_line("\n]}");
+
+	return OK;
+}
+
+TraceRecorder::TraceRecorder() {
+	id = recorder_count.fetch_add(1);
+	CRASH_COND_MSG(id >= MAX_RECORDERS, "Too many trace recorders.");
+}
+
+TraceRecorder::~TraceRecorder() {
+	for (ThreadBuffer *buffer : buffers) {
+		if (buffer->events) {
+			memdelete_arr(buffer->events);
+		}
+		memdelete(buffer);
+	}
+}
@@ -0,0 +1,147 @@
+/**************************************************************************/
+/*  trace_recorder.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+#include <atomic>
+
+// Records timed events into per-thread ring buffers, so a timeline can be saved to a file
+// without a debugger connection. When a buffer is full, its oldest events are overwritten.
+//
+// Threads only write to their own buffer and don't lock to record an event. A buffer is never
+// released while its thread may write to it: stop() waits for the events being written, buffers
+// are reset by their own thread when a new recording starts, and they are only released once
+// their thread exited.
+//
+// Recorders are meant to live until the engine exits, as static members, and only a few of them can be created.
+class TraceRecorder {
+public:
+	struct Event {
+		uint64_t begin = 0;
+		uint64_t end = 0;
+		uint32_t name = 0;
+	};
+
+	struct ThreadEvents {
+		Thread::ID thread_id = 0;
+		LocalVector<Event> events; // In the order they were recorded, which is the order the scopes ended in.
+	};
+
+	// Keeps the index of a name for the current recording, see get_name_index().
+	typedef SafeNumeric<uint64_t> NameCache;
+
+private:
+	enum {
+		MAX_RECORDERS = 4,
+	};
+
+	struct ThreadBuffer {
+		TraceRecorder *recorder = nullptr;
+		Thread::ID thread_id = 0;
+		Event *events = nullptr;
+		uint64_t mask = 0;
+		uint64_t written = 0;
+		uint32_t generation = 0;
+		std::atomic<bool> writing = false;
+		bool thread_exited = false;
+
+		// Indices of the names changing at runtime used by the thread, only accessed by it.
+		HashMap<String, uint32_t> name_indices;
+		uint32_t name_indices_generation = 0;
+	};
+
+	struct ThreadBuffers {
+		ThreadBuffer *buffers[MAX_RECORDERS] = {};
+		~ThreadBuffers();
+	};
+
+	static std::atomic<uint32_t> recorder_count;
+	static thread_local ThreadBuffers thread_buffers;
+
+	uint32_t id = 0;
+	std::atomic<bool> recording = false;
+	std::atomic<uint32_t> generation = 1;
+	uint32_t buffer_size = 0;
+	uint64_t start_time = 0;
+
+	mutable Mutex mutex;
+	LocalVector<ThreadBuffer *> buffers;
+	LocalVector<String> names;
+	HashMap<String, uint32_t> name_indices;
+
+	ThreadBuffer *_create_thread_buffer();
+	void _reset_thread_buffer(ThreadBuffer *p_buffer, uint32_t p_generation);
+	void _release_exited_thread_buffers();
+	uint32_t _register_name(const String &p_name, uint32_t &r_generation);
+
+public:
+	_FORCE_INLINE_ bool is_recording() const { return recording.load(std::memory_order_relaxed); }
+
+	// Returns the index of a name whose index is kept in `r_cache`, such as a marker's static name.
+	// Registering a name locks, so `p_name` is only called to get the name when it isn't cached yet.
+	template <class F>
+	_FORCE_INLINE_ uint32_t get_name_index(NameCache &r_cache, const F &p_name) {
+		const uint64_t key = r_cache.get();
+		if (likely((key >> 32) == generation.load(std::memory_order_acquire))) {
+			return uint32_t(key);
+		}
+		uint32_t name_generation = 0;
+		const uint32_t index = _register_name(p_name(), name_generation);
+		r_cache.set((uint64_t(name_generation) << 32) | index);
+		return index;
+	}
+	// Returns the index of a name that changes at runtime, cached for each thread.
+	uint32_t get_name_index(const String &p_name);
+	String get_name(uint32_t p_index) const;
+
+	// Scopes which began before the recording started are ignored.
+	void record(uint32_t p_name, uint64_t p_begin, uint64_t p_end);
+
+	void start(uint32_t p_events_per_thread);
+	void stop();
+	void clear();
+
+	// Can only be called while not recording.
+	void get_events(LocalVector<ThreadEvents> &r_threads) const;
+	Error save_chrome_trace(const String &p_path) const;
+
+	TraceRecorder();
+	~TraceRecorder();
+};
+
+#endif // TRACE_RECORDER_H
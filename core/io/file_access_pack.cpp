@@ -30,7 +30,9 @@
 
 #include "file_access_pack.h"
 
+#include "core/crypto/crypto_core.h"
 #include "core/io/file_access_encrypted.h"
+#include "core/io/marshalls.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
 #include "core/version.h"
@@ -38,6 +40,7 @@
 #include <stdio.h>
 
 Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
+	pack_sequence++;
 	for (int i = 0; i < sources.size(); i++) {
 		if (sources[i]->try_open_pack(p_path, p_replace_files, p_offset)) {
 			return OK;
@@ -47,13 +50,14 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted) {
-	PathMD5 pmd5(p_path.md5_buffer());
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_compressed) {
+	Vector<uint8_t> path_md5 = p_path.md5_buffer();
 
-	bool exists = files.has(pmd5);
+	bool exists = _find_path(path_md5, nullptr);
 
 	PackedFile pf;
 	pf.encrypted = p_encrypted;
+	pf.compressed = p_compressed;
 	pf.pack = p_pkg_path;
 	pf.offset = p_ofs;
 	pf.size = p_size;
@@ -61,38 +65,281 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 		pf.md5[i] = p_md5[i];
 	}
 	pf.src = p_src;
+	pf.sequence = pack_sequence;
+	pf.replace = p_replace_files;
 
 	if (!exists || p_replace_files) {
-		files[pmd5] = pf;
+		files[PathMD5(path_md5)] = pf;
 	}
 
 	if (!exists) {
-		//search for dir
-		String p = p_path.replace_first("res://", "");
-		PackedDir *cd = root;
-
-		if (p.contains("/")) { //in a subdir
-
-			Vector<String> ds = p.get_base_dir().split("/");
-
-			for (int j = 0; j < ds.size(); j++) {
-				if (!cd->subdirs.has(ds[j])) {
-					PackedDir *pd = memnew(PackedDir);
-					pd->name = ds[j];
-					pd->parent = cd;
-					cd->subdirs[pd->name] = pd;
-					cd = pd;
-				} else {
-					cd = cd->subdirs[ds[j]];
-				}
+		_add_path_to_dirs(p_path);
+	}
+}
+
+void PackedData::_add_path_to_dirs(const String &p_path) {
+	//search for dir
+	String p = p_path.replace_first("res://", "");
+	PackedDir *cd = root;
+
+	if (p.contains("/")) { //in a subdir
+
+		Vector<String> ds = p.get_base_dir().split("/");
+
+		for (int j = 0; j < ds.size(); j++) {
+			if (!cd->subdirs.has(ds[j])) {
+				PackedDir *pd = memnew(PackedDir);
+				pd->name = ds[j];
+				pd->parent = cd;
+				cd->subdirs[pd->name] = pd;
+				cd = pd;
+			} else {
+				cd = cd->subdirs[ds[j]];
 			}
 		}
-		String filename = p_path.get_file();
-		// Don't add as a file if the path points to a directory
-		if (!filename.is_empty()) {
-			cd->files.insert(filename);
+	}
+	String filename = p_path.get_file();
+	// Don't add as a file if the path points to a directory
+	if (!filename.is_empty()) {
+		cd->files.insert(filename);
+	}
+}
+
+// Each entry of the path index is the MD5 of a path followed by the offset of its entry in the directory.
+// They are sorted by MD5, and the number of entries is stored after them.
+#define PACK_PATH_INDEX_ENTRY_SIZE 20
+
+const uint8_t *PackedData::PackIndex::find_entry(const uint8_t *p_path_md5) const {
+	const uint8_t *dir = directory.ptr();
+	const uint8_t *table = dir + index_offset;
+	uint32_t low = 0;
+	uint32_t high = index_count;
+	while (low < high) {
+		const uint32_t middle = (low + high) / 2;
+		const uint8_t *index_entry = table + middle * PACK_PATH_INDEX_ENTRY_SIZE;
+		const int cmp = memcmp(index_entry, p_path_md5, 16);
+		if (cmp < 0) {
+			low = middle + 1;
+		} else if (cmp > 0) {
+			high = middle;
+		} else {
+			return dir + decode_uint32(index_entry + 16);
+		}
+	}
+	return nullptr;
+}
+
+bool PackedData::add_pack_index(const String &p_pkg_path, uint64_t p_base, const Vector<uint8_t> &p_directory, PackSource *p_src, bool p_replace_files) {
+	ERR_FAIL_COND_V_MSG(p_directory.size() < 4, false, "Invalid path index in pack: '" + p_pkg_path + "'.");
+
+	const uint8_t *dir = p_directory.ptr();
+	const uint32_t index_count = decode_uint32(dir + p_directory.size() - 4);
+	ERR_FAIL_COND_V_MSG(uint64_t(index_count) * PACK_PATH_INDEX_ENTRY_SIZE + 4 > uint64_t(p_directory.size()), false, "Invalid path index in pack: '" + p_pkg_path + "'.");
+	const uint32_t index_offset = p_directory.size() - 4 - index_count * PACK_PATH_INDEX_ENTRY_SIZE;
+
+	for (uint32_t i = 0; i < index_count; i++) {
+		const uint64_t entry_offset = decode_uint32(dir + index_offset + i * PACK_PATH_INDEX_ENTRY_SIZE + 16);
+		ERR_FAIL_COND_V_MSG(entry_offset + 4 > index_offset || entry_offset + 4 + decode_uint32(dir + entry_offset) + 36 > index_offset, false, "Invalid path index in pack: '" + p_pkg_path + "'.");
+	}
+
+	PackIndex *index = memnew(PackIndex);
+	index->pack = p_pkg_path;
+	index->src = p_src;
+	index->base = p_base;
+	index->sequence = pack_sequence;
+	index->replace_files = p_replace_files;
+	index->directory = p_directory;
+	index->index_count = index_count;
+	index->index_offset = index_offset;
+	pack_indices.push_back(index);
+	return true;
+}
+
+void PackedData::_add_pack_index_dirs() {
+	MutexLock lock(pack_dirs_mutex);
+	for (PackIndex *index : pack_indices) {
+		if (index->dirs_added) {
+			continue;
+		}
+		// Only needed to list directories, so it's done the first time one is opened rather than when adding the pack.
+		index->dirs_added = true;
+		const uint8_t *dir = index->directory.ptr();
+		for (uint32_t i = 0; i < index->index_count; i++) {
+			const uint8_t *entry = dir + decode_uint32(dir + index->index_offset + i * PACK_PATH_INDEX_ENTRY_SIZE + 16);
+			String path;
+			path.parse_utf8((const char *)entry + 4, decode_uint32(entry));
+			_add_path_to_dirs(path);
+		}
+	}
+}
+
+bool PackedData::_find_path(const Vector<uint8_t> &p_path_md5, PackedFile *r_file) {
+	// The pack added first provides the file, unless a later one was added to replace files.
+	bool found = false;
+	bool replaced = false;
+	PackedFile first;
+	PackedFile last_replace;
+	auto consider = [&](const PackedFile &p_file) {
+		if (!found) {
+			first = p_file;
+			found = true;
+			return;
+		}
+		PackedFile later = p_file;
+		if (p_file.sequence < first.sequence) {
+			later = first;
+			first = p_file;
+		}
+		if (later.replace && (!replaced || later.sequence > last_replace.sequence)) {
+			last_replace = later;
+			replaced = true;
+		}
+	};
+
+	HashMap<PathMD5, PackedFile, PathMD5>::ConstIterator E = files.find(PathMD5(p_path_md5));
+	if (E) {
+		if (!r_file) {
+			return true;
+		}
+		consider(E->value);
+	}
+
+	for (const PackIndex *index : pack_indices) {
+		const uint8_t *entry = index->find_entry(p_path_md5.ptr());
+		if (!entry) {
+			continue;
+		}
+		if (!r_file) {
+			return true;
+		}
+
+		const uint8_t *fields = entry + 4 + decode_uint32(entry);
+		PackedFile pf;
+		pf.pack = index->pack;
+		pf.offset = index->base + decode_uint64(fields);
+		pf.size = decode_uint64(fields + 8);
+		memcpy(pf.md5, fields + 16, 16);
+		const uint32_t flags = decode_uint32(fields + 32);
+		pf.encrypted = flags & PACK_FILE_ENCRYPTED;
+		pf.compressed = flags & PACK_FILE_COMPRESSED;
+		pf.src = index->src;
+		pf.sequence = index->sequence;
+		pf.replace = index->replace_files;
+		consider(pf);
+	}
+
+	if (found && r_file) {
+		*r_file = replaced ? last_replace : first;
+	}
+	return found;
+}
+
+Vector<uint8_t> PackedData::make_path_index(const Vector<String> &p_paths, const Vector<uint32_t> &p_entry_offsets) {
+	ERR_FAIL_COND_V(p_paths.size() != p_entry_offsets.size(), Vector<uint8_t>());
+
+	struct IndexEntry {
+		uint8_t md5[16];
+		uint32_t entry_offset = 0;
+		uint32_t order = 0;
+
+		bool operator<(const IndexEntry &p_other) const {
+			int cmp = memcmp(md5, p_other.md5, 16);
+			return cmp != 0 ? cmp < 0 : order < p_other.order;
+		}
+	};
+
+	LocalVector<IndexEntry> entries;
+	entries.resize(p_paths.size());
+	for (int i = 0; i < p_paths.size(); i++) {
+		CharString path_utf8 = p_paths[i].utf8();
+		CryptoCore::md5((const uint8_t *)path_utf8.get_data(), path_utf8.length(), entries[i].md5);
+		entries[i].entry_offset = p_entry_offsets[i];
+		entries[i].order = i;
+	}
+	entries.sort();
+
+	Vector<uint8_t> ret;
+	ret.resize(entries.size() * PACK_PATH_INDEX_ENTRY_SIZE + 4);
+	uint8_t *w = ret.ptrw();
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < entries.size(); i++) {
+		if (i + 1 < entries.size() && memcmp(entries[i].md5, entries[i + 1].md5, 16) == 0) {
+			continue; // Added again later, which replaces it.
+		}
+		memcpy(w + count * PACK_PATH_INDEX_ENTRY_SIZE, entries[i].md5, 16);
+		encode_uint32(entries[i].entry_offset, w + count * PACK_PATH_INDEX_ENTRY_SIZE + 16);
+		count++;
+	}
+	ret.resize(count * PACK_PATH_INDEX_ENTRY_SIZE + 4);
+	encode_uint32(count, ret.ptrw() + count * PACK_PATH_INDEX_ENTRY_SIZE);
+	return ret;
+}
+
+struct PackedDataCompressUserdata {
+	const Vector<uint8_t> *data = nullptr;
+	uint32_t block_size = 0;
+	Vector<Vector<uint8_t>> blocks;
+};
+
+static void _compress_pack_block(void *p_userdata, uint32_t p_index) {
+	PackedDataCompressUserdata *ud = (PackedDataCompressUserdata *)p_userdata;
+	const uint64_t from = uint64_t(p_index) * ud->block_size;
+	const int size = MIN(uint64_t(ud->block_size), ud->data->size() - from);
+	const uint8_t *src = ud->data->ptr() + from;
+
+	Vector<uint8_t> &block = ud->blocks.write[p_index];
+	block.resize(Compression::get_max_compressed_buffer_size(size, Compression::MODE_ZSTD));
+	int compressed_size = Compression::compress(block.ptrw(), src, size, Compression::MODE_ZSTD);
+	if (compressed_size <= 0 || compressed_size >= size) {
+		// Not worth it, a block as large as its uncompressed size is stored as is.
+		block.resize(size);
+		memcpy(block.ptrw(), src, size);
+	} else {
+		block.resize(compressed_size);
+	}
+}
+
+// Compressed files start with the block size and count, followed by the offset of each block (and the end of the last one)
+// relative to the start of the file. Blocks are compressed independently, so any of them can be read without the others.
+Vector<uint8_t> PackedData::compress_file(const Vector<uint8_t> &p_data, uint32_t p_block_size) {
+	ERR_FAIL_COND_V(p_block_size == 0, Vector<uint8_t>());
+
+	const uint32_t block_count = (uint64_t(p_data.size()) + p_block_size - 1) / p_block_size;
+
+	PackedDataCompressUserdata ud;
+	ud.data = &p_data;
+	ud.block_size = p_block_size;
+	ud.blocks.resize(block_count);
+
+	if (block_count > 1 && WorkerThreadPool::get_singleton() && WorkerThreadPool::get_singleton()->get_thread_count() > 0) {
+		WorkerThreadPool::GroupID group_id = WorkerThreadPool::get_singleton()->add_native_group_task(&_compress_pack_block, &ud, block_count, -1, true, SNAME("CompressPackFile"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+	} else {
+		for (uint32_t i = 0; i < block_count; i++) {
+			_compress_pack_block(&ud, i);
 		}
 	}
+
+	const uint64_t header_size = 8 + 8 * (uint64_t(block_count) + 1);
+	uint64_t total_size = header_size;
+	for (uint32_t i = 0; i < block_count; i++) {
+		total_size += ud.blocks[i].size();
+	}
+
+	Vector<uint8_t> ret;
+	ret.resize(total_size);
+	uint8_t *w = ret.ptrw();
+	encode_uint32(p_block_size, w);
+	encode_uint32(block_count, w + 4);
+	uint64_t ofs = header_size;
+	for (uint32_t i = 0; i < block_count; i++) {
+		encode_uint64(ofs, w + 8 + 8 * i);
+		memcpy(w + ofs, ud.blocks[i].ptr(), ud.blocks[i].size());
+		ofs += ud.blocks[i].size();
+	}
+	encode_uint64(ofs, w + 8 + 8 * block_count);
+
+	return ret;
 }
 
 void PackedData::add_pack_source(PackSource *p_source) {
@@ -110,6 +357,20 @@ PackedData::PackedData() {
 	add_pack_source(memnew(PackedSourcePCK));
 }
 
+void PackedData::clear() {
+	MutexLock lock(pack_dirs_mutex);
+
+	files.clear();
+	for (PackIndex *index : pack_indices) {
+		memdelete(index);
+	}
+	pack_indices.clear();
+	pack_sequence = 0;
+
+	_free_packed_dirs(root);
+	root = memnew(PackedDir);
+}
+
 void PackedData::_free_packed_dirs(PackedDir *p_dir) {
 	for (const KeyValue<String, PackedDir *> &E : p_dir->subdirs) {
 		_free_packed_dirs(E.value);
@@ -118,9 +379,13 @@ void PackedData::_free_packed_dirs(PackedDir *p_dir) {
 }
 
 PackedData::~PackedData() {
+	FileAccessPack::_free_orphan_blocks();
 	for (int i = 0; i < sources.size(); i++) {
 		memdelete(sources[i]);
 	}
+	for (PackIndex *index : pack_indices) {
+		memdelete(index);
+	}
 	_free_packed_dirs(root);
 }
 
@@ -131,6 +396,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	if (f.is_null()) {
 		return false;
 	}
+	Ref<FileAccess> pack_f = f;
 
 	bool pck_header_found = false;
 
@@ -200,15 +466,17 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	f->get_32(); // patch number, not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION, false, "Pack version unsupported: " + itos(version) + ".");
+	// Version 3 only adds compressed files, so version 2 packs are still read as is.
+	ERR_FAIL_COND_V_MSG(version < PACK_FORMAT_VERSION_UNCOMPRESSED || version > PACK_FORMAT_VERSION, false, "Pack version unsupported: " + itos(version) + ".");
 	ERR_FAIL_COND_V_MSG(ver_major > VERSION_MAJOR || (ver_major == VERSION_MAJOR && ver_minor > VERSION_MINOR), false, "Pack created with a newer version of the engine: " + itos(ver_major) + "." + itos(ver_minor) + ".");
 
 	uint32_t pack_flags = f->get_32();
 	uint64_t file_base = f->get_64();
+	uint64_t directory_size = f->get_64(); // Reserved unless the directory is indexed.
 
 	bool enc_directory = (pack_flags & PACK_DIR_ENCRYPTED);
 
-	for (int i = 0; i < 16; i++) {
+	for (int i = 0; i < 14; i++) {
 		//reserved
 		f->get_32();
 	}
@@ -231,6 +499,18 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f = fae;
 	}
 
+	if (pack_flags & PACK_DIR_INDEXED) {
+		// Read the whole directory at once, files are looked up in it rather than added one by one.
+		ERR_FAIL_COND_V_MSG(directory_size > UINT32_MAX, false, "Invalid directory size in pack: '" + p_path + "'.");
+		Vector<uint8_t> directory;
+		directory.resize(directory_size);
+		ERR_FAIL_COND_V_MSG(f->get_buffer(directory.ptrw(), directory_size) != directory_size, false, "Can't read directory of pack: '" + p_path + "'.");
+		if (!PackedData::get_singleton()->add_pack_index(p_path, file_base + p_offset, directory, this, p_replace_files)) {
+			return false;
+		}
+		file_count = 0;
+	}
+
 	for (int i = 0; i < file_count; i++) {
 		uint32_t sl = f->get_32();
 		CharString cs;
@@ -247,13 +527,25 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
 
-		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
+		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), (flags & PACK_FILE_COMPRESSED));
+	}
+
+	// Whole packs only fit in the address space of 64-bit builds.
+	if (sizeof(void *) == 8 && pack_f->get_mapped_buffer()) {
+		mapped_packs[p_path] = pack_f;
 	}
 
 	return true;
 }
 
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
+	if (!p_file->encrypted) {
+		HashMap<String, Ref<FileAccess>>::ConstIterator E = mapped_packs.find(p_file->pack);
+		// The bounds of compressed files are checked against their block index when opening them.
+		if (E && (p_file->compressed || p_file->offset + p_file->size <= E->value->get_length())) {
+			return memnew(FileAccessPack(p_path, *p_file, E->value));
+		}
+	}
 	return memnew(FileAccessPack(p_path, *p_file));
 }
 
@@ -265,7 +557,9 @@ Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
 }
 
 bool FileAccessPack::is_open() const {
-	if (f.is_valid()) {
+	if (mapped) {
+		return true;
+	} else if (f.is_valid()) {
 		return f->is_open();
 	} else {
 		return false;
@@ -273,7 +567,7 @@ bool FileAccessPack::is_open() const {
 }
 
 void FileAccessPack::seek(uint64_t p_position) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(f.is_null() && !mapped, "File must be opened before use.");
 
 	if (p_position > pf.size) {
 		eof = true;
@@ -281,7 +575,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (!mapped && !pf.compressed) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -302,18 +598,31 @@ bool FileAccessPack::eof_reached() const {
 }
 
 uint8_t FileAccessPack::get_8() const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), 0, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(f.is_null() && !mapped, 0, "File must be opened before use.");
 	if (pos >= pf.size) {
 		eof = true;
 		return 0;
 	}
 
+	if (pf.compressed) {
+		uint8_t b = 0;
+		if (block_index >= 0 && pos / block_size == uint64_t(block_index)) {
+			b = block_data[pos % block_size];
+		} else {
+			_read_compressed(&b, pos, 1);
+		}
+		pos++;
+		return b;
+	}
+	if (mapped) {
+		return mapped[pos++];
+	}
 	pos++;
 	return f->get_8();
 }
 
 uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(f.is_null() && !mapped, -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
 	if (eof) {
@@ -326,21 +635,30 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
+	uint64_t read_pos = pos;
 	pos += p_length;
 
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+	if (pf.compressed) {
+		_read_compressed(p_dst, read_pos, to_read);
+	} else if (mapped) {
+		memcpy(p_dst, mapped + read_pos, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
 
 void FileAccessPack::set_big_endian(bool p_big_endian) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(f.is_null() && !mapped, "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (!mapped) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -367,12 +685,29 @@ bool FileAccessPack::file_exists(const String &p_name) {
 }
 
 void FileAccessPack::close() {
+	_release_blocks();
 	f = Ref<FileAccess>();
+	mapped_pack = Ref<FileAccess>();
+	mapped = nullptr;
 }
 
-FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
-		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack) :
+		pf(p_file) {
+	pos = 0;
+	eof = false;
+
+	if (p_mapped_pack.is_valid()) {
+		// The pack is already in memory, so there is no need to open it.
+		mapped_pack = p_mapped_pack;
+		mapped = mapped_pack->get_mapped_buffer() + pf.offset;
+		off = pf.offset;
+		if (pf.compressed && !_open_compressed()) {
+			close();
+		}
+		return;
+	}
+
+	f = FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(f.is_null(), "Can't open pack-referenced file '" + String(pf.pack) + "'.");
 
 	f->seek(pf.offset);
@@ -396,6 +731,236 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 	}
 	pos = 0;
 	eof = false;
+
+	if (pf.compressed && !_open_compressed()) {
+		close();
+	}
+}
+
+FileAccessPack::~FileAccessPack() {
+	_release_blocks();
+}
+
+Mutex FileAccessPack::orphan_blocks_mutex;
+LocalVector<FileAccessPack::CompressedBlock *> FileAccessPack::orphan_blocks;
+
+bool FileAccessPack::_open_compressed() {
+	ERR_FAIL_COND_V_MSG(pf.encrypted, false, "Pack-referenced file can't be both compressed and encrypted: '" + String(pf.pack) + "'.");
+
+	uint64_t available = 0;
+	uint8_t header[8];
+	if (mapped) {
+		available = mapped_pack->get_length() - pf.offset;
+		ERR_FAIL_COND_V_MSG(available < 8, false, "Truncated compressed pack-referenced file in '" + String(pf.pack) + "'.");
+		memcpy(header, mapped, 8);
+	} else {
+		available = f->get_length() - pf.offset;
+		f->seek(pf.offset);
+		ERR_FAIL_COND_V_MSG(f->get_buffer(header, 8) != 8, false, "Truncated compressed pack-referenced file in '" + String(pf.pack) + "'.");
+	}
+
+	block_size = decode_uint32(header);
+	const uint32_t block_count = decode_uint32(header + 4);
+	ERR_FAIL_COND_V_MSG(block_size == 0 || block_count != (pf.size + block_size - 1) / block_size, false, "Invalid block index in compressed pack-referenced file in '" + String(pf.pack) + "'.");
+	ERR_FAIL_COND_V_MSG(8 + 8 * (uint64_t(block_count) + 1) > available, false, "Truncated compressed pack-referenced file in '" + String(pf.pack) + "'.");
+
+	block_offsets.resize(block_count + 1);
+	for (uint32_t i = 0; i <= block_count; i++) {
+		block_offsets[i] = mapped ? decode_uint64(mapped + 8 + 8 * i) : f->get_64();
+		ERR_FAIL_COND_V_MSG(block_offsets[i] > available || (i > 0 && block_offsets[i] < block_offsets[i - 1]), false, "Invalid block index in compressed pack-referenced file in '" + String(pf.pack) + "'.");
+	}
+	return true;
+}
+
+uint32_t FileAccessPack::_get_block_size(uint32_t p_index) const {
+	return MIN(uint64_t(block_size), pf.size - uint64_t(p_index) * block_size);
+}
+
+FileAccessPack::CompressedBlock *FileAccessPack::_create_block(uint32_t p_index) const {
+	CompressedBlock *block = memnew(CompressedBlock);
+	block->index = p_index;
+	block->size = _get_block_size(p_index);
+	block->src_size = block_offsets[p_index + 1] - block_offsets[p_index];
+	if (mapped) {
+		block->src = mapped + block_offsets[p_index];
+	} else {
+		// Only the decompression is done ahead of time when the pack isn't mapped.
+		Ref<FileAccess> pack_f = f;
+		block->src_data.resize(block->src_size);
+		pack_f->seek(off + block_offsets[p_index]);
+		if (pack_f->get_buffer(block->src_data.ptrw(), block->src_size) != block->src_size) {
+			block->src_size = 0;
+		}
+		block->src = block->src_data.ptr();
+	}
+	return block;
+}
+
+void FileAccessPack::_decompress_block(CompressedBlock *p_block) {
+	p_block->data.resize(p_block->size);
+	if (p_block->src_size == p_block->size) {
+		// Stored as is, compressing it didn't make it smaller.
+		memcpy(p_block->data.ptrw(), p_block->src, p_block->size);
+		p_block->ok = true;
+	} else if (p_block->src_size > 0) {
+		int ret = Compression::decompress(p_block->data.ptrw(), p_block->size, p_block->src, p_block->src_size, Compression::MODE_ZSTD);
+		p_block->ok = ret == int(p_block->size);
+	}
+	p_block->done.set();
+}
+
+void FileAccessPack::_decompress_block_task(void *p_userdata) {
+	CompressedBlock *block = (CompressedBlock *)p_userdata;
+	if (block->claimed.increment() == 1) {
+		_decompress_block(block);
+	}
+}
+
+bool FileAccessPack::_reap_block(CompressedBlock *p_block) {
+	if (p_block->task_id != WorkerThreadPool::INVALID_TASK_ID) {
+		// Only wait for tasks that are done, a pending one may be far back in the queue.
+		if (!WorkerThreadPool::get_singleton()->is_task_completed(p_block->task_id)) {
+			return false;
+		}
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(p_block->task_id);
+	}
+	memdelete(p_block);
+	return true;
+}
+
+void FileAccessPack::_reap_orphan_blocks() {
+	MutexLock lock(orphan_blocks_mutex);
+	for (uint32_t i = 0; i < orphan_blocks.size(); i++) {
+		if (_reap_block(orphan_blocks[i])) {
+			orphan_blocks.remove_at_unordered(i);
+			i--;
+		}
+	}
+}
+
+void FileAccessPack::_free_orphan_blocks() {
+	// Nothing is left to reap them later, so wait for the tasks still using them.
+	MutexLock lock(orphan_blocks_mutex);
+	for (CompressedBlock *block : orphan_blocks) {
+		if (block->task_id != WorkerThreadPool::INVALID_TASK_ID) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(block->task_id);
+		}
+		memdelete(block);
+	}
+	orphan_blocks.reset();
+}
+
+void FileAccessPack::_reap_spent_blocks() const {
+	for (uint32_t i = 0; i < spent_blocks.size(); i++) {
+		if (_reap_block(spent_blocks[i])) {
+			spent_blocks.remove_at_unordered(i);
+			i--;
+		}
+	}
+}
+
+void FileAccessPack::_release_blocks() {
+	for (CompressedBlock *block : prefetched_blocks) {
+		block->claimed.increment(); // Not needed anymore, so the task can skip it.
+		spent_blocks.push_back(block);
+	}
+	prefetched_blocks.clear();
+
+	_reap_spent_blocks();
+	if (!spent_blocks.is_empty()) {
+		// The tasks still use these blocks, they will be freed once they are done.
+		MutexLock lock(orphan_blocks_mutex);
+		for (CompressedBlock *block : spent_blocks) {
+			orphan_blocks.push_back(block);
+		}
+	}
+	spent_blocks.clear();
+
+	block_data.clear();
+	block_index = -1;
+}
+
+bool FileAccessPack::_load_block(uint32_t p_index) const {
+	_reap_spent_blocks();
+	_reap_orphan_blocks();
+
+	const int64_t previous_index = block_index;
+	block_index = -1;
+
+	CompressedBlock *block = nullptr;
+	for (uint32_t i = 0; i < prefetched_blocks.size(); i++) {
+		CompressedBlock *prefetched = prefetched_blocks[i];
+		if (prefetched->index > p_index && prefetched->index <= p_index + PACK_COMPRESSED_PREFETCH_BLOCKS) {
+			continue;
+		}
+		if (prefetched->index == p_index) {
+			block = prefetched;
+		} else {
+			// Seeked away from it.
+			prefetched->claimed.increment();
+			spent_blocks.push_back(prefetched);
+		}
+		prefetched_blocks.remove_at(i);
+		i--;
+	}
+
+	if (!block) {
+		block = _create_block(p_index);
+	}
+
+	if (block->claimed.increment() == 1) {
+		_decompress_block(block);
+	} else {
+		// Already being decompressed by a task, which is not going to take long.
+		while (!block->done.is_set()) {
+			OS::get_singleton()->delay_usec(1);
+		}
+	}
+
+	const bool ok = block->ok;
+	block_data = block->data;
+	spent_blocks.push_back(block);
+	ERR_FAIL_COND_V_MSG(!ok, false, "Can't decompress block " + itos(p_index) + " of compressed pack-referenced file in '" + String(pf.pack) + "'.");
+	block_index = p_index;
+
+	// Decompress the next blocks meanwhile when reading sequentially.
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if ((p_index == 0 || previous_index + 1 == int64_t(p_index)) && pool && pool->get_thread_count() > 0) {
+		const uint32_t block_count = block_offsets.size() - 1;
+		for (uint32_t i = p_index + 1; i <= p_index + PACK_COMPRESSED_PREFETCH_BLOCKS && i < block_count; i++) {
+			bool prefetched = false;
+			for (const CompressedBlock *E : prefetched_blocks) {
+				if (E->index == i) {
+					prefetched = true;
+					break;
+				}
+			}
+			if (prefetched) {
+				continue;
+			}
+			CompressedBlock *next = _create_block(i);
+			next->task_id = pool->add_native_task(&_decompress_block_task, next, true, "Decompress pack block");
+			prefetched_blocks.push_back(next);
+		}
+	}
+
+	return true;
+}
+
+void FileAccessPack::_read_compressed(uint8_t *p_dst, uint64_t p_from, uint64_t p_length) const {
+	while (p_length > 0) {
+		const uint32_t index = p_from / block_size;
+		if (int64_t(index) != block_index && !_load_block(index)) {
+			memset(p_dst, 0, p_length);
+			return;
+		}
+		const uint64_t block_pos = p_from - uint64_t(index) * block_size;
+		const uint64_t to_copy = MIN(p_length, block_data.size() - block_pos);
+		memcpy(p_dst, block_data.ptr() + block_pos, to_copy);
+		p_dst += to_copy;
+		p_from += to_copy;
+		p_length -= to_copy;
+	}
 }
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -567,5 +1132,6 @@ String DirAccessPack::get_filesystem_type() const {
 }
 
 DirAccessPack::DirAccessPack() {
+	PackedData::get_singleton()->_add_pack_index_dirs();
 	current = PackedData::get_singleton()->root;
 }
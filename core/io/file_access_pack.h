@@ -33,6 +33,8 @@
 
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
@@ -40,15 +42,23 @@
 
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
-// The current packed file format version number.
-#define PACK_FORMAT_VERSION 2
+// The current packed file format version number, only written by packs with compressed files.
+#define PACK_FORMAT_VERSION 3
+// The version written by packs without compressed files, so engines predating compression can still read them.
+#define PACK_FORMAT_VERSION_UNCOMPRESSED 2
+// Uncompressed size of the blocks compressed files are split in.
+#define PACK_COMPRESSED_BLOCK_SIZE (64 * 1024)
+// Blocks of a compressed file decompressed ahead of the read position.
+#define PACK_COMPRESSED_PREFETCH_BLOCKS 2
 
 enum PackFlags {
-	PACK_DIR_ENCRYPTED = 1 << 0
+	PACK_DIR_ENCRYPTED = 1 << 0,
+	PACK_DIR_INDEXED = 1 << 1, // The directory ends with a table of path hashes, see PackedData::make_path_index().
 };
 
 enum PackFileFlags {
-	PACK_FILE_ENCRYPTED = 1 << 0
+	PACK_FILE_ENCRYPTED = 1 << 0,
+	PACK_FILE_COMPRESSED = 1 << 1, // Zstd blocks, see PackedData::compress_file().
 };
 
 class PackSource;
@@ -66,6 +76,9 @@ public:
 		uint8_t md5[16];
 		PackSource *src = nullptr;
 		bool encrypted;
+		bool compressed = false;
+		uint32_t sequence = 0; // Which pack added the file, used to tell which one provides it if several do.
+		bool replace = false;
 	};
 
 private:
@@ -96,7 +109,26 @@ private:
 		}
 	};
 
+	// Packs with a path index are looked up directly in their directory instead of adding their files one by one.
+	struct PackIndex {
+		String pack;
+		PackSource *src = nullptr;
+		uint64_t base = 0; // Offset file offsets are relative to.
+		uint32_t sequence = 0;
+		bool replace_files = false;
+		bool dirs_added = false;
+
+		Vector<uint8_t> directory; // File entries as stored in the pack, followed by the path index.
+		uint32_t index_count = 0;
+		uint32_t index_offset = 0;
+
+		const uint8_t *find_entry(const uint8_t *p_path_md5) const;
+	};
+
 	HashMap<PathMD5, PackedFile, PathMD5> files;
+	LocalVector<PackIndex *> pack_indices;
+	uint32_t pack_sequence = 0;
+	Mutex pack_dirs_mutex;
 
 	Vector<PackSource *> sources;
 
@@ -106,16 +138,23 @@ private:
 	bool disabled = false;
 
 	void _free_packed_dirs(PackedDir *p_dir);
+	void _add_path_to_dirs(const String &p_path);
+	void _add_pack_index_dirs();
+	bool _find_path(const Vector<uint8_t> &p_path_md5, PackedFile *r_file);
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_compressed = false); // for PackSource
+	bool add_pack_index(const String &p_pkg_path, uint64_t p_base, const Vector<uint8_t> &p_directory, PackSource *p_src, bool p_replace_files); // for PackSource
+	static Vector<uint8_t> compress_file(const Vector<uint8_t> &p_data, uint32_t p_block_size = PACK_COMPRESSED_BLOCK_SIZE);
+	static Vector<uint8_t> make_path_index(const Vector<String> &p_paths, const Vector<uint32_t> &p_entry_offsets);
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
 
 	static PackedData *get_singleton() { return singleton; }
 	Error add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset);
+	void clear(); // Removes the files of all the added packs.
 
 	_FORCE_INLINE_ Ref<FileAccess> try_open_path(const String &p_path);
 	_FORCE_INLINE_ bool has_path(const String &p_path);
@@ -135,12 +174,31 @@ public:
 };
 
 class PackedSourcePCK : public PackSource {
+	// Packs mapped in memory, so the files in them are read without opening the pack again.
+	HashMap<String, Ref<FileAccess>> mapped_packs;
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
 };
 
 class FileAccessPack : public FileAccess {
+	friend class PackedData;
+
+	struct CompressedBlock {
+		uint32_t index = 0;
+		uint32_t size = 0;
+		const uint8_t *src = nullptr; // Points either to the mapped pack or to src_data.
+		uint32_t src_size = 0;
+		Vector<uint8_t> src_data;
+		Vector<uint8_t> data;
+		bool ok = false;
+
+		SafeNumeric<uint32_t> claimed; // Whoever claims the block first decompresses it.
+		SafeFlag done;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+	};
+
 	PackedData::PackedFile pf;
 
 	mutable uint64_t pos;
@@ -148,6 +206,34 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+	Ref<FileAccess> mapped_pack; // Keeps the mapping alive, never read from as it's shared.
+	const uint8_t *mapped = nullptr;
+
+	// Compressed files are read one block at a time, the next blocks are decompressed on the WorkerThreadPool meanwhile.
+	uint32_t block_size = 0;
+	LocalVector<uint64_t> block_offsets;
+	mutable Vector<uint8_t> block_data;
+	mutable int64_t block_index = -1;
+	mutable LocalVector<CompressedBlock *> prefetched_blocks;
+	mutable LocalVector<CompressedBlock *> spent_blocks;
+
+	static Mutex orphan_blocks_mutex;
+	static LocalVector<CompressedBlock *> orphan_blocks;
+
+	static void _decompress_block(CompressedBlock *p_block);
+	static void _decompress_block_task(void *p_userdata);
+	static bool _reap_block(CompressedBlock *p_block);
+	static void _reap_orphan_blocks();
+	static void _free_orphan_blocks();
+
+	bool _open_compressed();
+	uint32_t _get_block_size(uint32_t p_index) const;
+	CompressedBlock *_create_block(uint32_t p_index) const;
+	void _reap_spent_blocks() const;
+	void _release_blocks();
+	bool _load_block(uint32_t p_index) const;
+	void _read_compressed(uint8_t *p_dst, uint64_t p_from, uint64_t p_length) const;
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual uint32_t _get_unix_permissions(const String &p_file) override { return 0; }
@@ -166,6 +252,7 @@ public:
 	virtual uint8_t get_8() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_buffer() const override { return pf.compressed ? nullptr : mapped; }
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -180,24 +267,24 @@ public:
 
 	virtual void close() override;
 
-	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack = Ref<FileAccess>());
+	~FileAccessPack();
 };
 
 Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
-	PathMD5 pmd5(p_path.md5_buffer());
-	HashMap<PathMD5, PackedFile, PathMD5>::Iterator E = files.find(pmd5);
-	if (!E) {
+	PackedFile pf;
+	if (!_find_path(p_path.md5_buffer(), &pf)) {
 		return nullptr; //not found
 	}
-	if (E->value.offset == 0) {
+	if (pf.offset == 0) {
 		return nullptr; //was erased
 	}
 
-	return E->value.src->get_file(p_path, &E->value);
+	return pf.src->get_file(p_path, &pf);
 }
 
 bool PackedData::has_path(const String &p_path) {
-	return files.has(PathMD5(p_path.md5_buffer()));
+	return _find_path(p_path.md5_buffer(), nullptr);
 }
 
 bool PackedData::has_directory(const String &p_path) {
@@ -33,7 +33,7 @@
 #include "core/crypto/crypto_core.h"
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
-#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION, PACK_FORMAT_VERSION_UNCOMPRESSED
 #include "core/version.h"
 
 static int _get_pad(int p_alignment, int p_n) {
@@ -48,7 +48,7 @@ static int _get_pad(int p_alignment, int p_n) {
 
 void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_name", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(32), DEFVAL("0000000000000000000000000000000000000000000000000000000000000000"), DEFVAL(false));
-	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path", "encrypt", "compress"), &PCKPacker::add_file, DEFVAL(false), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
 }
 
@@ -89,79 +89,48 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &
 	alignment = p_alignment;
 
 	file->store_32(PACK_HEADER_MAGIC);
-	file->store_32(PACK_FORMAT_VERSION);
+	// Only packs with compressed files need the current version, see flush().
+	version_ofs = file->get_position();
+	file->store_32(PACK_FORMAT_VERSION_UNCOMPRESSED);
 	file->store_32(VERSION_MAJOR);
 	file->store_32(VERSION_MINOR);
 	file->store_32(VERSION_PATCH);
 
-	uint32_t pack_flags = 0;
+	uint32_t pack_flags = PACK_DIR_INDEXED;
 	if (enc_dir) {
 		pack_flags |= PACK_DIR_ENCRYPTED;
 	}
 	file->store_32(pack_flags); // flags
 
 	files.clear();
-	ofs = 0;
 
 	return OK;
 }
 
-Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encrypt) {
+Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encrypt, bool p_compress) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(p_encrypt && p_compress, ERR_INVALID_PARAMETER, "Files can't be both encrypted and compressed.");
 
 	Ref<FileAccess> f = FileAccess::open(p_src, FileAccess::READ);
 	if (f.is_null()) {
 		return ERR_FILE_CANT_OPEN;
 	}
 
+	// The file is only read when flushing, so adding many files doesn't keep their data in memory.
 	File pf;
 	pf.path = p_file;
 	pf.src_path = p_src;
-	pf.ofs = ofs;
 	pf.size = f->get_length();
-
-	Vector<uint8_t> data = FileAccess::get_file_as_bytes(p_src);
-	{
-		unsigned char hash[16];
-		CryptoCore::md5(data.ptr(), data.size(), hash);
-		pf.md5.resize(16);
-		for (int i = 0; i < 16; i++) {
-			pf.md5.write[i] = hash[i];
-		}
-	}
 	pf.encrypted = p_encrypt;
-
-	uint64_t _size = pf.size;
-	if (p_encrypt) { // Add encryption overhead.
-		if (_size % 16) { // Pad to encryption block size.
-			_size += 16 - (_size % 16);
-		}
-		_size += 16; // hash
-		_size += 8; // data size
-		_size += 16; // iv
-	}
-
-	int pad = _get_pad(alignment, ofs + _size);
-	ofs = ofs + _size + pad;
+	pf.compressed = p_compress;
+	pf.md5.resize(16);
 
 	files.push_back(pf);
 
 	return OK;
 }
 
-Error PCKPacker::flush(bool p_verbose) {
-	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
-
-	int64_t file_base_ofs = file->get_position();
-	file->store_64(0); // files base
-
-	for (int i = 0; i < 16; i++) {
-		file->store_32(0); // reserved
-	}
-
-	// write the index
-	file->store_32(files.size());
-
+Error PCKPacker::_store_directory(uint64_t &r_directory_size) {
 	Ref<FileAccessEncrypted> fae;
 	Ref<FileAccess> fhead = file;
 
@@ -175,10 +144,17 @@ Error PCKPacker::flush(bool p_verbose) {
 		fhead = fae;
 	}
 
+	Vector<String> paths;
+	Vector<uint32_t> entry_offsets;
+	uint64_t directory_size = 0;
 	for (int i = 0; i < files.size(); i++) {
 		int string_len = files[i].path.utf8().length();
 		int pad = _get_pad(4, string_len);
 
+		paths.push_back(files[i].path);
+		entry_offsets.push_back(directory_size);
+		directory_size += 4 + string_len + pad + 8 + 8 + 16 + 4;
+
 		fhead->store_32(string_len + pad);
 		fhead->store_buffer((const uint8_t *)files[i].path.utf8().get_data(), string_len);
 		for (int j = 0; j < pad; j++) {
@@ -193,14 +169,57 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (files[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
+	Vector<uint8_t> path_index = PackedData::make_path_index(paths, entry_offsets);
+	fhead->store_buffer(path_index.ptr(), path_index.size());
+	directory_size += path_index.size();
+
 	if (fae.is_valid()) {
 		fhead.unref();
 		fae.unref();
 	}
 
+	r_directory_size = directory_size;
+	return OK;
+}
+
+Error PCKPacker::flush(bool p_verbose) {
+	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
+
+	bool has_compressed_files = false;
+	for (int i = 0; i < files.size(); i++) {
+		has_compressed_files = has_compressed_files || files[i].compressed;
+	}
+	if (has_compressed_files) {
+		int64_t header_end = file->get_position();
+		file->seek(version_ofs);
+		file->store_32(PACK_FORMAT_VERSION);
+		file->seek(header_end);
+	}
+
+	int64_t file_base_ofs = file->get_position();
+	file->store_64(0); // files base
+	file->store_64(0); // directory size
+
+	for (int i = 0; i < 14; i++) {
+		file->store_32(0); // reserved
+	}
+
+	// write the index
+	file->store_32(files.size());
+
+	// The directory is written again once the files are, with their offsets and md5.
+	// Its size doesn't depend on them, so the files are not moved by it.
+	int64_t directory_ofs = file->get_position();
+	uint64_t directory_size = 0;
+	Error err = _store_directory(directory_size);
+	ERR_FAIL_COND_V(err != OK, err);
+
 	int header_padding = _get_pad(alignment, file->get_position());
 	for (int i = 0; i < header_padding; i++) {
 		file->store_8(Math::rand() % 256);
@@ -209,6 +228,7 @@ Error PCKPacker::flush(bool p_verbose) {
 	int64_t file_base = file->get_position();
 	file->seek(file_base_ofs);
 	file->store_64(file_base); // update files base
+	file->store_64(directory_size);
 	file->seek(file_base);
 
 	const uint32_t buf_max = 65536;
@@ -216,28 +236,50 @@ Error PCKPacker::flush(bool p_verbose) {
 
 	int count = 0;
 	for (int i = 0; i < files.size(); i++) {
-		Ref<FileAccess> src = FileAccess::open(files[i].src_path, FileAccess::READ);
-		uint64_t to_write = files[i].size;
-
-		Ref<FileAccess> ftmp = file;
-		if (files[i].encrypted) {
-			fae.instantiate();
-			ERR_FAIL_COND_V(fae.is_null(), ERR_CANT_CREATE);
+		File &pf = files.write[i];
+		pf.ofs = file->get_position() - file_base;
+
+		CryptoCore::MD5Context ctx;
+		ctx.start();
+
+		if (pf.compressed) {
+			// Only one file is kept in memory at a time, while it is compressed.
+			Vector<uint8_t> data = FileAccess::get_file_as_bytes(pf.src_path);
+			ctx.update(data.ptr(), data.size());
+			Vector<uint8_t> compressed_data = PackedData::compress_file(data);
+			file->store_buffer(compressed_data.ptr(), compressed_data.size());
+		} else {
+			Ref<FileAccess> src = FileAccess::open(pf.src_path, FileAccess::READ);
+			uint64_t to_write = pf.size;
+
+			Ref<FileAccessEncrypted> fae;
+			Ref<FileAccess> ftmp = file;
+			if (pf.encrypted) {
+				fae.instantiate();
+				ERR_FAIL_COND_V(fae.is_null(), ERR_CANT_CREATE);
+
+				err = fae->open_and_parse(file, key, FileAccessEncrypted::MODE_WRITE_AES256, false);
+				ERR_FAIL_COND_V(err != OK, ERR_CANT_CREATE);
+				ftmp = fae;
+			}
 
-			Error err = fae->open_and_parse(file, key, FileAccessEncrypted::MODE_WRITE_AES256, false);
-			ERR_FAIL_COND_V(err != OK, ERR_CANT_CREATE);
-			ftmp = fae;
-		}
+			while (to_write > 0) {
+				uint64_t read = src->get_buffer(buf, MIN(to_write, buf_max));
+				ctx.update(buf, read);
+				ftmp->store_buffer(buf, read);
+				to_write -= read;
+			}
 
-		while (to_write > 0) {
-			uint64_t read = src->get_buffer(buf, MIN(to_write, buf_max));
-			ftmp->store_buffer(buf, read);
-			to_write -= read;
+			if (fae.is_valid()) {
+				ftmp.unref();
+				fae.unref();
+			}
 		}
 
-		if (fae.is_valid()) {
-			ftmp.unref();
-			fae.unref();
+		unsigned char hash[16];
+		ctx.finish(hash);
+		for (int j = 0; j < 16; j++) {
+			pf.md5.write[j] = hash[j];
 		}
 
 		int pad = _get_pad(alignment, file->get_position());
@@ -248,10 +290,14 @@ Error PCKPacker::flush(bool p_verbose) {
 		count += 1;
 		const int file_num = files.size();
 		if (p_verbose && (file_num > 0)) {
-			print_line(vformat("[%d/%d - %d%%] PCKPacker flush: %s -> %s", count, file_num, float(count) / file_num * 100, files[i].src_path, files[i].path));
+			print_line(vformat("[%d/%d - %d%%] PCKPacker flush: %s -> %s", count, file_num, float(count) / file_num * 100, pf.src_path, pf.path));
 		}
 	}
 
+	file->seek(directory_ofs);
+	err = _store_directory(directory_size);
+	ERR_FAIL_COND_V(err != OK, err);
+
 	file.unref();
 	memdelete_arr(buf);
 
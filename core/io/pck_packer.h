@@ -40,7 +40,7 @@ class PCKPacker : public RefCounted {
 
 	Ref<FileAccess> file;
 	int alignment = 0;
-	uint64_t ofs = 0;
+	uint64_t version_ofs = 0;
 
 	Vector<uint8_t> key;
 	bool enc_dir = false;
@@ -50,16 +50,20 @@ class PCKPacker : public RefCounted {
 	struct File {
 		String path;
 		String src_path;
+		// The offset and md5 are only known once the file is written by flush().
 		uint64_t ofs = 0;
 		uint64_t size = 0;
 		bool encrypted = false;
+		bool compressed = false;
 		Vector<uint8_t> md5;
 	};
 	Vector<File> files;
 
+	Error _store_directory(uint64_t &r_directory_size);
+
 public:
 	Error pck_start(const String &p_file, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
-	Error add_file(const String &p_file, const String &p_src, bool p_encrypt = false);
+	Error add_file(const String &p_file, const String &p_src, bool p_encrypt = false, bool p_compress = false);
 	Error flush(bool p_verbose = false);
 
 	PCKPacker() {}
@@ -154,21 +154,35 @@ StringName ResourceLoaderBinary::_get_string() {
 	uint32_t id = f->get_32();
 	if (id & 0x80000000) {
 		uint32_t len = id & 0x7FFFFFFF;
-		if ((int)len > str_buf.size()) {
-			str_buf.resize(len);
-		}
 		if (len == 0) {
 			return StringName();
 		}
-		f->get_buffer((uint8_t *)&str_buf[0], len);
-		String s;
-		s.parse_utf8(&str_buf[0]);
-		return s;
+		return _get_utf8_string(len);
 	}
 
 	return string_map[id];
 }
 
+String ResourceLoaderBinary::_get_utf8_string(uint32_t p_len) {
+	String s;
+	if (f_mapped) {
+		// Parse the string where it is rather than copying it first.
+		uint64_t pos = f->get_position();
+		if (pos + p_len <= f->get_length()) {
+			s.parse_utf8((const char *)f_mapped + pos, p_len);
+			f->seek(pos + p_len);
+			return s;
+		}
+	}
+
+	if ((int)p_len > str_buf.size()) {
+		str_buf.resize(p_len);
+	}
+	f->get_buffer((uint8_t *)&str_buf[0], p_len);
+	s.parse_utf8(&str_buf[0]);
+	return s;
+}
+
 Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 	uint32_t prop_type = f->get_32();
 	print_bl("find property of type: " + itos(prop_type));
@@ -901,16 +915,10 @@ static String get_ustring(Ref<FileAccess> f) {
 
 String ResourceLoaderBinary::get_unicode_string() {
 	int len = f->get_32();
-	if (len > str_buf.size()) {
-		str_buf.resize(len);
-	}
-	if (len == 0) {
+	if (len <= 0) {
 		return String();
 	}
-	f->get_buffer((uint8_t *)&str_buf[0], len);
-	String s;
-	s.parse_utf8(&str_buf[0]);
-	return s;
+	return _get_utf8_string(len);
 }
 
 void ResourceLoaderBinary::get_classes_used(Ref<FileAccess> p_f, HashSet<StringName> *p_classes) {
@@ -975,6 +983,9 @@ void ResourceLoaderBinary::open(Ref<FileAccess> p_f, bool p_no_resources, bool p
 		ERR_FAIL_MSG("Unrecognized binary resource file: " + local_path + ".");
 	}
 
+	// Reading from memory is much cheaper than going through the file for every value.
+	f_mapped = f->get_mapped_buffer();
+
 	bool big_endian = f->get_32();
 	bool use_real64 = f->get_32();
 
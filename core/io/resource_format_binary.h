@@ -44,6 +44,7 @@ class ResourceLoaderBinary {
 	uint32_t ver_format = 0;
 
 	Ref<FileAccess> f;
+	const uint8_t *f_mapped = nullptr; // Set when `f` can be read in memory directly.
 
 	uint64_t importmd_ofs = 0;
 
@@ -55,6 +56,7 @@ class ResourceLoaderBinary {
 	Vector<StringName> string_map;
 
 	StringName _get_string();
+	String _get_utf8_string(uint32_t p_len);
 
 	struct ExtResource {
 		String path;
@@ -234,10 +234,6 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 	ThreadLoadTask &load_task = *(ThreadLoadTask *)p_userdata;
 	load_task.loader_id = Thread::get_caller_id();
 
-	if (load_task.cond_var) {
-		//this is an actual thread, so wait for Ok from semaphore
-		thread_load_semaphore->wait(); //wait until its ok to start loading
-	}
 	load_task.resource = _load(load_task.remapped_path, load_task.remapped_path != load_task.local_path ? load_task.local_path : String(), load_task.type_hint, load_task.cache_mode, &load_task.error, load_task.use_sub_threads, &load_task.progress);
 
 	load_task.progress = 1.0; //it was fully loaded at this point, so force progress to 1.0
@@ -249,16 +245,6 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 		load_task.status = THREAD_LOAD_LOADED;
 	}
 	if (load_task.cond_var) {
-		if (load_task.start_next && thread_waiting_count > 0) {
-			thread_waiting_count--;
-			//thread loading count remains constant, this ends but another one begins
-			thread_load_semaphore->post();
-		} else {
-			thread_loading_count--; //no threads waiting, just reduce loading count
-		}
-
-		print_lt("END: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_waiting_count) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
-
 		load_task.cond_var->notify_all();
 		memdelete(load_task.cond_var);
 		load_task.cond_var = nullptr;
@@ -289,6 +275,62 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 	thread_load_mutex->unlock();
 }
 
+void ResourceLoader::_thread_load_worker(void *p_userdata) {
+	// Workers run on the WorkerThreadPool and take queued loads until there are none left,
+	// or until more workers than allowed are active (some of them may have been suspended).
+	const bool was_worker = thread_load_is_worker;
+	thread_load_is_worker = true;
+
+	thread_load_mutex->lock();
+	while (!thread_load_queue.is_empty() && thread_loading_count - thread_suspended_count <= thread_load_max) {
+		ThreadLoadTask *load_task = thread_load_queue.front()->get();
+		thread_load_queue.pop_front();
+		load_task->queue_element = nullptr;
+		load_task->started = true;
+		thread_load_mutex->unlock();
+
+		_thread_load_function(load_task);
+
+		thread_load_mutex->lock();
+	}
+	thread_loading_count--;
+
+	print_lt("END: load count: " + itos(thread_loading_count) + " / queue count: " + itos(thread_load_queue.size()) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
+
+	thread_load_mutex->unlock();
+
+	thread_load_is_worker = was_worker;
+}
+
+void ResourceLoader::_thread_load_start_worker() {
+	// Must be called with thread_load_mutex locked.
+	if (thread_load_queue.is_empty() || thread_loading_count - thread_suspended_count >= thread_load_max) {
+		return;
+	}
+	// Workers run on the threads of the pool, including the suspended ones, so at least one thread is always left to
+	// the other tasks, which loads may wait for. Loads needed meanwhile are taken from the queue by the threads waiting for them.
+	if (thread_loading_count >= MAX(WorkerThreadPool::get_singleton()->get_thread_count() - 1, 1)) {
+		return;
+	}
+	thread_loading_count++;
+	thread_load_workers.push_back(WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_thread_load_worker, nullptr, true, "ResourceLoader"));
+}
+
+void ResourceLoader::_thread_load_take_finished_workers(LocalVector<WorkerThreadPool::TaskID> &r_finished_workers) {
+	// Must be called with thread_load_mutex locked, the workers are waited for once it's unlocked.
+	// Workers can't wait for other workers, as that may run another load on top of their own.
+	if (thread_load_is_worker) {
+		return;
+	}
+	for (uint32_t i = 0; i < thread_load_workers.size(); i++) {
+		if (WorkerThreadPool::get_singleton()->is_task_completed(thread_load_workers[i])) {
+			r_finished_workers.push_back(thread_load_workers[i]);
+			thread_load_workers.remove_at_unordered(i);
+			i--;
+		}
+	}
+}
+
 static String _validate_local_path(const String &p_path) {
 	ResourceUID::ID uid = ResourceUID::get_singleton()->text_to_id(p_path);
 	if (uid != ResourceUID::INVALID_ID) {
@@ -302,6 +344,8 @@ static String _validate_local_path(const String &p_path) {
 Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads, ResourceFormatLoader::CacheMode p_cache_mode, const String &p_source_resource) {
 	String local_path = _validate_local_path(p_path);
 
+	LocalVector<WorkerThreadPool::TaskID> finished_workers;
+
 	thread_load_mutex->lock();
 
 	if (!p_source_resource.is_empty()) {
@@ -365,24 +409,20 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 	ThreadLoadTask &load_task = thread_load_tasks[local_path];
 
 	if (load_task.resource.is_null()) { //needs to be loaded in thread
+		// Queue it for the workers; a thread that needs it before they get to it will load it itself.
+		load_task.queue_element = thread_load_queue.push_back(&load_task);
+		_thread_load_take_finished_workers(finished_workers);
+		_thread_load_start_worker();
 
-		load_task.cond_var = memnew(ConditionVariable);
-		if (thread_loading_count < thread_load_max) {
-			thread_loading_count++;
-			thread_load_semaphore->post(); //we have free threads, so allow one
-		} else {
-			thread_waiting_count++;
-		}
-
-		print_lt("REQUEST: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_waiting_count) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
-
-		load_task.thread = memnew(Thread);
-		load_task.thread->start(_thread_load_function, &thread_load_tasks[local_path]);
-		load_task.loader_id = load_task.thread->get_id();
+		print_lt("REQUEST: load count: " + itos(thread_loading_count) + " / queue count: " + itos(thread_load_queue.size()) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
 	}
 
 	thread_load_mutex->unlock();
 
+	for (const WorkerThreadPool::TaskID &worker : finished_workers) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(worker);
+	}
+
 	return OK;
 }
 
@@ -431,6 +471,31 @@ ResourceLoader::ThreadLoadStatus ResourceLoader::load_threaded_get_status(const
 Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path, Error *r_error) {
 	String local_path = _validate_local_path(p_path);
 
+	LocalVector<WorkerThreadPool::TaskID> finished_workers;
+	ThreadLoadTask *queued_task = nullptr;
+
+	thread_load_mutex->lock();
+	_thread_load_take_finished_workers(finished_workers);
+	HashMap<String, ThreadLoadTask>::Iterator E = thread_load_tasks.find(local_path);
+	if (E && !E->value.started && E->value.status == THREAD_LOAD_IN_PROGRESS) {
+		// No worker got to it yet, so load it on this thread instead of waiting.
+		queued_task = &E->value;
+		queued_task->started = true;
+		if (queued_task->queue_element) {
+			thread_load_queue.erase(queued_task->queue_element);
+			queued_task->queue_element = nullptr;
+		}
+	}
+	thread_load_mutex->unlock();
+
+	for (const WorkerThreadPool::TaskID &worker : finished_workers) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(worker);
+	}
+
+	if (queued_task) {
+		_thread_load_function(queued_task);
+	}
+
 	MutexLock thread_load_lock(*thread_load_mutex);
 	if (!thread_load_tasks.has(local_path)) {
 		if (r_error) {
@@ -450,11 +515,8 @@ Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path, Error *r_e
 			}
 			return Ref<Resource>();
 		} else if (!load_task.cond_var) {
-			// Load is in progress, but a condition variable was never created for it.
-			// That happens when a load has been initiated with subthreads disabled,
-			// but now another load thread needs to interact with this one (either
-			// because of subthreads being used this time, or because it's simply a
-			// threaded load running on a different thread).
+			// Load is in progress on another thread (or queued, if it was requested
+			// after we checked above), but nobody waited for it yet.
 			// Since we want to be notified when the load ends, we must create the
 			// condition variable now.
 			load_task.cond_var = memnew(ConditionVariable);
@@ -467,27 +529,22 @@ Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path, Error *r_e
 			// As we got a cond var, this means we are going to have to wait
 			// until the sub-resource is done loading
 			//
-			// As this thread will become 'blocked' we should "exchange" its
-			// active status with a waiting one, to ensure load continues.
+			// If this thread is a worker, it will become 'blocked' so we should
+			// let another worker take queued loads in its place, to ensure load continues.
 			//
 			// This ensures loading is never blocked and that is also within
-			// the maximum number of active threads.
-
-			if (thread_waiting_count > 0) {
-				thread_waiting_count--;
-				thread_loading_count++;
-				thread_load_semaphore->post();
+			// the maximum number of active workers.
 
-				load_task.start_next = false; //do not start next since we are doing it here
+			if (thread_load_is_worker) {
+				thread_suspended_count++;
+				_thread_load_start_worker();
 			}
 
-			thread_suspended_count++;
-
-			print_lt("GET: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_waiting_count) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
+			print_lt("GET: load count: " + itos(thread_loading_count) + " / queue count: " + itos(thread_load_queue.size()) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
 		}
 
 		bool still_valid = true;
-		bool was_thread = load_task.thread;
+		bool was_worker = thread_load_is_worker;
 		do {
 			load_task.cond_var->wait(thread_load_lock);
 			if (!thread_load_tasks.has(local_path)) { //may have been erased during unlock and this was always an invalid call
@@ -496,7 +553,7 @@ Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path, Error *r_e
 			}
 		} while (load_task.cond_var); // In case of spurious wakeup.
 
-		if (was_thread) {
+		if (was_worker) {
 			thread_suspended_count--;
 		}
 
@@ -516,10 +573,6 @@ Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path, Error *r_e
 	load_task.requests--;
 
 	if (load_task.requests == 0) {
-		if (load_task.thread) { //thread may not have been used
-			load_task.thread->wait_to_finish();
-			memdelete(load_task.thread);
-		}
 		thread_load_tasks.erase(local_path);
 	}
 
@@ -574,6 +627,7 @@ Ref<Resource> ResourceLoader::load(const String &p_path, const String &p_type_hi
 		load_task.type_hint = p_type_hint;
 		load_task.cache_mode = p_cache_mode; //ignore
 		load_task.loader_id = Thread::get_caller_id();
+		load_task.started = true;
 
 		thread_load_tasks[local_path] = load_task;
 
@@ -958,34 +1012,39 @@ void ResourceLoader::clear_translation_remaps() {
 }
 
 void ResourceLoader::clear_thread_load_tasks() {
+	// Let the workers finish the loads in progress and in the queue. Suspended workers may start new ones, so wait until there are none left.
 	thread_load_mutex->lock();
+	while (!thread_load_workers.is_empty()) {
+		LocalVector<WorkerThreadPool::TaskID> workers = thread_load_workers;
+		thread_load_workers.clear();
+		thread_load_mutex->unlock();
 
-	for (KeyValue<String, ResourceLoader::ThreadLoadTask> &E : thread_load_tasks) {
-		switch (E.value.status) {
-			case ResourceLoader::ThreadLoadStatus::THREAD_LOAD_LOADED: {
-				E.value.resource = Ref<Resource>();
-			} break;
-
-			case ResourceLoader::ThreadLoadStatus::THREAD_LOAD_IN_PROGRESS: {
-				if (E.value.thread != nullptr) {
-					E.value.thread->wait_to_finish();
-					memdelete(E.value.thread);
-					E.value.thread = nullptr;
-				}
-				E.value.resource = Ref<Resource>();
-			} break;
-
-			case ResourceLoader::ThreadLoadStatus::THREAD_LOAD_FAILED:
-			default: {
-				// do nothing
-			}
+		for (const WorkerThreadPool::TaskID &worker : workers) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(worker);
 		}
+
+		thread_load_mutex->lock();
+	}
+
+	for (KeyValue<String, ResourceLoader::ThreadLoadTask> &E : thread_load_tasks) {
+		E.value.resource = Ref<Resource>();
 	}
 	thread_load_tasks.clear();
 
 	thread_load_mutex->unlock();
 }
 
+void ResourceLoader::set_max_threaded_loads(int p_max) {
+	ERR_FAIL_COND(p_max < 1);
+	thread_load_mutex->lock();
+	thread_load_max = p_max;
+	thread_load_mutex->unlock();
+}
+
+int ResourceLoader::get_max_threaded_loads() {
+	return thread_load_max;
+}
+
 void ResourceLoader::load_path_remaps() {
 	if (!ProjectSettings::get_singleton()->has_setting("path_remap/remapped_paths")) {
 		return;
@@ -1084,14 +1143,11 @@ void ResourceLoader::initialize() {
 	thread_load_mutex = memnew(SafeBinaryMutex<BINARY_MUTEX_TAG>);
 	thread_load_max = OS::get_singleton()->get_processor_count();
 	thread_loading_count = 0;
-	thread_waiting_count = 0;
 	thread_suspended_count = 0;
-	thread_load_semaphore = memnew(Semaphore);
 }
 
 void ResourceLoader::finalize() {
 	memdelete(thread_load_mutex);
-	memdelete(thread_load_semaphore);
 }
 
 ResourceLoadErrorNotify ResourceLoader::err_notify = nullptr;
@@ -1108,10 +1164,11 @@ template <>
 thread_local uint32_t SafeBinaryMutex<ResourceLoader::BINARY_MUTEX_TAG>::count = 0;
 SafeBinaryMutex<ResourceLoader::BINARY_MUTEX_TAG> *ResourceLoader::thread_load_mutex = nullptr;
 HashMap<String, ResourceLoader::ThreadLoadTask> ResourceLoader::thread_load_tasks;
-Semaphore *ResourceLoader::thread_load_semaphore = nullptr;
+List<ResourceLoader::ThreadLoadTask *> ResourceLoader::thread_load_queue;
+LocalVector<WorkerThreadPool::TaskID> ResourceLoader::thread_load_workers;
+thread_local bool ResourceLoader::thread_load_is_worker = false;
 
 int ResourceLoader::thread_loading_count = 0;
-int ResourceLoader::thread_waiting_count = 0;
 int ResourceLoader::thread_suspended_count = 0;
 int ResourceLoader::thread_load_max = 0;
 
@@ -34,7 +34,7 @@
 #include "core/io/resource.h"
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/script_language.h"
-#include "core/os/semaphore.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/thread.h"
 
 class ConditionVariable;
@@ -138,7 +138,6 @@ private:
 	static Ref<ResourceFormatLoader> _find_custom_resource_format_loader(String path);
 
 	struct ThreadLoadTask {
-		Thread *thread = nullptr;
 		Thread::ID loader_id = 0;
 		ConditionVariable *cond_var = nullptr;
 		String local_path;
@@ -151,16 +150,21 @@ private:
 		Ref<Resource> resource;
 		bool xl_remapped = false;
 		bool use_sub_threads = false;
-		bool start_next = true;
+		bool started = false; // Until then, the load is queued and any thread waiting for it may run it.
+		List<ThreadLoadTask *>::Element *queue_element = nullptr;
 		int requests = 0;
 		HashSet<String> sub_tasks;
 	};
 
 	static void _thread_load_function(void *p_userdata);
+	static void _thread_load_worker(void *p_userdata);
+	static void _thread_load_start_worker();
+	static void _thread_load_take_finished_workers(LocalVector<WorkerThreadPool::TaskID> &r_finished_workers);
 	static SafeBinaryMutex<BINARY_MUTEX_TAG> *thread_load_mutex;
 	static HashMap<String, ThreadLoadTask> thread_load_tasks;
-	static Semaphore *thread_load_semaphore;
-	static int thread_waiting_count;
+	static List<ThreadLoadTask *> thread_load_queue;
+	static LocalVector<WorkerThreadPool::TaskID> thread_load_workers;
+	static thread_local bool thread_load_is_worker;
 	static int thread_loading_count;
 	static int thread_suspended_count;
 	static int thread_load_max;
@@ -227,6 +231,9 @@ public:
 
 	static void clear_thread_load_tasks();
 
+	static void set_max_threaded_loads(int p_max);
+	static int get_max_threaded_loads();
+
 	static void set_load_callback(ResourceLoadedCallback p_callback);
 	static ResourceLoaderImport import;
 
@@ -54,6 +54,9 @@
 #include "bvh_tree.h"
 #include "core/os/mutex.h"
 
+// below this number of changed items, pairing is always done on the calling thread
+#define BVH_PARALLEL_PAIRING_MIN_ITEMS 64
+
 #define BVHTREE_CLASS BVH_Tree<T, NUM_TREES, 2, MAX_ITEMS, USER_PAIR_TEST_FUNCTION, USER_CULL_TEST_FUNCTION, USE_PAIRS, BOUNDS, POINT>
 #define BVH_LOCKED_FUNCTION BVHLockedFunction _lock_guard(&_mutex, BVH_THREAD_SAFE &&_thread_safe);
 
@@ -65,6 +68,9 @@ public:
 	typedef void *(*PairCallback)(void *, uint32_t, T *, int, uint32_t, T *, int);
 	typedef void (*UnpairCallback)(void *, uint32_t, T *, int, uint32_t, T *, int, void *);
 	typedef void *(*CheckPairCallback)(void *, uint32_t, T *, int, uint32_t, T *, int, void *);
+	// runs a job for every index in [0, count) and returns once they are all done
+	typedef void (*ParallelJob)(void *, uint32_t);
+	typedef void (*ParallelForCallback)(void *, ParallelJob, void *, uint32_t);
 
 	// allow locally toggling thread safety if the template has been compiled with BVH_THREAD_SAFE
 	void params_set_thread_safe(bool p_enable) {
@@ -103,6 +109,13 @@ public:
 		check_pair_callback = p_callback;
 		check_pair_callback_userdata = p_userdata;
 	}
+	// allow finding the pairs of the changed items on other threads during update.
+	// pair and unpair callbacks are always sent from the calling thread, in the same order as without it
+	void set_parallel_for_callback(ParallelForCallback p_callback, void *p_userdata) {
+		BVH_LOCKED_FUNCTION
+		parallel_for_callback = p_callback;
+		parallel_for_callback_userdata = p_userdata;
+	}
 
 	BVHHandle create(T *p_userdata, bool p_active = true, uint32_t p_tree_id = 0, uint32_t p_tree_collision_mask = 1, const BOUNDS &p_aabb = BOUNDS(), int p_subindex = 0) {
 		BVH_LOCKED_FUNCTION
@@ -435,6 +448,11 @@ private:
 			return;
 		}
 
+		if (parallel_for_callback && !p_full_check && changed_items.size() >= BVH_PARALLEL_PAIRING_MIN_ITEMS) {
+			_check_for_collisions_parallel();
+			return;
+		}
+
 		BOUNDS bb;
 
 		typename BVHTREE_CLASS::CullParams params;
@@ -480,6 +498,66 @@ private:
 		_reset();
 	}
 
+	// culling only reads the tree, so it is done for all changed items with the parallel for callback,
+	// each item writing to its own hit list. the pairs are then updated on this thread
+	// by walking the hit lists in the changed items order, so the results are deterministic.
+	void _check_for_collisions_parallel() {
+		uint32_t changed_count = changed_items.size();
+		if (_pairing_hits.size() < changed_count) {
+			_pairing_hits.resize(changed_count);
+		}
+
+		parallel_for_callback(parallel_for_callback_userdata, &BVH_Manager::_find_enterers, this, changed_count);
+
+		for (uint32_t n = 0; n < changed_count; n++) {
+			const BVHHandle &h = changed_items[n];
+
+			BVHABB_CLASS abb;
+			abb.from(tree._pairs[h.id()].expanded_aabb);
+
+			// find all the existing paired aabbs that are no longer
+			// paired, and send callbacks
+			_find_leavers(h, abb, false);
+
+			uint32_t changed_item_ref_id = h.id();
+
+			for (const uint32_t ref_id : _pairing_hits[n]) {
+				// don't collide against ourself
+				if (ref_id == changed_item_ref_id) {
+					continue;
+				}
+
+				BVHHandle h_collidee;
+				h_collidee.set_id(ref_id);
+
+				// find NEW enterers, and send callbacks for them only
+				_collide(h, h_collidee);
+			}
+		}
+		_reset();
+	}
+
+	static void _find_enterers(void *p_self, uint32_t p_index) {
+		BVH_Manager *self = static_cast<BVH_Manager *>(p_self);
+		const BVHHandle &h = self->changed_items[p_index];
+		LocalVector<uint32_t, uint32_t, true> &hits = self->_pairing_hits[p_index];
+		hits.clear();
+
+		typename BVHTREE_CLASS::CullParams params;
+
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+
+		self->tree.item_fill_cullparams(h, params);
+
+		// use the expanded aabb for pairing
+		params.abb.from(self->tree._pairs[h.id()].expanded_aabb);
+
+		self->tree.cull_aabb_hits(params, hits);
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, BOUNDS &r_aabb) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -765,6 +843,8 @@ private:
 	void *pair_callback_userdata = nullptr;
 	void *unpair_callback_userdata = nullptr;
 	void *check_pair_callback_userdata = nullptr;
+	ParallelForCallback parallel_for_callback = nullptr;
+	void *parallel_for_callback_userdata = nullptr;
 
 	BVHTREE_CLASS tree;
 
@@ -773,6 +853,9 @@ private:
 	LocalVector<BVHHandle, uint32_t, true> changed_items;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
+	// one list of cull hits per changed item, kept between updates to avoid reallocations
+	LocalVector<LocalVector<uint32_t, uint32_t, true>> _pairing_hits;
+
 	class BVHLockedFunction {
 	public:
 		BVHLockedFunction(Mutex *p_mutex, bool p_thread_safe) {
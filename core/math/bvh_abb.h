@@ -31,6 +31,8 @@
 #ifndef BVH_ABB_H
 #define BVH_ABB_H
 
+#include "core/math/bvh_simd.h"
+
 // special optimized version of axis aligned bounding box
 template <class BOUNDS = AABB, class POINT = Vector3>
 struct BVH_ABB {
@@ -225,6 +227,11 @@ struct BVH_ABB {
 
 	// for pre-swizzled tester (this object)
 	bool intersects_swizzled(const BVH_ABB &p_o) const {
+#ifdef BVH_SIMD_ENABLED
+		if constexpr (_is_simd_layout()) {
+			return _all_greater_equal(*this, p_o);
+		}
+#endif
 		if (_any_lessthan(min, p_o.min)) {
 			return false;
 		}
@@ -235,6 +242,11 @@ struct BVH_ABB {
 	}
 
 	bool is_other_within(const BVH_ABB &p_o) const {
+#ifdef BVH_SIMD_ENABLED
+		if constexpr (_is_simd_layout()) {
+			return _all_greater_equal(p_o, *this);
+		}
+#endif
 		if (_any_lessthan(p_o.neg_max, neg_max)) {
 			return false;
 		}
@@ -279,6 +291,25 @@ struct BVH_ABB {
 		return false;
 	}
 
+#ifdef BVH_SIMD_ENABLED
+	// min and neg_max are stored contiguously, so a whole box can be compared against another
+	// with a single SIMD comparison per 4 floats
+	static constexpr bool _is_simd_layout() {
+		return sizeof(POINT) == POINT::AXIS_COUNT * sizeof(float) && (POINT::AXIS_COUNT == 2 || POINT::AXIS_COUNT == 3);
+	}
+
+	// true if no member of p_a is less than the matching member of p_b
+	static bool _all_greater_equal(const BVH_ABB &p_a, const BVH_ABB &p_b) {
+		const float *a = reinterpret_cast<const float *>(&p_a);
+		const float *b = reinterpret_cast<const float *>(&p_b);
+		if constexpr (POINT::AXIS_COUNT == 2) {
+			return BVHSIMD::all_greater_equal4(a, b);
+		} else {
+			return BVHSIMD::all_greater_equal6(a, b);
+		}
+	}
+#endif
+
 	bool _any_lessthan(const POINT &p_a, const POINT &p_b) const {
 		for (int axis = 0; axis < POINT::AXIS_COUNT; ++axis) {
 			if (p_a[axis] < p_b[axis]) {
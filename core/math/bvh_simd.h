@@ -0,0 +1,216 @@
+/**************************************************************************/
+/*  bvh_simd.h                                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BVH_SIMD_H
+#define BVH_SIMD_H
+
+#include "core/math/plane.h"
+#include "core/math/vector3.h"
+
+// SIMD kernels for the bounding volume tests used when traversing BVH_Tree and DynamicBVH.
+// Only single precision builds are accelerated, using SSE2 on x86 and NEON on ARM64.
+// The occlusion culling rasterizer also uses the lane helpers for its inner loop.
+// When BVH_SIMD_ENABLED is not defined, the callers fall back to their scalar tests.
+
+#if !defined(REAL_T_IS_DOUBLE) && !defined(BVH_SIMD_DISABLED)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BVH_SIMD_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define BVH_SIMD_NEON
+#endif
+#endif
+
+#if defined(BVH_SIMD_SSE2) || defined(BVH_SIMD_NEON)
+#define BVH_SIMD_ENABLED
+
+class BVHSIMD {
+public:
+#ifdef BVH_SIMD_SSE2
+	typedef __m128 Float4;
+	typedef __m128 Mask4;
+
+	static _FORCE_INLINE_ Float4 load(const float *p_src) { return _mm_loadu_ps(p_src); }
+	static _FORCE_INLINE_ void store(float *p_dst, Float4 p_a) { _mm_storeu_ps(p_dst, p_a); }
+	static _FORCE_INLINE_ Float4 splat(float p_value) { return _mm_set1_ps(p_value); }
+	static _FORCE_INLINE_ Float4 add(Float4 p_a, Float4 p_b) { return _mm_add_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Float4 sub(Float4 p_a, Float4 p_b) { return _mm_sub_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Float4 mul(Float4 p_a, Float4 p_b) { return _mm_mul_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Float4 div(Float4 p_a, Float4 p_b) { return _mm_div_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Float4 min(Float4 p_a, Float4 p_b) { return _mm_min_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Float4 max(Float4 p_a, Float4 p_b) { return _mm_max_ps(p_a, p_b); }
+	// Lanes 1, 2 and 3 are moved to lanes 0, 1 and 2.
+	static _FORCE_INLINE_ Float4 shift_down(Float4 p_a) { return _mm_shuffle_ps(p_a, p_a, _MM_SHUFFLE(0, 3, 2, 1)); }
+	static _FORCE_INLINE_ Mask4 less(Float4 p_a, Float4 p_b) { return _mm_cmplt_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Mask4 mask_or(Mask4 p_a, Mask4 p_b) { return _mm_or_ps(p_a, p_b); }
+	// Takes the lanes of p_a where the mask is set, and those of p_b elsewhere.
+	static _FORCE_INLINE_ Float4 select(Mask4 p_mask, Float4 p_a, Float4 p_b) { return _mm_or_ps(_mm_and_ps(p_mask, p_a), _mm_andnot_ps(p_mask, p_b)); }
+	// Bit n is set when lane n of the mask is set.
+	static _FORCE_INLINE_ int mask_bits(Mask4 p_mask) { return _mm_movemask_ps(p_mask); }
+#else
+	typedef float32x4_t Float4;
+	typedef uint32x4_t Mask4;
+
+	static _FORCE_INLINE_ Float4 load(const float *p_src) { return vld1q_f32(p_src); }
+	static _FORCE_INLINE_ void store(float *p_dst, Float4 p_a) { vst1q_f32(p_dst, p_a); }
+	static _FORCE_INLINE_ Float4 splat(float p_value) { return vdupq_n_f32(p_value); }
+	static _FORCE_INLINE_ Float4 add(Float4 p_a, Float4 p_b) { return vaddq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Float4 sub(Float4 p_a, Float4 p_b) { return vsubq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Float4 mul(Float4 p_a, Float4 p_b) { return vmulq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Float4 div(Float4 p_a, Float4 p_b) { return vdivq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Float4 min(Float4 p_a, Float4 p_b) { return vminq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Float4 max(Float4 p_a, Float4 p_b) { return vmaxq_f32(p_a, p_b); }
+	// Lanes 1, 2 and 3 are moved to lanes 0, 1 and 2.
+	static _FORCE_INLINE_ Float4 shift_down(Float4 p_a) { return vextq_f32(p_a, p_a, 1); }
+	static _FORCE_INLINE_ Mask4 less(Float4 p_a, Float4 p_b) { return vcltq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Mask4 mask_or(Mask4 p_a, Mask4 p_b) { return vorrq_u32(p_a, p_b); }
+	// Takes the lanes of p_a where the mask is set, and those of p_b elsewhere.
+	static _FORCE_INLINE_ Float4 select(Mask4 p_mask, Float4 p_a, Float4 p_b) { return vbslq_f32(p_mask, p_a, p_b); }
+	// Bit n is set when lane n of the mask is set.
+	static _FORCE_INLINE_ int mask_bits(Mask4 p_mask) {
+		const uint32_t lane_bits[4] = { 1, 2, 4, 8 };
+		return (int)vaddvq_u32(vandq_u32(p_mask, vld1q_u32(lane_bits)));
+	}
+#endif
+
+	// Planes transposed in groups of 4, to test a box against 4 planes at once.
+	struct PlaneGroup {
+		float normal_x[4];
+		float normal_y[4];
+		float normal_z[4];
+		float abs_normal_x[4];
+		float abs_normal_y[4];
+		float abs_normal_z[4];
+		float d[4];
+	};
+
+	// Returns true if none of the 4 floats of p_a is less than the matching float of p_b.
+	static _FORCE_INLINE_ bool all_greater_equal4(const float *p_a, const float *p_b) {
+		return mask_bits(less(load(p_a), load(p_b))) == 0;
+	}
+
+	// Same as all_greater_equal4, for 6 floats. Both loads stay within the 6 floats, the middle ones are tested twice.
+	static _FORCE_INLINE_ bool all_greater_equal6(const float *p_a, const float *p_b) {
+		return mask_bits(mask_or(less(load(p_a), load(p_b)), less(load(p_a + 2), load(p_b + 2)))) == 0;
+	}
+
+	// Loads a 3D box stored as min followed by max, lane 3 of the results is undefined.
+	static _FORCE_INLINE_ void load_min_max(const float *p_box, Float4 &r_min, Float4 &r_max) {
+		r_min = load(p_box);
+		r_max = shift_down(load(p_box + 2));
+	}
+
+	static _FORCE_INLINE_ bool min_max_intersects(const float *p_box, Float4 p_min, Float4 p_max) {
+		Float4 box_min;
+		Float4 box_max;
+		load_min_max(p_box, box_min, box_max);
+		return (mask_bits(mask_or(less(p_max, box_min), less(box_max, p_min))) & 0x7) == 0;
+	}
+
+	// Slab test against a box stored as min followed by max.
+	static _FORCE_INLINE_ bool min_max_intersects_ray(const float *p_box, Float4 p_from, Float4 p_inv_dir, float p_lambda_min, float p_lambda_max) {
+		Float4 box_min;
+		Float4 box_max;
+		load_min_max(p_box, box_min, box_max);
+
+		Float4 t0 = mul(sub(box_min, p_from), p_inv_dir);
+		Float4 t1 = mul(sub(box_max, p_from), p_inv_dir);
+
+		float t_near[4];
+		float t_far[4];
+		store(t_near, min(t0, t1));
+		store(t_far, max(t0, t1));
+
+		float tmin = MAX(MAX(t_near[0], t_near[1]), t_near[2]);
+		float tmax = MIN(MIN(t_far[0], t_far[1]), t_far[2]);
+		return tmin <= tmax && tmin < p_lambda_max && tmax > p_lambda_min;
+	}
+
+	static _FORCE_INLINE_ int get_plane_group_count(int p_plane_count) {
+		return (p_plane_count + 3) / 4;
+	}
+
+	// r_groups must have room for get_plane_group_count(p_plane_count) groups.
+	// Unused lanes are filled with planes that never reject anything.
+	static void make_plane_groups(const Plane *p_planes, int p_plane_count, PlaneGroup *r_groups) {
+		int group_count = get_plane_group_count(p_plane_count);
+		for (int i = 0; i < group_count * 4; i++) {
+			PlaneGroup &group = r_groups[i / 4];
+			int lane = i % 4;
+			if (i < p_plane_count) {
+				const Plane &p = p_planes[i];
+				group.normal_x[lane] = p.normal.x;
+				group.normal_y[lane] = p.normal.y;
+				group.normal_z[lane] = p.normal.z;
+				group.abs_normal_x[lane] = Math::abs(p.normal.x);
+				group.abs_normal_y[lane] = Math::abs(p.normal.y);
+				group.abs_normal_z[lane] = Math::abs(p.normal.z);
+				group.d[lane] = p.d;
+			} else {
+				group.normal_x[lane] = 0;
+				group.normal_y[lane] = 0;
+				group.normal_z[lane] = 0;
+				group.abs_normal_x[lane] = 0;
+				group.abs_normal_y[lane] = 0;
+				group.abs_normal_z[lane] = 0;
+				group.d[lane] = FLT_MAX;
+			}
+		}
+	}
+
+	// Returns false if the box is entirely over one of the planes.
+	// The corner nearest to each plane is at center - sign(normal) * half_extents, so its distance
+	// is dot(normal, center) - dot(abs(normal), half_extents) - d.
+	static _FORCE_INLINE_ bool box_inside_plane_groups(const Vector3 &p_center, const Vector3 &p_half_extents, const PlaneGroup *p_groups, int p_group_count) {
+		Float4 center_x = splat(p_center.x);
+		Float4 center_y = splat(p_center.y);
+		Float4 center_z = splat(p_center.z);
+		Float4 extent_x = splat(p_half_extents.x);
+		Float4 extent_y = splat(p_half_extents.y);
+		Float4 extent_z = splat(p_half_extents.z);
+		Float4 zero = splat(0.0f);
+
+		for (int i = 0; i < p_group_count; i++) {
+			const PlaneGroup &group = p_groups[i];
+			Float4 center_dist = add(add(mul(load(group.normal_x), center_x), mul(load(group.normal_y), center_y)), mul(load(group.normal_z), center_z));
+			Float4 extent_dist = add(add(mul(load(group.abs_normal_x), extent_x), mul(load(group.abs_normal_y), extent_y)), mul(load(group.abs_normal_z), extent_z));
+			Float4 dist = sub(sub(center_dist, extent_dist), load(group.d));
+			if (mask_bits(less(zero, dist))) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+#endif // BVH_SIMD_ENABLED
+
+#endif // BVH_SIMD_H
@@ -32,6 +32,7 @@
 #define DYNAMIC_BVH_H
 
 #include "core/math/aabb.h"
+#include "core/math/bvh_simd.h"
 #include "core/templates/list.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
@@ -151,6 +152,23 @@ private:
 				}
 			}
 
+			return _intersects_points(ofs, half_extents, p_points, p_point_count);
+		}
+
+#ifdef BVH_SIMD_ENABLED
+		_FORCE_INLINE_ bool intersects_convex_points(const BVHSIMD::PlaneGroup *p_plane_groups, int p_plane_group_count, const Vector3 *p_points, int p_point_count) const {
+			Vector3 half_extents = (max - min) * 0.5;
+			Vector3 ofs = min + half_extents;
+
+			if (!BVHSIMD::box_inside_plane_groups(ofs, half_extents, p_plane_groups, p_plane_group_count)) {
+				return false;
+			}
+
+			return _intersects_points(ofs, half_extents, p_points, p_point_count);
+		}
+#endif
+
+		_FORCE_INLINE_ bool _intersects_points(const Vector3 &p_ofs, const Vector3 &p_half_extents, const Vector3 *p_points, int p_point_count) const {
 			// Make sure all points in the shape aren't fully separated from the AABB on
 			// each axis.
 			int bad_point_counts_positive[3] = { 0 };
@@ -158,10 +176,10 @@ private:
 
 			for (int k = 0; k < 3; k++) {
 				for (int i = 0; i < p_point_count; i++) {
-					if (p_points[i].coord[k] > ofs.coord[k] + half_extents.coord[k]) {
+					if (p_points[i].coord[k] > p_ofs.coord[k] + p_half_extents.coord[k]) {
 						bad_point_counts_positive[k]++;
 					}
-					if (p_points[i].coord[k] < ofs.coord[k] - half_extents.coord[k]) {
+					if (p_points[i].coord[k] < p_ofs.coord[k] - p_half_extents.coord[k]) {
 						bad_point_counts_negative[k]++;
 					}
 				}
@@ -328,6 +346,12 @@ void DynamicBVH::aabb_query(const AABB &p_box, QueryResult &r_result) {
 	volume.min = p_box.position;
 	volume.max = p_box.position + p_box.size;
 
+#ifdef BVH_SIMD_ENABLED
+	BVHSIMD::Float4 volume_min;
+	BVHSIMD::Float4 volume_max;
+	BVHSIMD::load_min_max(&volume.min.x, volume_min, volume_max);
+#endif
+
 	const Node **stack = (const Node **)alloca(ALLOCA_STACK_SIZE * sizeof(const Node *));
 	stack[0] = bvh_root;
 	int32_t depth = 1;
@@ -338,7 +362,11 @@ void DynamicBVH::aabb_query(const AABB &p_box, QueryResult &r_result) {
 	do {
 		depth--;
 		const Node *n = stack[depth];
+#ifdef BVH_SIMD_ENABLED
+		if (BVHSIMD::min_max_intersects(&n->volume.min.x, volume_min, volume_max)) {
+#else
 		if (n->volume.intersects(volume)) {
+#endif
 			if (n->is_internal()) {
 				if (depth > threshold) {
 					if (aux_stack.is_empty()) {
@@ -384,6 +412,17 @@ void DynamicBVH::convex_query(const Plane *p_planes, int p_plane_count, const Ve
 		}
 	}
 
+#ifdef BVH_SIMD_ENABLED
+	BVHSIMD::Float4 volume_min;
+	BVHSIMD::Float4 volume_max;
+	BVHSIMD::load_min_max(&volume.min.x, volume_min, volume_max);
+
+	// The planes are transposed once, so each node is tested against 4 of them at a time.
+	int plane_group_count = BVHSIMD::get_plane_group_count(p_plane_count);
+	BVHSIMD::PlaneGroup *plane_groups = (BVHSIMD::PlaneGroup *)alloca(MAX(plane_group_count, 1) * sizeof(BVHSIMD::PlaneGroup));
+	BVHSIMD::make_plane_groups(p_planes, p_plane_count, plane_groups);
+#endif
+
 	const Node **stack = (const Node **)alloca(ALLOCA_STACK_SIZE * sizeof(const Node *));
 	stack[0] = bvh_root;
 	int32_t depth = 1;
@@ -394,7 +433,11 @@ void DynamicBVH::convex_query(const Plane *p_planes, int p_plane_count, const Ve
 	do {
 		depth--;
 		const Node *n = stack[depth];
+#ifdef BVH_SIMD_ENABLED
+		if (BVHSIMD::min_max_intersects(&n->volume.min.x, volume_min, volume_max) && n->volume.intersects_convex_points(plane_groups, plane_group_count, p_points, p_point_count)) {
+#else
 		if (n->volume.intersects(volume) && n->volume.intersects_convex(p_planes, p_plane_count, p_points, p_point_count)) {
+#endif
 			if (n->is_internal()) {
 				if (depth > threshold) {
 					if (aux_stack.is_empty()) {
@@ -430,11 +473,17 @@ void DynamicBVH::ray_query(const Vector3 &p_from, const Vector3 &p_to, QueryResu
 	inv_dir[0] = ray_dir[0] == real_t(0.0) ? real_t(1e20) : real_t(1.0) / ray_dir[0];
 	inv_dir[1] = ray_dir[1] == real_t(0.0) ? real_t(1e20) : real_t(1.0) / ray_dir[1];
 	inv_dir[2] = ray_dir[2] == real_t(0.0) ? real_t(1e20) : real_t(1.0) / ray_dir[2];
-	unsigned int signs[3] = { inv_dir[0] < 0.0, inv_dir[1] < 0.0, inv_dir[2] < 0.0 };
-
 	real_t lambda_max = ray_dir.dot(p_to - p_from);
 
+#ifdef BVH_SIMD_ENABLED
+	const float from_lanes[4] = { p_from.x, p_from.y, p_from.z, 0.0f };
+	const float inv_dir_lanes[4] = { inv_dir.x, inv_dir.y, inv_dir.z, 0.0f };
+	BVHSIMD::Float4 from = BVHSIMD::load(from_lanes);
+	BVHSIMD::Float4 inv_dir_simd = BVHSIMD::load(inv_dir_lanes);
+#else
+	unsigned int signs[3] = { inv_dir[0] < 0.0, inv_dir[1] < 0.0, inv_dir[2] < 0.0 };
 	Vector3 bounds[2];
+#endif
 
 	const Node **stack = (const Node **)alloca(ALLOCA_STACK_SIZE * sizeof(const Node *));
 	stack[0] = bvh_root;
@@ -446,12 +495,16 @@ void DynamicBVH::ray_query(const Vector3 &p_from, const Vector3 &p_to, QueryResu
 	do {
 		depth--;
 		const Node *node = stack[depth];
+#ifdef BVH_SIMD_ENABLED
+		if (BVHSIMD::min_max_intersects_ray(&node->volume.min.x, from, inv_dir_simd, 0.f, lambda_max)) {
+#else
 		bounds[0] = node->volume.min;
 		bounds[1] = node->volume.max;
 		real_t tmin = 1.f, lambda_min = 0.f;
 		unsigned int result1 = false;
 		result1 = _ray_aabb(p_from, inv_dir, signs, bounds, tmin, lambda_min, lambda_max);
 		if (result1) {
+#endif
 			if (node->is_internal()) {
 				if (depth > threshold) {
 					if (aux_stack.is_empty()) {
@@ -30,6 +30,7 @@
 
 #include "worker_thread_pool.h"
 
+#include "core/debugger/engine_trace.h"
 #include "core/os/os.h"
 
 void WorkerThreadPool::Task::free_template_userdata() {
@@ -41,6 +42,8 @@ void WorkerThreadPool::Task::free_template_userdata() {
 
 WorkerThreadPool *WorkerThreadPool::singleton = nullptr;
 
+thread_local WorkerThreadPool::ThreadData *WorkerThreadPool::current_thread_data = nullptr;
+
 void WorkerThreadPool::_process_task_queue() {
 	task_mutex.lock();
 	Task *task = task_queue.first()->self();
@@ -50,6 +53,8 @@ void WorkerThreadPool::_process_task_queue() {
 }
 
 void WorkerThreadPool::_process_task(Task *p_task) {
+	// Tasks of a group share its description.
+	TRACE_SCOPE_DYNAMIC(p_task->description, "WorkerThreadPool::task");
 	bool low_priority = p_task->low_priority;
 
 	if (p_task->group) {
@@ -87,6 +92,11 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			memdelete(p_task->template_userdata); // This is no longer needed at this point, so get rid of it.
 		}
 
+		if (do_post) {
+			// Must happen before posting completion, as the group may be freed right after.
+			_release_dependents(p_task->group->dependents);
+		}
+
 		if (low_priority && use_native_low_priority_threads) {
 			p_task->completed = true;
 			p_task->done_semaphore.post();
@@ -126,6 +136,8 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			p_task->callable.callp(nullptr, 0, ret, ce);
 		}
 
+		_release_dependents(p_task->dependents);
+
 		p_task->completed = true;
 		p_task->done_semaphore.post();
 	}
@@ -133,52 +145,208 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	if (!use_native_low_priority_threads && low_priority) {
 		// A low prioriry task was freed, so see if we can move a pending one to the high priority queue.
 		bool post = false;
+		Task *low_prio_task = nullptr;
 		task_mutex.lock();
 		if (low_priority_task_queue.first()) {
-			Task *low_prio_task = low_priority_task_queue.first()->self();
+			low_prio_task = low_priority_task_queue.first()->self();
 			low_priority_task_queue.remove(low_priority_task_queue.first());
-			task_queue.add_last(&low_prio_task->task_elem);
+			if (!use_work_stealing) {
+				task_queue.add_last(&low_prio_task->task_elem);
+			}
 			post = true;
 		} else {
 			low_priority_threads_used.decrement();
 		}
-		task_mutex.lock();
+		task_mutex.unlock();
 		if (post) {
-			task_available_semaphore.post();
+			if (use_work_stealing) {
+				_work_stealing_push_task(low_prio_task);
+			} else {
+				task_available_semaphore.post();
+			}
+		}
+	}
+
+	if (use_work_stealing) {
+		// A thread blocked in _work_stealing_wait() may be waiting for this task.
+		_work_stealing_wake_waiters(true);
+	}
+}
+
+void WorkerThreadPool::_work_stealing_loop(ThreadData *p_thread_data) {
+	while (!exit_threads.is_set()) {
+		Task *task = _work_stealing_find_task(p_thread_data);
+		if (!task) {
+			// Announce we are about to sleep, then look once more, so a task pushed meanwhile is not missed.
+			sleeping_threads.increment();
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			task = _work_stealing_find_task(p_thread_data);
+			if (!task && !exit_threads.is_set()) {
+				task_available_semaphore.wait();
+			}
+			sleeping_threads.decrement();
+		}
+		if (task) {
+			_process_task(task);
+		}
+	}
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_work_stealing_find_task(ThreadData *p_thread_data) {
+	Task *task = nullptr;
+
+	// Own queue first, newest task first, as it is the most likely to be hot in cache.
+	if (p_thread_data && p_thread_data->work_queue.pop(task)) {
+		return task;
+	}
+
+	// Then tasks posted from outside the pool.
+	if (task_queue_size.get() > 0) {
+		task_mutex.lock();
+		if (task_queue.first()) {
+			task = task_queue.first()->self();
+			task_queue.remove(task_queue.first());
+			task_queue_size.decrement();
+		}
+		task_mutex.unlock();
+		if (task) {
+			return task;
+		}
+	}
+
+	// Finally, steal the oldest task of a peer. Start after ourselves so thieves spread over victims.
+	uint32_t thread_count = threads.size();
+	uint32_t from = p_thread_data ? p_thread_data->index + 1 : 0;
+	for (uint32_t i = 0; i < thread_count; i++) {
+		ThreadData &victim = threads[(from + i) % thread_count];
+		if (&victim != p_thread_data && victim.work_queue.steal(task)) {
+			return task;
+		}
+	}
+
+	return nullptr;
+}
+
+void WorkerThreadPool::_work_stealing_push_task(Task *p_task) {
+	ThreadData *thread_data = _get_current_thread_data();
+	if (thread_data) {
+		// Posted from inside a task, keep it local.
+		thread_data->work_queue.push(p_task);
+	} else {
+		task_mutex.lock();
+		task_queue.add_last(&p_task->task_elem);
+		task_queue_size.increment();
+		task_mutex.unlock();
+	}
+
+	// Pairs with the fence in _work_stealing_loop(), either the sleeping thread sees the task or we see it sleeping.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (sleeping_threads.get() > 0) {
+		task_available_semaphore.post();
+	} else {
+		// Nobody is free to take it, the task waited for by a blocked thread may need it.
+		_work_stealing_wake_waiters(false);
+	}
+}
+
+void WorkerThreadPool::_work_stealing_wake_waiters(bool p_all) {
+	// Pairs with the fence in _work_stealing_wait(), either the blocking thread sees the change or we see it blocked.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (blocked_waiters.get() == 0) {
+		return;
+	}
+	for (ThreadData &thread_data : threads) {
+		if (thread_data.blocked.exchange(false)) {
+			thread_data.wake_semaphore.post();
+			if (!p_all) {
+				return;
+			}
+		}
+	}
+}
+
+void WorkerThreadPool::_work_stealing_wait(Semaphore &p_done_semaphore, ThreadData *p_thread_data) {
+	// Keep processing tasks (probably the ones being waited for) while waiting. Once there has been nothing to do for a while, block
+	// until a task completes or new work arrives, as the task waited for may depend on work no other thread is free to take.
+	uint32_t idle_spins = 0;
+	while (!p_done_semaphore.try_wait()) {
+		Task *task = _work_stealing_find_task(p_thread_data);
+		if (!task && ++idle_spins >= WORK_STEALING_WAIT_SPINS) {
+			// Announce we are about to block, then look once more, so a completion or a task pushed meanwhile is not missed.
+			p_thread_data->blocked.store(true);
+			blocked_waiters.increment();
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const bool done = p_done_semaphore.try_wait();
+			if (!done) {
+				task = _work_stealing_find_task(p_thread_data);
+			}
+			if (!done && !task) {
+				p_thread_data->wake_semaphore.wait();
+			} else if (!p_thread_data->blocked.exchange(false)) {
+				// Woken meanwhile, consume the post so blocking next time doesn't return right away.
+				p_thread_data->wake_semaphore.wait();
+			}
+			blocked_waiters.decrement();
+			if (done) {
+				return;
+			}
+			idle_spins = 0;
+		}
+		if (task) {
+			_process_task(task);
+			idle_spins = 0;
 		}
 	}
 }
 
 void WorkerThreadPool::_thread_function(void *p_user) {
+	current_thread_data = (ThreadData *)p_user;
+	WorkerThreadPool *pool = current_thread_data->pool;
+	if (pool->use_work_stealing) {
+		pool->_work_stealing_loop(current_thread_data);
+		return;
+	}
+
 	while (true) {
-		singleton->task_available_semaphore.wait();
-		if (singleton->exit_threads.is_set()) {
+		pool->task_available_semaphore.wait();
+		if (pool->exit_threads.is_set()) {
 			break;
 		}
-		singleton->_process_task_queue();
+		pool->_process_task_queue();
 	}
 }
 
 void WorkerThreadPool::_native_low_priority_thread_function(void *p_user) {
 	Task *task = (Task *)p_user;
-	singleton->_process_task(task);
+	task->pool->_process_task(task);
 }
 
 void WorkerThreadPool::_post_task(Task *p_task, bool p_high_priority) {
-	task_mutex.lock();
 	p_task->low_priority = !p_high_priority;
+	if (p_high_priority && use_work_stealing) {
+		_work_stealing_push_task(p_task);
+		return;
+	}
+
+	task_mutex.lock();
 	if (!p_high_priority && use_native_low_priority_threads) {
-		task_mutex.unlock();
 		p_task->low_priority_thread = native_thread_allocator.alloc();
+		p_task->pool = this;
+		task_mutex.unlock();
 		p_task->low_priority_thread->start(_native_low_priority_thread_function, p_task); // Pask task directly to thread.
 
 	} else if (p_high_priority || low_priority_threads_used.get() < max_low_priority_threads) {
-		task_queue.add_last(&p_task->task_elem);
 		if (!p_high_priority) {
 			low_priority_threads_used.increment();
 		}
-		task_mutex.unlock();
-		task_available_semaphore.post();
+		if (use_work_stealing) {
+			task_mutex.unlock();
+			_work_stealing_push_task(p_task);
+		} else {
+			task_queue.add_last(&p_task->task_elem);
+			task_mutex.unlock();
+			task_available_semaphore.post();
+		}
 	} else {
 		// Too many threads using low priority, must go to queue.
 		low_priority_task_queue.add_last(&p_task->task_elem);
@@ -186,11 +354,87 @@ void WorkerThreadPool::_post_task(Task *p_task, bool p_high_priority) {
 	}
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
-	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
+void WorkerThreadPool::_post_group_tasks(Group *p_group) {
+	TightLocalVector<Task *> tasks_posted = p_group->deferred_tasks;
+	p_group->deferred_tasks.clear();
+	for (Task *task : tasks_posted) {
+		_post_task(task, p_group->high_priority);
+	}
+}
+
+void WorkerThreadPool::_complete_empty_group(Group *p_group) {
+	// Should really not call it with zero Elements, but at least it should work.
+	_release_dependents(p_group->dependents);
+	p_group->completed.set_to(true);
+	p_group->done_semaphore.post();
+	if (use_work_stealing) {
+		_work_stealing_wake_waiters(true);
+	}
+}
+
+uint32_t WorkerThreadPool::_add_dependencies(const Vector<TaskID> &p_dependencies, Task *p_task, Group *p_group) {
+	// Must be called with task_mutex locked. Returns how many dependencies are still pending.
+	uint32_t pending = 0;
+	for (const TaskID &id : p_dependencies) {
+		Dependents *dependents = nullptr;
+		if (Task **taskp = tasks.getptr(id)) {
+			dependents = &(*taskp)->dependents;
+		} else if (Group **groupp = groups.getptr(id)) {
+			dependents = &(*groupp)->dependents;
+		} else {
+			continue; // Already completed and waited for (or invalid), nothing to wait for.
+		}
+
+		dependents->lock.lock();
+		if (!dependents->released) {
+			if (p_task) {
+				dependents->tasks.push_back(p_task);
+			} else {
+				dependents->groups.push_back(p_group);
+			}
+			pending++;
+		}
+		dependents->lock.unlock();
+	}
+	return pending;
+}
+
+void WorkerThreadPool::_release_dependents(Dependents &p_dependents) {
+	p_dependents.lock.lock();
+	p_dependents.released = true;
+	TightLocalVector<Task *> dependent_tasks = p_dependents.tasks;
+	TightLocalVector<Group *> dependent_groups = p_dependents.groups;
+	p_dependents.lock.unlock();
+
+	for (Task *task : dependent_tasks) {
+		_dependency_completed(task);
+	}
+	for (Group *group : dependent_groups) {
+		_dependency_completed(group);
+	}
+}
+
+void WorkerThreadPool::_dependency_completed(Task *p_task) {
+	if (p_task->pending_dependencies.decrement() == 0) {
+		_post_task(p_task, p_task->high_priority);
+	}
+}
+
+void WorkerThreadPool::_dependency_completed(Group *p_group) {
+	if (p_group->pending_dependencies.decrement() == 0) {
+		if (p_group->max == 0) {
+			_complete_empty_group(p_group);
+		} else {
+			_post_group_tasks(p_group);
+		}
+	}
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, p_dependencies);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
 	task_mutex.lock();
 	// Get a free task
 	Task *task = task_allocator.alloc();
@@ -200,16 +444,21 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task->native_func_userdata = p_userdata;
 	task->description = p_description;
 	task->template_userdata = p_template_userdata;
+	task->high_priority = p_high_priority;
+	task->low_priority = !p_high_priority;
+	// Hold one extra reference while registering, so the task is not posted by a dependency completing meanwhile.
+	task->pending_dependencies.set(1);
+	task->pending_dependencies.add(_add_dependencies(p_dependencies, task, nullptr));
 	tasks.insert(id, task);
 	task_mutex.unlock();
 
-	_post_task(task, p_high_priority);
+	_dependency_completed(task);
 
 	return id;
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::add_task(const Callable &p_action, bool p_high_priority, const String &p_description) {
-	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description);
+WorkerThreadPool::TaskID WorkerThreadPool::add_task(const Callable &p_action, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, p_dependencies);
 }
 
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
@@ -246,28 +495,40 @@ void WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 	}
 
 	task->waiting = true;
+	// Completion is flagged right before posting, so there is nothing else worth processing meanwhile.
+	bool already_completed = task->completed;
 
 	task_mutex.unlock();
 
-	if (use_native_low_priority_threads && task->low_priority) {
+	if (already_completed && !(use_native_low_priority_threads && task->low_priority)) {
+		task->done_semaphore.wait();
+	} else if (use_native_low_priority_threads && task->low_priority) {
+		// The thread may not exist yet if the task is waiting for dependencies, so wait for completion before joining it.
+		task->done_semaphore.wait();
 		task->low_priority_thread->wait_to_finish();
+		task_mutex.lock();
 		native_thread_allocator.free(task->low_priority_thread);
+		task_mutex.unlock();
 	} else {
 		int *index = thread_ids.getptr(Thread::get_caller_id());
 
 		if (index) {
 			// We are an actual process thread, we must not be blocked so continue processing stuff if available.
-			while (true) {
-				if (task->done_semaphore.try_wait()) {
-					// If done, exit
-					break;
-				}
-				if (task_available_semaphore.try_wait()) {
-					// Solve tasks while they are around.
-					_process_task_queue();
-					continue;
+			if (use_work_stealing) {
+				_work_stealing_wait(task->done_semaphore, _get_current_thread_data());
+			} else {
+				while (true) {
+					if (task->done_semaphore.try_wait()) {
+						// If done, exit
+						break;
+					}
+					if (task_available_semaphore.try_wait()) {
+						// Solve tasks while they are around.
+						_process_task_queue();
+						continue;
+					}
+					OS::get_singleton()->delay_usec(1); // Microsleep, this could be converted to waiting for multiple objects in supported platforms for a bit more performance.
 				}
-				OS::get_singleton()->delay_usec(1); // Microsleep, this could be converted to waiting for multiple objects in supported platforms for a bit more performance.
 			}
 		} else {
 			task->done_semaphore.wait();
@@ -280,7 +541,7 @@ void WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 	task_mutex.unlock();
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
 		p_tasks = threads.size();
@@ -291,21 +552,20 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	GroupID id = last_task++;
 	group->max = p_elements;
 	group->self = id;
+	group->high_priority = p_high_priority;
 
-	Task **tasks_posted = nullptr;
 	if (p_elements == 0) {
-		// Should really not call it with zero Elements, but at least it should work.
-		group->completed.set_to(true);
-		group->done_semaphore.post();
 		group->tasks_used = 0;
-		p_tasks = 0;
 		if (p_template_userdata) {
 			memdelete(p_template_userdata);
 		}
 
 	} else {
 		group->tasks_used = p_tasks;
-		tasks_posted = (Task **)alloca(sizeof(Task *) * p_tasks);
+		group->deferred_tasks.resize(p_tasks);
+		if (!p_high_priority && use_native_low_priority_threads) {
+			group->low_priority_native_tasks.resize(p_tasks);
+		}
 		for (int i = 0; i < p_tasks; i++) {
 			Task *task = task_allocator.alloc();
 			task->native_group_func = p_func;
@@ -314,34 +574,32 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 			task->group = group;
 			task->callable = p_callable;
 			task->template_userdata = p_template_userdata;
-			tasks_posted[i] = task;
+			group->deferred_tasks[i] = task;
+			if (!p_high_priority && use_native_low_priority_threads) {
+				group->low_priority_native_tasks[i] = task;
+			}
 			// No task ID is used.
 		}
 	}
 
+	// Hold one extra reference while registering, so the group is not posted by a dependency completing meanwhile.
+	group->pending_dependencies.set(1);
+	group->pending_dependencies.add(_add_dependencies(p_dependencies, nullptr, group));
+
 	groups[id] = group;
 	task_mutex.unlock();
 
-	if (!p_high_priority && use_native_low_priority_threads) {
-		group->low_priority_native_tasks.resize(p_tasks);
-	}
-
-	for (int i = 0; i < p_tasks; i++) {
-		_post_task(tasks_posted[i], p_high_priority);
-		if (!p_high_priority && use_native_low_priority_threads) {
-			group->low_priority_native_tasks[i] = tasks_posted[i];
-		}
-	}
+	_dependency_completed(group);
 
 	return id;
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
-	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description);
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_action, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
-	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description);
+WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_action, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
+	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
 }
 
 uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
@@ -370,26 +628,43 @@ bool WorkerThreadPool::is_group_task_completed(GroupID p_group) const {
 void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 	task_mutex.lock();
 	Group **groupp = groups.getptr(p_group);
-	task_mutex.unlock();
 	if (!groupp) {
+		task_mutex.unlock();
 		ERR_FAIL_MSG("Invalid Group ID");
 	}
 	Group *group = *groupp;
+	task_mutex.unlock();
 
 	if (group->low_priority_native_tasks.size() > 0) {
+		// The group stays reachable until all tasks completed, so dependents can still be added to it meanwhile.
 		for (Task *task : group->low_priority_native_tasks) {
+			// The thread may not exist yet if the group is waiting for dependencies, so wait for completion before joining it.
+			task->done_semaphore.wait();
 			task->low_priority_thread->wait_to_finish();
-			native_thread_allocator.free(task->low_priority_thread);
 			task_mutex.lock();
+			native_thread_allocator.free(task->low_priority_thread);
 			task_allocator.free(task);
 			task_mutex.unlock();
 		}
 
 		task_mutex.lock();
+		groups.erase(p_group);
 		group_allocator.free(group);
 		task_mutex.unlock();
 	} else {
-		group->done_semaphore.wait();
+		ThreadData *thread_data = _get_current_thread_data();
+		if (use_work_stealing && thread_data) {
+			// We are an actual process thread, keep processing tasks (probably the ones of this group) while waiting.
+			_work_stealing_wait(group->done_semaphore, thread_data);
+		} else {
+			group->done_semaphore.wait();
+		}
+
+		// Forget the ID before releasing our use of the group, as the last user frees it. After this, new dependencies on it
+		// are ignored, which is correct as it completed.
+		task_mutex.lock();
+		groups.erase(p_group);
+		task_mutex.unlock();
 
 		uint32_t max_users = group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = group->finished.increment(); // fetch happens before inc, so increment later.
@@ -401,13 +676,9 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 			task_mutex.unlock();
 		}
 	}
-
-	task_mutex.lock(); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
-	groups.erase(p_group);
-	task_mutex.unlock();
 }
 
-void WorkerThreadPool::init(int p_thread_count, bool p_use_native_threads_low_priority, float p_low_priority_task_ratio) {
+void WorkerThreadPool::init(int p_thread_count, bool p_use_native_threads_low_priority, float p_low_priority_task_ratio, bool p_use_work_stealing) {
 	ERR_FAIL_COND(threads.size() > 0);
 	if (p_thread_count < 0) {
 		p_thread_count = OS::get_singleton()->get_default_thread_pool_size();
@@ -420,10 +691,12 @@ void WorkerThreadPool::init(int p_thread_count, bool p_use_native_threads_low_pr
 	}
 
 	use_native_low_priority_threads = p_use_native_threads_low_priority;
+	use_work_stealing = p_use_work_stealing;
 
 	threads.resize(p_thread_count);
 
 	for (uint32_t i = 0; i < threads.size(); i++) {
+		threads[i].pool = this;
 		threads[i].index = i;
 		threads[i].thread.start(&WorkerThreadPool::_thread_function, &threads[i]);
 		thread_ids.insert(threads[i].thread.get_id(), i);
@@ -457,20 +730,26 @@ void WorkerThreadPool::finish() {
 }
 
 void WorkerThreadPool::_bind_methods() {
-	ClassDB::bind_method(D_METHOD("add_task", "action", "high_priority", "description"), &WorkerThreadPool::add_task, DEFVAL(false), DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("add_task", "action", "high_priority", "description", "dependencies"), &WorkerThreadPool::add_task, DEFVAL(false), DEFVAL(String()), DEFVAL(PackedInt64Array()));
 	ClassDB::bind_method(D_METHOD("is_task_completed", "task_id"), &WorkerThreadPool::is_task_completed);
 	ClassDB::bind_method(D_METHOD("wait_for_task_completion", "task_id"), &WorkerThreadPool::wait_for_task_completion);
 
-	ClassDB::bind_method(D_METHOD("add_group_task", "action", "elements", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("add_group_task", "action", "elements", "tasks_needed", "high_priority", "description", "dependencies"), &WorkerThreadPool::add_group_task, DEFVAL(-1), DEFVAL(false), DEFVAL(String()), DEFVAL(PackedInt64Array()));
 	ClassDB::bind_method(D_METHOD("is_group_task_completed", "group_id"), &WorkerThreadPool::is_group_task_completed);
 	ClassDB::bind_method(D_METHOD("get_group_processed_element_count", "group_id"), &WorkerThreadPool::get_group_processed_element_count);
 	ClassDB::bind_method(D_METHOD("wait_for_group_task_completion", "group_id"), &WorkerThreadPool::wait_for_group_task_completion);
 }
 
 WorkerThreadPool::WorkerThreadPool() {
-	singleton = this;
+	// Only the first pool is the singleton, others (as used by tests) are standalone.
+	if (!singleton) {
+		singleton = this;
+	}
 }
 
 WorkerThreadPool::~WorkerThreadPool() {
 	finish();
+	if (singleton == this) {
+		singleton = nullptr;
+	}
 }
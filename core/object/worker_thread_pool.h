@@ -34,11 +34,13 @@
 #include "core/os/memory.h"
 #include "core/os/os.h"
 #include "core/os/semaphore.h"
+#include "core/os/spin_lock.h"
 #include "core/os/thread.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_queue.h"
 
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
@@ -52,6 +54,7 @@ public:
 
 private:
 	struct Task;
+	struct Group;
 
 	struct BaseTemplateUserdata {
 		virtual void callback() {}
@@ -59,6 +62,14 @@ private:
 		virtual ~BaseTemplateUserdata() {}
 	};
 
+	// Tasks and groups waiting for a task or group to complete before being posted.
+	struct Dependents {
+		SpinLock lock;
+		bool released = false; // Set once the owner completed, no dependents may be added after that.
+		TightLocalVector<Task *> tasks;
+		TightLocalVector<Group *> groups;
+	};
+
 	struct Group {
 		GroupID self;
 		SafeNumeric<uint32_t> index;
@@ -69,6 +80,10 @@ private:
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
 		TightLocalVector<Task *> low_priority_native_tasks;
+		SafeNumeric<uint32_t> pending_dependencies;
+		TightLocalVector<Task *> deferred_tasks; // Posted once pending_dependencies reaches zero.
+		bool high_priority = false;
+		Dependents dependents;
 	};
 
 	struct Task {
@@ -85,6 +100,10 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		Thread *low_priority_thread = nullptr;
+		WorkerThreadPool *pool = nullptr; // Needed by native low priority threads, which don't belong to the pool.
+		SafeNumeric<uint32_t> pending_dependencies;
+		bool high_priority = false;
+		Dependents dependents;
 
 		void free_template_userdata();
 		Task() :
@@ -102,8 +121,13 @@ private:
 	Semaphore task_available_semaphore;
 
 	struct ThreadData {
+		WorkerThreadPool *pool = nullptr;
 		uint32_t index;
 		Thread thread;
+		WorkStealingQueue<Task *> work_queue; // Only used in work stealing mode.
+		// Set while blocked waiting for a task or group in work stealing mode, see _work_stealing_wait().
+		std::atomic<bool> blocked = false;
+		Semaphore wake_semaphore;
 	};
 
 	TightLocalVector<ThreadData> threads;
@@ -117,20 +141,50 @@ private:
 	uint32_t max_low_priority_threads = 0;
 	SafeNumeric<uint32_t> low_priority_threads_used;
 
+	// In work stealing mode, each thread owns a queue where tasks posted from inside a task are pushed,
+	// while tasks posted from other threads go to `task_queue`. Idle threads steal from their peers.
+	bool use_work_stealing = false;
+	SafeNumeric<uint32_t> task_queue_size; // So task_queue can be checked without locking.
+	SafeNumeric<uint32_t> sleeping_threads;
+	SafeNumeric<uint32_t> blocked_waiters; // Threads blocked while waiting for a task or group.
+
+	// How many times a thread waiting in work stealing mode looks for tasks in a row without finding any, before blocking.
+	static const uint32_t WORK_STEALING_WAIT_SPINS = 64;
+
 	uint64_t last_task = 1;
 
+	static thread_local ThreadData *current_thread_data;
+
+	// Data of the calling thread, if it is one of the threads of this pool.
+	_FORCE_INLINE_ ThreadData *_get_current_thread_data() const {
+		return (current_thread_data && current_thread_data->pool == this) ? current_thread_data : nullptr;
+	}
+
 	static void _thread_function(void *p_user);
 	static void _native_low_priority_thread_function(void *p_user);
 
 	void _process_task_queue();
 	void _process_task(Task *task);
 
+	void _work_stealing_loop(ThreadData *p_thread_data);
+	Task *_work_stealing_find_task(ThreadData *p_thread_data);
+	void _work_stealing_push_task(Task *p_task);
+	void _work_stealing_wait(Semaphore &p_done_semaphore, ThreadData *p_thread_data);
+	void _work_stealing_wake_waiters(bool p_all);
+
 	void _post_task(Task *p_task, bool p_high_priority);
+	void _post_group_tasks(Group *p_group);
+	void _complete_empty_group(Group *p_group);
+
+	uint32_t _add_dependencies(const Vector<TaskID> &p_dependencies, Task *p_task, Group *p_group);
+	void _release_dependents(Dependents &p_dependents);
+	void _dependency_completed(Task *p_task);
+	void _dependency_completed(Group *p_group);
 
 	static WorkerThreadPool *singleton;
 
-	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description);
-	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
+	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies);
+	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies);
 
 	template <class C, class M, class U>
 	struct TaskUserData : public BaseTemplateUserdata {
@@ -156,40 +210,44 @@ protected:
 	static void _bind_methods();
 
 public:
+	// All add functions take an optional list of task and/or group IDs that must complete before the new task or group is started.
+	// Dependencies that already completed (or were already waited for) are ignored.
+
 	template <class C, class M, class U>
-	TaskID add_template_task(C *p_instance, M p_method, U p_userdata, bool p_high_priority = false, const String &p_description = String()) {
+	TaskID add_template_task(C *p_instance, M p_method, U p_userdata, bool p_high_priority = false, const String &p_description = String(), const Vector<TaskID> &p_dependencies = Vector<TaskID>()) {
 		typedef TaskUserData<C, M, U> TUD;
 		TUD *ud = memnew(TUD);
 		ud->instance = p_instance;
 		ud->method = p_method;
 		ud->userdata = p_userdata;
-		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description);
+		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description, p_dependencies);
 	}
-	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
-	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
+	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String(), const Vector<TaskID> &p_dependencies = Vector<TaskID>());
+	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String(), const Vector<TaskID> &p_dependencies = Vector<TaskID>());
 
 	bool is_task_completed(TaskID p_task_id) const;
 	void wait_for_task_completion(TaskID p_task_id);
 
 	template <class C, class M, class U>
-	GroupID add_template_group_task(C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String()) {
+	GroupID add_template_group_task(C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String(), const Vector<TaskID> &p_dependencies = Vector<TaskID>()) {
 		typedef GroupUserData<C, M, U> GroupUD;
 		GroupUD *ud = memnew(GroupUD);
 		ud->instance = p_instance;
 		ud->method = p_method;
 		ud->userdata = p_userdata;
-		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description);
+		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
 	}
-	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
-	GroupID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String(), const Vector<TaskID> &p_dependencies = Vector<TaskID>());
+	GroupID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String(), const Vector<TaskID> &p_dependencies = Vector<TaskID>());
 	uint32_t get_group_processed_element_count(GroupID p_group) const;
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
 
 	_FORCE_INLINE_ int get_thread_count() const { return threads.size(); }
+	_FORCE_INLINE_ bool is_using_work_stealing() const { return use_work_stealing; }
 
 	static WorkerThreadPool *get_singleton() { return singleton; }
-	void init(int p_thread_count = -1, bool p_use_native_threads_low_priority = true, float p_low_priority_task_ratio = 0.3);
+	void init(int p_thread_count = -1, bool p_use_native_threads_low_priority = true, float p_low_priority_task_ratio = 0.3, bool p_use_work_stealing = false);
 	void finish();
 	WorkerThreadPool();
 	~WorkerThreadPool();
@@ -87,8 +87,9 @@ public:
 
 protected:
 	friend class Main;
-	// Needed by tests to setup command-line args.
+	// Needed by tests and benchmarks to setup command-line args.
 	friend int test_main(int argc, char *argv[]);
+	friend int benchmark_main(int argc, char *argv[]);
 
 	HasServerFeatureCallback has_server_feature_callback = nullptr;
 	RenderThreadMode _render_thread_mode = RENDER_THREAD_SAFE;
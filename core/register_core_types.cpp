@@ -305,12 +305,16 @@ void register_core_settings() {
 	int worker_threads = GLOBAL_DEF("threading/worker_pool/max_threads", -1);
 	bool low_priority_use_system_threads = GLOBAL_DEF("threading/worker_pool/use_system_threads_for_low_priority_tasks", true);
 	float low_property_ratio = GLOBAL_DEF("threading/worker_pool/low_priority_thread_ratio", 0.3);
+	bool use_work_stealing = GLOBAL_DEF("threading/worker_pool/use_work_stealing", false);
+	int max_threaded_loads = GLOBAL_DEF(PropertyInfo(Variant::INT, "threading/worker_pool/max_threaded_loads", PROPERTY_HINT_RANGE, "-1,64,1,or_greater"), -1);
 
 	if (Engine::get_singleton()->is_editor_hint() || Engine::get_singleton()->is_project_manager_hint()) {
 		worker_thread_pool->init();
 	} else {
-		worker_thread_pool->init(worker_threads, low_priority_use_system_threads, low_property_ratio);
+		worker_thread_pool->init(worker_threads, low_priority_use_system_threads, low_property_ratio, use_work_stealing);
 	}
+
+	ResourceLoader::set_max_threaded_loads(max_threaded_loads > 0 ? max_threaded_loads : MAX(worker_thread_pool->get_thread_count(), 1));
 }
 
 void register_core_singletons() {
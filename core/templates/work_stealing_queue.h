@@ -0,0 +1,177 @@
+/**************************************************************************/
+/*  work_stealing_queue.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef WORK_STEALING_QUEUE_H
+#define WORK_STEALING_QUEUE_H
+
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+#include "core/typedefs.h"
+
+#include <atomic>
+
+// Lock-free work-stealing deque (Chase-Lev), with the memory orderings from
+// "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê et al., 2013).
+// - Only the owner thread may call push() and pop(), which work on the bottom end (LIFO).
+// - Any thread may call steal(), which takes from the top end (FIFO).
+// - The buffer grows as needed. Old buffers are kept alive until the queue is destroyed,
+//   because a thief may still be reading from them.
+
+// Guarantees LIFO push/pop for the owner and FIFO steals for thieves, without ever locking.
+
+template <class T>
+class WorkStealingQueue {
+	static_assert(std::atomic<T>::is_always_lock_free);
+
+	struct Buffer {
+		int64_t capacity = 0;
+		int64_t mask = 0;
+		std::atomic<T> *data = nullptr;
+		Buffer *retired = nullptr;
+
+		_FORCE_INLINE_ T get(int64_t p_index) const {
+			return data[p_index & mask].load(std::memory_order_relaxed);
+		}
+
+		_FORCE_INLINE_ void put(int64_t p_index, T p_value) {
+			data[p_index & mask].store(p_value, std::memory_order_relaxed);
+		}
+
+		Buffer(int64_t p_capacity) {
+			capacity = p_capacity;
+			mask = p_capacity - 1;
+			data = memnew_arr(std::atomic<T>, p_capacity);
+		}
+
+		~Buffer() {
+			memdelete_arr(data);
+		}
+	};
+
+	std::atomic<int64_t> top;
+	std::atomic<int64_t> bottom;
+	std::atomic<Buffer *> buffer;
+
+	Buffer *_grow(Buffer *p_buffer, int64_t p_bottom, int64_t p_top) {
+		Buffer *new_buffer = memnew(Buffer(p_buffer->capacity * 2));
+		for (int64_t i = p_top; i < p_bottom; i++) {
+			new_buffer->put(i, p_buffer->get(i));
+		}
+		new_buffer->retired = p_buffer;
+		buffer.store(new_buffer, std::memory_order_release);
+		return new_buffer;
+	}
+
+public:
+	// Owner only.
+	void push(T p_value) {
+		int64_t b = bottom.load(std::memory_order_relaxed);
+		int64_t t = top.load(std::memory_order_acquire);
+		Buffer *a = buffer.load(std::memory_order_relaxed);
+		if (b - t > a->capacity - 1) {
+			a = _grow(a, b, t);
+		}
+		a->put(b, p_value);
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom.store(b + 1, std::memory_order_relaxed);
+	}
+
+	// Owner only. Returns false if the queue was empty, or the last element was stolen meanwhile.
+	bool pop(T &r_value) {
+		int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+		Buffer *a = buffer.load(std::memory_order_relaxed);
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = top.load(std::memory_order_relaxed);
+
+		if (t > b) {
+			// Empty.
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		r_value = a->get(b);
+		if (t == b) {
+			// Last element, race against thieves for it.
+			bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return won;
+		}
+		return true;
+	}
+
+	// Any thread. Retries while other thieves win the race, so false means the queue was seen empty.
+	bool steal(T &r_value) {
+		while (true) {
+			int64_t t = top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t b = bottom.load(std::memory_order_acquire);
+			if (t >= b) {
+				return false;
+			}
+
+			Buffer *a = buffer.load(std::memory_order_acquire);
+			T value = a->get(t);
+			if (top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+				r_value = value;
+				return true;
+			}
+		}
+	}
+
+	// Approximate when other threads are using the queue.
+	_FORCE_INLINE_ int64_t size() const {
+		int64_t b = bottom.load(std::memory_order_relaxed);
+		int64_t t = top.load(std::memory_order_relaxed);
+		return b > t ? b - t : 0;
+	}
+
+	_FORCE_INLINE_ bool is_empty() const {
+		return size() == 0;
+	}
+
+	WorkStealingQueue(int64_t p_initial_capacity = 256) {
+		DEV_ASSERT(p_initial_capacity > 0 && (p_initial_capacity & (p_initial_capacity - 1)) == 0);
+		top.store(0, std::memory_order_relaxed);
+		bottom.store(0, std::memory_order_relaxed);
+		buffer.store(memnew(Buffer(p_initial_capacity)), std::memory_order_relaxed);
+	}
+
+	~WorkStealingQueue() {
+		Buffer *a = buffer.load(std::memory_order_relaxed);
+		while (a) {
+			Buffer *retired = a->retired;
+			memdelete(a);
+			a = retired;
+		}
+	}
+};
+
+#endif // WORK_STEALING_QUEUE_H
@@ -38,6 +38,11 @@
 
 Error ImageLoaderPNG::load_image(Ref<Image> p_image, Ref<FileAccess> f, BitField<ImageFormatLoader::LoaderFlags> p_flags, float p_scale) {
 	const uint64_t buffer_size = f->get_length();
+	const uint8_t *mapped = f->get_mapped_buffer();
+	if (mapped) {
+		// Decode straight from the file in memory.
+		return PNGDriverCommon::png_to_image(mapped, buffer_size, p_flags & FLAG_FORCE_LINEAR, p_image);
+	}
 	Vector<uint8_t> file_buffer;
 	Error err = file_buffer.resize(buffer_size);
 	if (err) {
@@ -67,11 +72,14 @@ Ref<Image> ImageLoaderPNG::load_mem_png(const uint8_t *p_png, int p_size) {
 }
 
 Ref<Image> ImageLoaderPNG::lossless_unpack_png(const Vector<uint8_t> &p_data) {
-	const int len = p_data.size();
-	ERR_FAIL_COND_V(len < 4, Ref<Image>());
-	const uint8_t *r = p_data.ptr();
+	return lossless_unpack_png_ptr(p_data.ptr(), p_data.size());
+}
+
+Ref<Image> ImageLoaderPNG::lossless_unpack_png_ptr(const uint8_t *p_data, int p_size) {
+	ERR_FAIL_COND_V(p_size < 4, Ref<Image>());
+	const uint8_t *r = p_data;
 	ERR_FAIL_COND_V(r[0] != 'P' || r[1] != 'N' || r[2] != 'G' || r[3] != ' ', Ref<Image>());
-	return load_mem_png(&r[4], len - 4);
+	return load_mem_png(&r[4], p_size - 4);
 }
 
 Vector<uint8_t> ImageLoaderPNG::lossless_pack_png(const Ref<Image> &p_image) {
@@ -100,5 +108,6 @@ Vector<uint8_t> ImageLoaderPNG::lossless_pack_png(const Ref<Image> &p_image) {
 ImageLoaderPNG::ImageLoaderPNG() {
 	Image::_png_mem_loader_func = load_mem_png;
 	Image::png_unpacker = lossless_unpack_png;
+	Image::png_unpacker_ptr = lossless_unpack_png_ptr;
 	Image::png_packer = lossless_pack_png;
 }
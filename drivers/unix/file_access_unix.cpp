@@ -37,6 +37,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 
@@ -152,6 +153,13 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	if (map_data) {
+		munmap((void *)map_data, map_length);
+		map_data = nullptr;
+		map_length = 0;
+		map_position = 0;
+	}
+
 	fclose(f);
 	f = nullptr;
 
@@ -187,6 +195,10 @@ void FileAccessUnix::seek(uint64_t p_position) {
 	ERR_FAIL_COND_MSG(!f, "File must be opened before use.");
 
 	last_error = OK;
+	if (map_data) {
+		map_position = p_position;
+		return;
+	}
 	if (fseeko(f, p_position, SEEK_SET)) {
 		check_errors();
 	}
@@ -195,6 +207,11 @@ void FileAccessUnix::seek(uint64_t p_position) {
 void FileAccessUnix::seek_end(int64_t p_position) {
 	ERR_FAIL_COND_MSG(!f, "File must be opened before use.");
 
+	if (map_data) {
+		ERR_FAIL_COND(p_position < 0 && uint64_t(-p_position) > map_length);
+		map_position = map_length + p_position;
+		return;
+	}
 	if (fseeko(f, p_position, SEEK_END)) {
 		check_errors();
 	}
@@ -203,6 +220,10 @@ void FileAccessUnix::seek_end(int64_t p_position) {
 uint64_t FileAccessUnix::get_position() const {
 	ERR_FAIL_COND_V_MSG(!f, 0, "File must be opened before use.");
 
+	if (map_data) {
+		return map_position;
+	}
+
 	int64_t pos = ftello(f);
 	if (pos < 0) {
 		check_errors();
@@ -214,6 +235,10 @@ uint64_t FileAccessUnix::get_position() const {
 uint64_t FileAccessUnix::get_length() const {
 	ERR_FAIL_COND_V_MSG(!f, 0, "File must be opened before use.");
 
+	if (map_data) {
+		return map_length;
+	}
+
 	int64_t pos = ftello(f);
 	ERR_FAIL_COND_V(pos < 0, 0);
 	ERR_FAIL_COND_V(fseeko(f, 0, SEEK_END), 0);
@@ -230,6 +255,13 @@ bool FileAccessUnix::eof_reached() const {
 
 uint8_t FileAccessUnix::get_8() const {
 	ERR_FAIL_COND_V_MSG(!f, 0, "File must be opened before use.");
+	if (map_data) {
+		if (map_position >= map_length) {
+			last_error = ERR_FILE_EOF;
+			return '\0';
+		}
+		return map_data[map_position++];
+	}
 	uint8_t b;
 	if (fread(&b, 1, 1, f) == 0) {
 		check_errors();
@@ -242,11 +274,46 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 	ERR_FAIL_COND_V_MSG(!f, -1, "File must be opened before use.");
 
+	if (map_data) {
+		uint64_t read = map_position < map_length ? MIN(p_length, map_length - map_position) : 0;
+		if (read < p_length) {
+			last_error = ERR_FILE_EOF;
+		}
+		if (read > 0) {
+			memcpy(p_dst, map_data + map_position, read);
+			map_position += read;
+		}
+		return read;
+	}
+
 	uint64_t read = fread(p_dst, 1, p_length, f);
 	check_errors();
 	return read;
 }
 
+const uint8_t *FileAccessUnix::get_mapped_buffer() const {
+	ERR_FAIL_COND_V_MSG(!f, nullptr, "File must be opened before use.");
+
+	if (map_data || flags != READ) {
+		return map_data;
+	}
+
+	const uint64_t length = get_length();
+	if (length == 0 || length > SIZE_MAX) {
+		return nullptr;
+	}
+	void *data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+	if (data == MAP_FAILED) {
+		return nullptr;
+	}
+
+	// Keep reading from where the stream was.
+	map_position = get_position();
+	map_data = (const uint8_t *)data;
+	map_length = length;
+	return map_data;
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -49,6 +49,11 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	// Set once the file is memory mapped, reads then come from the mapping instead of `f`.
+	mutable const uint8_t *map_data = nullptr;
+	mutable uint64_t map_length = 0;
+	mutable uint64_t map_position = 0;
+
 	void _close();
 
 public:
@@ -69,6 +74,7 @@ public:
 
 	virtual uint8_t get_8() const override; ///< get a byte
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_buffer() const override; ///< map the file in memory, only for files opened for reading
 
 	virtual Error get_error() const override; ///< get last error
 
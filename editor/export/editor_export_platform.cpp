@@ -34,7 +34,7 @@
 #include "core/crypto/crypto_core.h"
 #include "core/extension/gdextension.h"
 #include "core/io/file_access_encrypted.h"
-#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION, PACK_FORMAT_VERSION_UNCOMPRESSED
 #include "core/io/zip_io.h"
 #include "core/version.h"
 #include "editor/editor_file_system.h"
@@ -210,6 +210,9 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 		}
 	}
 
+	// Encrypted files are left uncompressed, as they can't be read by blocks.
+	sd.compressed = pd->compress && !sd.encrypted;
+
 	Ref<FileAccessEncrypted> fae;
 	Ref<FileAccess> ftmp = pd->f;
 
@@ -223,7 +226,12 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 	}
 
 	// Store file content.
-	ftmp->store_buffer(p_data.ptr(), p_data.size());
+	if (sd.compressed) {
+		Vector<uint8_t> compressed_data = PackedData::compress_file(p_data);
+		ftmp->store_buffer(compressed_data.ptr(), compressed_data.size());
+	} else {
+		ftmp->store_buffer(p_data.ptr(), p_data.size());
+	}
 
 	if (fae.is_valid()) {
 		ftmp.unref();
@@ -1503,6 +1511,7 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 	pd.ep = &ep;
 	pd.f = ftmp;
 	pd.so_files = p_so_files;
+	pd.compress = GLOBAL_GET("editor/export/compress_pck_files");
 
 	Error err = export_project_files(p_preset, p_debug, _save_pack_file, &pd, _add_shared_object);
 
@@ -1553,13 +1562,18 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 
 	int64_t pck_start_pos = f->get_position();
 
+	bool has_compressed_files = false;
+	for (const SavedData &sd : pd.file_ofs) {
+		has_compressed_files = has_compressed_files || sd.compressed;
+	}
+
 	f->store_32(PACK_HEADER_MAGIC);
-	f->store_32(PACK_FORMAT_VERSION);
+	f->store_32(has_compressed_files ? PACK_FORMAT_VERSION : PACK_FORMAT_VERSION_UNCOMPRESSED);
 	f->store_32(VERSION_MAJOR);
 	f->store_32(VERSION_MINOR);
 	f->store_32(VERSION_PATCH);
 
-	uint32_t pack_flags = 0;
+	uint32_t pack_flags = PACK_DIR_INDEXED;
 	bool enc_pck = p_preset->get_enc_pck();
 	bool enc_directory = p_preset->get_enc_directory();
 	if (enc_pck && enc_directory) {
@@ -1569,8 +1583,9 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 
 	uint64_t file_base_ofs = f->get_position();
 	f->store_64(0); // files base
+	f->store_64(0); // directory size
 
-	for (int i = 0; i < 16; i++) {
+	for (int i = 0; i < 14; i++) {
 		//reserved
 		f->store_32(0);
 	}
@@ -1624,10 +1639,17 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 		fhead = fae;
 	}
 
+	Vector<String> paths;
+	Vector<uint32_t> entry_offsets;
+	uint64_t directory_size = 0;
 	for (int i = 0; i < pd.file_ofs.size(); i++) {
 		uint32_t string_len = pd.file_ofs[i].path_utf8.length();
 		uint32_t pad = _get_pad(4, string_len);
 
+		paths.push_back(String::utf8(pd.file_ofs[i].path_utf8.get_data(), string_len));
+		entry_offsets.push_back(directory_size);
+		directory_size += 4 + string_len + pad + 8 + 8 + 16 + 4;
+
 		fhead->store_32(string_len + pad);
 		fhead->store_buffer((const uint8_t *)pd.file_ofs[i].path_utf8.get_data(), string_len);
 		for (uint32_t j = 0; j < pad; j++) {
@@ -1641,9 +1663,16 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 		if (pd.file_ofs[i].encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (pd.file_ofs[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
+	Vector<uint8_t> path_index = PackedData::make_path_index(paths, entry_offsets);
+	fhead->store_buffer(path_index.ptr(), path_index.size());
+	directory_size += path_index.size();
+
 	if (fae.is_valid()) {
 		fhead.unref();
 		fae.unref();
@@ -1657,6 +1686,7 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 	uint64_t file_base = f->get_position();
 	f->seek(file_base_ofs);
 	f->store_64(file_base); // update files base
+	f->store_64(directory_size);
 	f->seek(file_base);
 
 	// Save the rest of the data.
@@ -35,6 +35,7 @@
 #include "core/core_string_names.h"
 #include "core/crypto/crypto.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/engine_trace.h"
 #include "core/extension/extension_api_dump.h"
 #include "core/extension/gdextension_interface_dump.gen.h"
 #include "core/extension/gdextension_manager.h"
@@ -85,6 +86,10 @@
 #include "tests/test_main.h"
 #endif
 
+#ifdef BENCHMARKS_ENABLED
+#include "benchmarks/benchmark_main.h"
+#endif
+
 #ifdef TOOLS_ENABLED
 #include "editor/debugger/editor_debugger_node.h"
 #include "editor/doc_data_class_path.gen.h"
@@ -213,6 +218,9 @@ static int fixed_fps = -1;
 static MovieWriter *movie_writer = nullptr;
 static bool disable_vsync = false;
 static bool print_fps = false;
+#ifdef TRACE_MARKERS_ENABLED
+static String trace_capture_path;
+#endif
 #ifdef TOOLS_ENABLED
 static bool dump_gdextension_interface = false;
 static bool dump_extension_api = false;
@@ -435,6 +443,12 @@ void Main::print_help(const char *p_binary) {
 	OS::get_singleton()->print("  --disable-crash-handler           Disable crash handler when supported by the platform code.\n");
 	OS::get_singleton()->print("  --fixed-fps <fps>                 Force a fixed number of frames per second. This setting disables real-time synchronization.\n");
 	OS::get_singleton()->print("  --print-fps                       Print the frames per second to the stdout.\n");
+#ifdef TRACE_MARKERS_ENABLED
+	OS::get_singleton()->print("  --trace-capture <file>            Capture a timeline of the engine and save it to the specified path when quitting, in the Chrome trace event format (.json).\n");
+#endif
+#ifdef MODULE_GDSCRIPT_ENABLED
+	OS::get_singleton()->print("  --gdscript-trace <file>           Record every GDScript call and save the trace to the specified path when quitting, in the Chrome trace event format (.json) or as folded stacks (any other extension).\n");
+#endif
 	OS::get_singleton()->print("\n");
 
 	OS::get_singleton()->print("Standalone tools:\n");
@@ -462,11 +476,14 @@ void Main::print_help(const char *p_binary) {
 #ifdef TESTS_ENABLED
 	OS::get_singleton()->print("  --test [--help]                   Run unit tests. Use --test --help for more information.\n");
 #endif
+#ifdef BENCHMARKS_ENABLED
+	OS::get_singleton()->print("  --benchmarks [--help]             Run the benchmark suite. Use --benchmarks --help for more information.\n");
+#endif
 #endif
 	OS::get_singleton()->print("\n");
 }
 
-#ifdef TESTS_ENABLED
+#if defined(TESTS_ENABLED) || defined(BENCHMARKS_ENABLED)
 // The order is the same as in `Main::setup()`, only core and some editor types
 // are initialized here. This also combines `Main::setup2()` initialization.
 Error Main::test_setup() {
@@ -647,6 +664,17 @@ int Main::test_entrypoint(int argc, char *argv[], bool &tests_need_run) {
 			return status;
 		}
 	}
+#endif
+#ifdef BENCHMARKS_ENABLED
+	for (int x = 0; x < argc; x++) {
+		if (strcmp(argv[x], "--benchmarks") == 0) {
+			tests_need_run = true;
+			test_setup();
+			int status = benchmark_main(argc, argv);
+			test_cleanup();
+			return status;
+		}
+	}
 #endif
 	tests_need_run = false;
 	return 0;
@@ -1313,6 +1341,29 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			disable_vsync = true;
 		} else if (I->get() == "--print-fps") {
 			print_fps = true;
+#ifdef TRACE_MARKERS_ENABLED
+		} else if (I->get() == "--trace-capture") {
+			if (I->next()) {
+				trace_capture_path = I->next()->get();
+				N = I->next()->next();
+				EngineTrace::start();
+			} else {
+				OS::get_singleton()->print("Missing trace-capture argument, aborting.\n");
+				goto error;
+			}
+#endif
+#ifdef MODULE_GDSCRIPT_ENABLED
+		} else if (I->get() == "--gdscript-trace") {
+			if (I->next()) {
+				// Handled by the GDScript module.
+				main_args.push_back(I->get());
+				main_args.push_back(I->next()->get());
+				N = I->next()->next();
+			} else {
+				OS::get_singleton()->print("Missing gdscript-trace argument, aborting.\n");
+				goto error;
+			}
+#endif
 		} else if (I->get() == "--profile-gpu") {
 			profile_gpu = true;
 		} else if (I->get() == "--disable-crash-handler") {
@@ -2460,6 +2511,10 @@ bool Main::start() {
 			bool parsed_pair = true;
 			if (args[i] == "-s" || args[i] == "--script") {
 				script = args[i + 1];
+#ifdef MODULE_GDSCRIPT_ENABLED
+			} else if (args[i] == "--gdscript-trace") {
+				// Handled by the GDScript module, the path isn't a positional argument.
+#endif
 #ifdef TOOLS_ENABLED
 			} else if (args[i] == "--doctool") {
 				doc_tool_path = args[i + 1];
@@ -3070,6 +3125,8 @@ static uint64_t process_max = 0;
 static uint64_t navigation_process_max = 0;
 
 bool Main::iteration() {
+	TRACE_SCOPE("Main::iteration");
+
 	//for now do not error on this
 	//ERR_FAIL_COND_V(iterating, false);
 
@@ -3293,6 +3350,17 @@ void Main::cleanup(bool p_force) {
 		movie_writer->end();
 	}
 
+#ifdef TRACE_MARKERS_ENABLED
+	if (!trace_capture_path.is_empty()) {
+		EngineTrace::stop();
+		if (EngineTrace::save(trace_capture_path) == OK) {
+			print_line(vformat("Trace saved to \"%s\".", trace_capture_path));
+		}
+		EngineTrace::clear();
+		trace_capture_path = String();
+	}
+#endif
+
 	ResourceLoader::remove_custom_loaders();
 	ResourceSaver::remove_custom_savers();
 
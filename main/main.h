@@ -62,7 +62,7 @@ public:
 	static Error setup(const char *execpath, int argc, char *argv[], bool p_second_phase = true);
 	static Error setup2(Thread::ID p_main_tid_override = 0);
 	static String get_rendering_driver_name();
-#ifdef TESTS_ENABLED
+#if defined(TESTS_ENABLED) || defined(BENCHMARKS_ENABLED)
 	static Error test_setup();
 	static void test_cleanup();
 #endif
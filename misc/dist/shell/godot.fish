@@ -95,6 +95,8 @@ complete -c godot -l disable-render-loop -d "Disable render loop so rendering on
 complete -c godot -l disable-crash-handler -d "Disable crash handler when supported by the platform code"
 complete -c godot -l fixed-fps -d "Force a fixed number of frames per second (this setting disables real-time synchronization)" -x
 complete -c godot -l print-fps -d "Print the frames per second to the stdout"
+complete -c godot -l trace-capture -d "Capture a timeline of the engine and save it to the specified path when quitting (requires trace_markers=yes)" -x
+complete -c godot -l gdscript-trace -d "Record every GDScript call and save the trace to the specified path when quitting" -x
 
 # Standalone tools:
 complete -c godot -s s -l script -d "Run a script" -r
@@ -112,3 +114,4 @@ complete -c godot -l dump-extension-api -d "Generate JSON dump of the Godot API
 complete -c godot -l startup-benchmark -d "Benchmark the startup time and print it to console"
 complete -c godot -l startup-benchmark-file -d "Benchmark the startup time and save it to a given file in JSON format" -x
 complete -c godot -l test -d "Run all unit tests; run with '--test --help' for more information" -x
+complete -c godot -l benchmarks -d "Run the benchmark suite; run with '--benchmarks --help' for more information" -x
@@ -44,6 +44,7 @@
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 #include "gdscript_rpc_callable.h"
+#include "gdscript_tracer.h"
 #include "gdscript_warning.h"
 
 #ifdef TESTS_ENABLED
@@ -440,6 +441,7 @@ void GDScript::set_source_code(const String &p_code) {
 		return;
 	}
 	source = p_code;
+	binary_tokens.clear();
 #ifdef TOOLS_ENABLED
 	source_changed_cache = true;
 #endif
@@ -668,7 +670,7 @@ bool GDScript::_update_exports(bool *r_err, bool p_recursive_call, PlaceHolderSc
 
 		GDScriptParser parser;
 		GDScriptAnalyzer analyzer(&parser);
-		Error err = parser.parse(source, path, false);
+		Error err = binary_tokens.is_empty() ? parser.parse(source, path, false) : parser.parse_binary(binary_tokens, path);
 
 		if (err == OK && analyzer.analyze() == OK) {
 			const GDScriptParser::ClassNode *c = parser.get_tree();
@@ -859,7 +861,7 @@ Error GDScript::reload(bool p_keep_state) {
 
 	valid = false;
 	GDScriptParser parser;
-	Error err = parser.parse(source, path, false);
+	Error err = binary_tokens.is_empty() ? parser.parse(source, path, false) : parser.parse_binary(binary_tokens, path);
 	if (err) {
 		if (EngineDebugger::is_active()) {
 			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().line, "Parser Error: " + parser.get_errors().front()->get().message);
@@ -1067,6 +1069,20 @@ Error GDScript::load_source_code(const String &p_path) {
 	return OK;
 }
 
+Error GDScript::load_binary_tokens(const String &p_path) {
+	Error err;
+	Vector<uint8_t> buffer = FileAccess::get_file_as_bytes(p_path, &err);
+	ERR_FAIL_COND_V_MSG(err, err, "Attempt to open binary script '" + p_path + "' failed.");
+
+	// The path is kept as the original script one, since the binary file is only a remap of it.
+	source = String();
+	binary_tokens = buffer;
+#ifdef TOOLS_ENABLED
+	source_changed_cache = true;
+#endif // TOOLS_ENABLED
+	return OK;
+}
+
 const HashMap<StringName, GDScriptFunction *> &GDScript::debug_get_member_functions() const {
 	return member_functions;
 }
@@ -2016,6 +2032,19 @@ void GDScriptLanguage::init() {
 		_add_global(E.name, E.ptr);
 	}
 
+	// Tracing is meant for builds running without a debugger, so it's available in all of them.
+	if (GLOBAL_GET("debug/gdscript/tracing/enabled")) {
+		trace_path = GLOBAL_GET("debug/gdscript/tracing/output_path");
+	}
+	List<String> cmdline_args = OS::get_singleton()->get_cmdline_args();
+	const List<String>::Element *trace_arg = cmdline_args.find("--gdscript-trace");
+	if (trace_arg && trace_arg->next()) {
+		trace_path = trace_arg->next()->get();
+	}
+	if (!trace_path.is_empty()) {
+		GDScriptTracer::start(GLOBAL_GET("debug/gdscript/tracing/events_per_thread"));
+	}
+
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif
@@ -2035,6 +2064,15 @@ void GDScriptLanguage::finish() {
 		_call_stack = nullptr;
 	}
 
+	if (!trace_path.is_empty()) {
+		GDScriptTracer::stop();
+		if (GDScriptTracer::save(trace_path, GDScriptTracer::get_format_for_path(trace_path)) == OK) {
+			print_line(vformat("GDScript trace saved to \"%s\".", trace_path));
+		}
+		GDScriptTracer::clear();
+		trace_path = String();
+	}
+
 	// Clear the cache before parsing the script_list
 	GDScriptCache::clear();
 
@@ -2573,6 +2611,14 @@ GDScriptLanguage::GDScriptLanguage() {
 		_call_stack = nullptr;
 	}
 
+	GLOBAL_DEF("debug/gdscript/tracing/enabled", false);
+	GLOBAL_DEF(PropertyInfo(Variant::STRING, "debug/gdscript/tracing/output_path", PROPERTY_HINT_SAVE_FILE, "*.json,*.folded"), "user://gdscript_trace.json");
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "debug/gdscript/tracing/events_per_thread", PROPERTY_HINT_RANGE, "1024,16777216,1,or_greater"), 262144);
+
+#ifdef TOOLS_ENABLED
+	GLOBAL_DEF("editor/export/convert_gdscript_to_binary_tokens", false);
+#endif // TOOLS_ENABLED
+
 #ifdef DEBUG_ENABLED
 	GLOBAL_DEF("debug/gdscript/warnings/enable", true);
 	GLOBAL_DEF("debug/gdscript/warnings/exclude_addons", true);
@@ -2634,8 +2680,9 @@ Ref<Resource> ResourceFormatLoaderGDScript::load(const String &p_path, const Str
 		*r_error = ERR_FILE_CANT_OPEN;
 	}
 
+	// Use the original path, exported scripts may be remapped to a binary tokens file.
 	Error err;
-	Ref<GDScript> scr = GDScriptCache::get_full_script(p_path, err, "", p_cache_mode == CACHE_MODE_IGNORE);
+	Ref<GDScript> scr = GDScriptCache::get_full_script(p_original_path, err, "", p_cache_mode == CACHE_MODE_IGNORE);
 
 	if (scr.is_null()) {
 		// Don't fail loading because of parsing error.
@@ -2651,6 +2698,7 @@ Ref<Resource> ResourceFormatLoaderGDScript::load(const String &p_path, const Str
 
 void ResourceFormatLoaderGDScript::get_recognized_extensions(List<String> *p_extensions) const {
 	p_extensions->push_back("gd");
+	p_extensions->push_back("gdc");
 }
 
 bool ResourceFormatLoaderGDScript::handles_type(const String &p_type) const {
@@ -2659,7 +2707,7 @@ bool ResourceFormatLoaderGDScript::handles_type(const String &p_type) const {
 
 String ResourceFormatLoaderGDScript::get_resource_type(const String &p_path) const {
 	String el = p_path.get_extension().to_lower();
-	if (el == "gd") {
+	if (el == "gd" || el == "gdc") {
 		return "GDScript";
 	}
 	return "";
@@ -2669,14 +2717,22 @@ void ResourceFormatLoaderGDScript::get_dependencies(const String &p_path, List<S
 	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::READ);
 	ERR_FAIL_COND_MSG(file.is_null(), "Cannot open file '" + p_path + "'.");
 
-	String source = file->get_as_utf8_string();
-	if (source.is_empty()) {
-		return;
-	}
-
 	GDScriptParser parser;
-	if (OK != parser.parse(source, p_path, false)) {
-		return;
+	if (p_path.get_extension().to_lower() == "gdc") {
+		Vector<uint8_t> buffer;
+		buffer.resize(file->get_length());
+		file->get_buffer(buffer.ptrw(), buffer.size());
+		if (OK != parser.parse_binary(buffer, p_path)) {
+			return;
+		}
+	} else {
+		String source = file->get_as_utf8_string();
+		if (source.is_empty()) {
+			return;
+		}
+		if (OK != parser.parse(source, p_path, false)) {
+			return;
+		}
 	}
 
 	for (const String &E : parser.get_dependencies()) {
@@ -138,6 +138,7 @@ class GDScript : public Script {
 	bool clearing = false;
 	//exported members
 	String source;
+	Vector<uint8_t> binary_tokens; // Exported scripts are loaded as tokens instead of source, see GDScriptTokenizerBuffer.
 	String path;
 	String name;
 	String fully_qualified_name;
@@ -251,6 +252,8 @@ public:
 	virtual void set_path(const String &p_path, bool p_take_over = false) override;
 	String get_script_path() const;
 	Error load_source_code(const String &p_path);
+	Error load_binary_tokens(const String &p_path);
+	const Vector<uint8_t> &get_binary_tokens_source() const { return binary_tokens; }
 
 	bool get_property_default_value(const StringName &p_property, Variant &r_value) const override;
 
@@ -378,6 +381,8 @@ class GDScriptLanguage : public ScriptLanguage {
 	bool profiling;
 	uint64_t script_frame_time;
 
+	String trace_path;
+
 	HashMap<String, ObjectID> orphan_subclasses;
 
 public:
@@ -580,6 +580,82 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 	append(p_operator);
 }
 
+static GDScriptFunction::Opcode get_typed_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type) {
+	if (p_left_type != p_right_type) {
+		return GDScriptFunction::OPCODE_END;
+	}
+
+	switch (p_left_type) {
+		case Variant::INT:
+			switch (p_operator) {
+				case Variant::OP_ADD:
+					return GDScriptFunction::OPCODE_OPERATOR_ADD_INT;
+				case Variant::OP_SUBTRACT:
+					return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_INT;
+				case Variant::OP_MULTIPLY:
+					return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_INT;
+				case Variant::OP_EQUAL:
+				case Variant::OP_NOT_EQUAL:
+				case Variant::OP_LESS:
+				case Variant::OP_LESS_EQUAL:
+				case Variant::OP_GREATER:
+				case Variant::OP_GREATER_EQUAL:
+					return GDScriptFunction::OPCODE_OPERATOR_COMPARE_INT;
+				default:
+					break;
+			}
+			break;
+		case Variant::FLOAT:
+			switch (p_operator) {
+				case Variant::OP_ADD:
+					return GDScriptFunction::OPCODE_OPERATOR_ADD_FLOAT;
+				case Variant::OP_SUBTRACT:
+					return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_FLOAT;
+				case Variant::OP_MULTIPLY:
+					return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_FLOAT;
+				case Variant::OP_DIVIDE:
+					return GDScriptFunction::OPCODE_OPERATOR_DIVIDE_FLOAT;
+				case Variant::OP_EQUAL:
+				case Variant::OP_NOT_EQUAL:
+				case Variant::OP_LESS:
+				case Variant::OP_LESS_EQUAL:
+				case Variant::OP_GREATER:
+				case Variant::OP_GREATER_EQUAL:
+					return GDScriptFunction::OPCODE_OPERATOR_COMPARE_FLOAT;
+				default:
+					break;
+			}
+			break;
+		case Variant::VECTOR2:
+			switch (p_operator) {
+				case Variant::OP_ADD:
+					return GDScriptFunction::OPCODE_OPERATOR_ADD_VECTOR2;
+				case Variant::OP_SUBTRACT:
+					return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_VECTOR2;
+				case Variant::OP_MULTIPLY:
+					return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR2;
+				default:
+					break;
+			}
+			break;
+		case Variant::VECTOR3:
+			switch (p_operator) {
+				case Variant::OP_ADD:
+					return GDScriptFunction::OPCODE_OPERATOR_ADD_VECTOR3;
+				case Variant::OP_SUBTRACT:
+					return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_VECTOR3;
+				case Variant::OP_MULTIPLY:
+					return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3;
+				default:
+					break;
+			}
+			break;
+		default:
+			break;
+	}
+	return GDScriptFunction::OPCODE_END;
+}
+
 void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand) {
 	// Avoid validated evaluator for modulo and division when operands are int, since there's no check for division by zero.
 	if (HAS_BUILTIN_TYPE(p_left_operand) && HAS_BUILTIN_TYPE(p_right_operand) && ((p_operator != Variant::OP_DIVIDE && p_operator != Variant::OP_MODULE) || p_left_operand.type.builtin_type != Variant::INT || p_right_operand.type.builtin_type != Variant::INT)) {
@@ -591,6 +667,33 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 			}
 		}
 
+		// Use an unboxed opcode for the most common math types.
+		GDScriptFunction::Opcode typed_opcode = get_typed_operator_opcode(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+		if (typed_opcode == GDScriptFunction::OPCODE_OPERATOR_COMPARE_INT || typed_opcode == GDScriptFunction::OPCODE_OPERATOR_COMPARE_FLOAT) {
+			int start = opcodes.size();
+			append_opcode(typed_opcode);
+			append(p_left_operand);
+			append(p_right_operand);
+			append(p_target);
+			append(p_operator);
+			if (p_target.mode == Address::TEMPORARY) {
+				last_typed_comparison.start = start;
+				last_typed_comparison.end = opcodes.size();
+				last_typed_comparison.jump_opcode = typed_opcode == GDScriptFunction::OPCODE_OPERATOR_COMPARE_INT ? GDScriptFunction::OPCODE_JUMP_IF_NOT_COMPARE_INT : GDScriptFunction::OPCODE_JUMP_IF_NOT_COMPARE_FLOAT;
+				last_typed_comparison.op = p_operator;
+				last_typed_comparison.left = p_left_operand;
+				last_typed_comparison.right = p_right_operand;
+				last_typed_comparison.target = p_target;
+			}
+			return;
+		} else if (typed_opcode != GDScriptFunction::OPCODE_END) {
+			append_opcode(typed_opcode);
+			append(p_left_operand);
+			append(p_right_operand);
+			append(p_target);
+			return;
+		}
+
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
@@ -1426,9 +1529,38 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 	append(p_target);
 }
 
+bool GDScriptByteCodeGenerator::fuse_typed_comparison_jump(const Address &p_condition) {
+	TypedComparison &comparison = last_typed_comparison;
+	if (comparison.end != opcodes.size() || p_condition.mode != Address::TEMPORARY || p_condition.address != comparison.target.address) {
+		return false;
+	}
+
+	// Remove the comparison, including the temporary references it added, and compare in the jump instead.
+	const Address addresses[] = { comparison.left, comparison.right, comparison.target };
+	for (const Address &address : addresses) {
+		if (address.mode != Address::TEMPORARY) {
+			continue;
+		}
+		Vector<int> &indices = temporaries.write[address.address].bytecode_indices;
+		while (!indices.is_empty() && indices[indices.size() - 1] >= comparison.start) {
+			indices.remove_at(indices.size() - 1);
+		}
+	}
+	opcodes.resize(comparison.start);
+	comparison.end = -1;
+
+	append_opcode(comparison.jump_opcode);
+	append(comparison.left);
+	append(comparison.right);
+	append(comparison.op);
+	return true;
+}
+
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	if (!fuse_typed_comparison_jump(p_condition)) {
+		append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+		append(p_condition);
+	}
 	if_jmp_addrs.push_back(opcodes.size());
 	append(0); // Jump destination, will be patched.
 }
@@ -1626,8 +1758,10 @@ void GDScriptByteCodeGenerator::start_while_condition() {
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	if (!fuse_typed_comparison_jump(p_condition)) {
+		append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+		append(p_condition);
+	}
 	while_jmp_addrs.push_back(opcodes.size());
 	append(0); // End of loop address, will be patched.
 }
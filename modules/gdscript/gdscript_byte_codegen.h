@@ -159,6 +159,20 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	List<List<int>> current_breaks_to_patch;
 
+	// Last typed comparison written to a temporary, so a conditional jump right after it can test the operands directly.
+	struct TypedComparison {
+		int start = -1;
+		int end = -1;
+		GDScriptFunction::Opcode jump_opcode = GDScriptFunction::OPCODE_END;
+		Variant::Operator op = Variant::OP_MAX;
+		Address left;
+		Address right;
+		Address target;
+	};
+	TypedComparison last_typed_comparison;
+
+	bool fuse_typed_comparison_jump(const Address &p_condition);
+
 	void add_stack_identifier(const StringName &p_id, int p_stackpos) {
 		if (locals.size() > max_locals) {
 			max_locals = locals.size();
@@ -453,6 +467,8 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		// Something jumps to the end of the comparison, so it can't be fused anymore.
+		last_typed_comparison.end = -1;
 	}
 
 public:
@@ -135,6 +135,54 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+
+#define DISASSEMBLE_OPERATOR_TYPED(m_operator, m_v_type)              \
+	case OPCODE_OPERATOR_##m_operator##_##m_v_type: {                 \
+		text += "typed operator (";                                   \
+		text += #m_v_type;                                            \
+		text += ") ";                                                 \
+		text += DADDR(3);                                             \
+		text += " = ";                                                \
+		text += DADDR(1);                                             \
+		text += " ";                                                  \
+		text += Variant::get_operator_name(Variant::OP_##m_operator); \
+		text += " ";                                                  \
+		text += DADDR(2);                                             \
+		incr += 4;                                                    \
+	} break
+
+				DISASSEMBLE_OPERATOR_TYPED(ADD, INT);
+				DISASSEMBLE_OPERATOR_TYPED(SUBTRACT, INT);
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY, INT);
+				DISASSEMBLE_OPERATOR_TYPED(ADD, FLOAT);
+				DISASSEMBLE_OPERATOR_TYPED(SUBTRACT, FLOAT);
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY, FLOAT);
+				DISASSEMBLE_OPERATOR_TYPED(DIVIDE, FLOAT);
+				DISASSEMBLE_OPERATOR_TYPED(ADD, VECTOR2);
+				DISASSEMBLE_OPERATOR_TYPED(SUBTRACT, VECTOR2);
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY, VECTOR2);
+				DISASSEMBLE_OPERATOR_TYPED(ADD, VECTOR3);
+				DISASSEMBLE_OPERATOR_TYPED(SUBTRACT, VECTOR3);
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY, VECTOR3);
+
+#define DISASSEMBLE_OPERATOR_COMPARE(m_v_type)                                    \
+	case OPCODE_OPERATOR_COMPARE_##m_v_type: {                                    \
+		text += "typed operator (";                                               \
+		text += #m_v_type;                                                        \
+		text += ") ";                                                             \
+		text += DADDR(3);                                                         \
+		text += " = ";                                                            \
+		text += DADDR(1);                                                         \
+		text += " ";                                                              \
+		text += Variant::get_operator_name(Variant::Operator(_code_ptr[ip + 4])); \
+		text += " ";                                                              \
+		text += DADDR(2);                                                         \
+		incr += 5;                                                                \
+	} break
+
+				DISASSEMBLE_OPERATOR_COMPARE(INT);
+				DISASSEMBLE_OPERATOR_COMPARE(FLOAT);
+
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -895,6 +943,25 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr = 3;
 			} break;
+
+#define DISASSEMBLE_JUMP_IF_NOT_COMPARE(m_v_type)                                 \
+	case OPCODE_JUMP_IF_NOT_COMPARE_##m_v_type: {                                 \
+		text += "jump-if-not (";                                                  \
+		text += #m_v_type;                                                        \
+		text += ") ";                                                             \
+		text += DADDR(1);                                                         \
+		text += " ";                                                              \
+		text += Variant::get_operator_name(Variant::Operator(_code_ptr[ip + 3])); \
+		text += " ";                                                              \
+		text += DADDR(2);                                                         \
+		text += " to ";                                                           \
+		text += itos(_code_ptr[ip + 4]);                                          \
+		incr = 5;                                                                 \
+	} break
+
+				DISASSEMBLE_JUMP_IF_NOT_COMPARE(INT);
+				DISASSEMBLE_JUMP_IF_NOT_COMPARE(FLOAT);
+
 			case OPCODE_JUMP_TO_DEF_ARGUMENT: {
 				text += "jump-to-default-argument ";
 
@@ -31,6 +31,7 @@
 #include "gdscript_tokenizer.h"
 
 #include "core/error/error_macros.h"
+#include "core/io/marshalls.h"
 #include "core/string/char_utils.h"
 
 #ifdef TOOLS_ENABLED
@@ -234,7 +235,7 @@ String GDScriptTokenizer::get_token_name(Token::Type p_token_type) {
 	return token_names[p_token_type];
 }
 
-void GDScriptTokenizer::set_source_code(const String &p_source_code) {
+void GDScriptTokenizerText::set_source_code(const String &p_source_code) {
 	source = p_source_code;
 	if (source.is_empty()) {
 		_source = U"";
@@ -248,34 +249,34 @@ void GDScriptTokenizer::set_source_code(const String &p_source_code) {
 	position = 0;
 }
 
-void GDScriptTokenizer::set_cursor_position(int p_line, int p_column) {
+void GDScriptTokenizerText::set_cursor_position(int p_line, int p_column) {
 	cursor_line = p_line;
 	cursor_column = p_column;
 }
 
-void GDScriptTokenizer::set_multiline_mode(bool p_state) {
+void GDScriptTokenizerText::set_multiline_mode(bool p_state) {
 	multiline_mode = p_state;
 }
 
-void GDScriptTokenizer::push_expression_indented_block() {
+void GDScriptTokenizerText::push_expression_indented_block() {
 	indent_stack_stack.push_back(indent_stack);
 }
 
-void GDScriptTokenizer::pop_expression_indented_block() {
+void GDScriptTokenizerText::pop_expression_indented_block() {
 	ERR_FAIL_COND(indent_stack_stack.size() == 0);
 	indent_stack = indent_stack_stack.back()->get();
 	indent_stack_stack.pop_back();
 }
 
-int GDScriptTokenizer::get_cursor_line() const {
+int GDScriptTokenizerText::get_cursor_line() const {
 	return cursor_line;
 }
 
-int GDScriptTokenizer::get_cursor_column() const {
+int GDScriptTokenizerText::get_cursor_column() const {
 	return cursor_column;
 }
 
-bool GDScriptTokenizer::is_past_cursor() const {
+bool GDScriptTokenizerText::is_past_cursor() const {
 	if (line < cursor_line) {
 		return false;
 	}
@@ -288,7 +289,7 @@ bool GDScriptTokenizer::is_past_cursor() const {
 	return true;
 }
 
-char32_t GDScriptTokenizer::_advance() {
+char32_t GDScriptTokenizerText::_advance() {
 	if (unlikely(_is_at_end())) {
 		return '\0';
 	}
@@ -307,11 +308,11 @@ char32_t GDScriptTokenizer::_advance() {
 	return _peek(-1);
 }
 
-void GDScriptTokenizer::push_paren(char32_t p_char) {
+void GDScriptTokenizerText::push_paren(char32_t p_char) {
 	paren_stack.push_back(p_char);
 }
 
-bool GDScriptTokenizer::pop_paren(char32_t p_expected) {
+bool GDScriptTokenizerText::pop_paren(char32_t p_expected) {
 	if (paren_stack.is_empty()) {
 		return false;
 	}
@@ -321,13 +322,13 @@ bool GDScriptTokenizer::pop_paren(char32_t p_expected) {
 	return actual == p_expected;
 }
 
-GDScriptTokenizer::Token GDScriptTokenizer::pop_error() {
+GDScriptTokenizer::Token GDScriptTokenizerText::pop_error() {
 	Token error = error_stack.back()->get();
 	error_stack.pop_back();
 	return error;
 }
 
-GDScriptTokenizer::Token GDScriptTokenizer::make_token(Token::Type p_type) {
+GDScriptTokenizer::Token GDScriptTokenizerText::make_token(Token::Type p_type) {
 	Token token(p_type);
 	token.start_line = start_line;
 	token.end_line = line;
@@ -385,35 +386,35 @@ GDScriptTokenizer::Token GDScriptTokenizer::make_token(Token::Type p_type) {
 	return token;
 }
 
-GDScriptTokenizer::Token GDScriptTokenizer::make_literal(const Variant &p_literal) {
+GDScriptTokenizer::Token GDScriptTokenizerText::make_literal(const Variant &p_literal) {
 	Token token = make_token(Token::LITERAL);
 	token.literal = p_literal;
 	return token;
 }
 
-GDScriptTokenizer::Token GDScriptTokenizer::make_identifier(const StringName &p_identifier) {
+GDScriptTokenizer::Token GDScriptTokenizerText::make_identifier(const StringName &p_identifier) {
 	Token identifier = make_token(Token::IDENTIFIER);
 	identifier.literal = p_identifier;
 	return identifier;
 }
 
-GDScriptTokenizer::Token GDScriptTokenizer::make_error(const String &p_message) {
+GDScriptTokenizer::Token GDScriptTokenizerText::make_error(const String &p_message) {
 	Token error = make_token(Token::ERROR);
 	error.literal = p_message;
 
 	return error;
 }
 
-void GDScriptTokenizer::push_error(const String &p_message) {
+void GDScriptTokenizerText::push_error(const String &p_message) {
 	Token error = make_error(p_message);
 	error_stack.push_back(error);
 }
 
-void GDScriptTokenizer::push_error(const Token &p_error) {
+void GDScriptTokenizerText::push_error(const Token &p_error) {
 	error_stack.push_back(p_error);
 }
 
-GDScriptTokenizer::Token GDScriptTokenizer::make_paren_error(char32_t p_paren) {
+GDScriptTokenizer::Token GDScriptTokenizerText::make_paren_error(char32_t p_paren) {
 	if (paren_stack.is_empty()) {
 		return make_error(vformat("Closing \"%c\" doesn't have an opening counterpart.", p_paren));
 	}
@@ -422,7 +423,7 @@ GDScriptTokenizer::Token GDScriptTokenizer::make_paren_error(char32_t p_paren) {
 	return error;
 }
 
-GDScriptTokenizer::Token GDScriptTokenizer::check_vcs_marker(char32_t p_test, Token::Type p_double_type) {
+GDScriptTokenizer::Token GDScriptTokenizerText::check_vcs_marker(char32_t p_test, Token::Type p_double_type) {
 	const char32_t *next = _current + 1;
 	int chars = 2; // Two already matched.
 
@@ -446,7 +447,7 @@ GDScriptTokenizer::Token GDScriptTokenizer::check_vcs_marker(char32_t p_test, To
 	}
 }
 
-GDScriptTokenizer::Token GDScriptTokenizer::annotation() {
+GDScriptTokenizer::Token GDScriptTokenizerText::annotation() {
 	if (is_unicode_identifier_start(_peek())) {
 		_advance(); // Consume start character.
 	} else {
@@ -526,7 +527,7 @@ GDScriptTokenizer::Token GDScriptTokenizer::annotation() {
 #define MAX_KEYWORD_LENGTH 10
 
 #ifdef DEBUG_ENABLED
-void GDScriptTokenizer::make_keyword_list() {
+void GDScriptTokenizerText::make_keyword_list() {
 #define KEYWORD_LINE(keyword, token_type) keyword,
 #define KEYWORD_GROUP_IGNORE(group)
 	keyword_list = {
@@ -537,7 +538,7 @@ void GDScriptTokenizer::make_keyword_list() {
 }
 #endif // DEBUG_ENABLED
 
-GDScriptTokenizer::Token GDScriptTokenizer::potential_identifier() {
+GDScriptTokenizer::Token GDScriptTokenizerText::potential_identifier() {
 	bool only_ascii = _peek(-1) < 128;
 
 	// Consume all identifier characters.
@@ -616,7 +617,7 @@ GDScriptTokenizer::Token GDScriptTokenizer::potential_identifier() {
 #undef MIN_KEYWORD_LENGTH
 #undef KEYWORDS
 
-void GDScriptTokenizer::newline(bool p_make_token) {
+void GDScriptTokenizerText::newline(bool p_make_token) {
 	// Don't overwrite previous newline, nor create if we want a line continuation.
 	if (p_make_token && !pending_newline && !line_continuation) {
 		Token newline(Token::NEWLINE);
@@ -636,7 +637,7 @@ void GDScriptTokenizer::newline(bool p_make_token) {
 	leftmost_column = 1;
 }
 
-GDScriptTokenizer::Token GDScriptTokenizer::number() {
+GDScriptTokenizer::Token GDScriptTokenizerText::number() {
 	int base = 10;
 	bool has_decimal = false;
 	bool has_exponent = false;
@@ -787,7 +788,7 @@ GDScriptTokenizer::Token GDScriptTokenizer::number() {
 	}
 }
 
-GDScriptTokenizer::Token GDScriptTokenizer::string() {
+GDScriptTokenizer::Token GDScriptTokenizerText::string() {
 	enum StringType {
 		STRING_REGULAR,
 		STRING_NAME,
@@ -1044,7 +1045,7 @@ GDScriptTokenizer::Token GDScriptTokenizer::string() {
 	return make_literal(string);
 }
 
-void GDScriptTokenizer::check_indent() {
+void GDScriptTokenizerText::check_indent() {
 	ERR_FAIL_COND_MSG(column != 1, "Checking tokenizer indentation in the middle of a line.");
 
 	if (_is_at_end()) {
@@ -1213,13 +1214,13 @@ void GDScriptTokenizer::check_indent() {
 	}
 }
 
-String GDScriptTokenizer::_get_indent_char_name(char32_t ch) {
+String GDScriptTokenizerText::_get_indent_char_name(char32_t ch) {
 	ERR_FAIL_COND_V(ch != ' ' && ch != '\t', String(&ch, 1).c_escape());
 
 	return ch == ' ' ? "space" : "tab";
 }
 
-void GDScriptTokenizer::_skip_whitespace() {
+void GDScriptTokenizerText::_skip_whitespace() {
 	if (pending_indents != 0) {
 		// Still have some indent/dedent tokens to give.
 		return;
@@ -1281,7 +1282,7 @@ void GDScriptTokenizer::_skip_whitespace() {
 	}
 }
 
-GDScriptTokenizer::Token GDScriptTokenizer::scan() {
+GDScriptTokenizer::Token GDScriptTokenizerText::scan() {
 	if (has_error()) {
 		return pop_error();
 	}
@@ -1346,7 +1347,13 @@ GDScriptTokenizer::Token GDScriptTokenizer::scan() {
 		_advance();
 		newline(false);
 		line_continuation = true;
+#ifdef TOOLS_ENABLED
+		Token next = scan(); // Recurse to get next token.
+		continuation_lines.insert(next.start_line);
+		return next;
+#else
 		return scan(); // Recurse to get next token.
+#endif // TOOLS_ENABLED
 	}
 
 	line_continuation = false;
@@ -1554,7 +1561,7 @@ GDScriptTokenizer::Token GDScriptTokenizer::scan() {
 	}
 }
 
-GDScriptTokenizer::GDScriptTokenizer() {
+GDScriptTokenizerText::GDScriptTokenizerText() {
 #ifdef TOOLS_ENABLED
 	if (EditorSettings::get_singleton()) {
 		tab_size = EditorSettings::get_singleton()->get_setting("text_editor/behavior/indent/size");
@@ -1564,3 +1571,321 @@ GDScriptTokenizer::GDScriptTokenizer() {
 	make_keyword_list();
 #endif // DEBUG_ENABLED
 }
+
+// Binary token buffer.
+//
+// Header: "GDSC" magic, u32 version, u32 string count, u32 constant count, u32 token count.
+// Strings: u32 byte length, UTF-8 bytes. Used for identifier and keyword sources.
+// Constants: u32 byte length, encoded Variant. Used for literal values.
+// Tokens: u32 type and flags, u32 string or constant index (if flagged), u32 start line, u32 start column, u32 end line, u32 end column.
+
+static void _buffer_put_u32(Vector<uint8_t> &r_buffer, uint32_t p_value) {
+	int ofs = r_buffer.size();
+	r_buffer.resize(ofs + 4);
+	encode_uint32(p_value, &r_buffer.write[ofs]);
+}
+
+#ifdef TOOLS_ENABLED
+Vector<uint8_t> GDScriptTokenizerBuffer::parse_code_string(const String &p_code) {
+	GDScriptTokenizerText tokenizer;
+	tokenizer.set_source_code(p_code);
+	// Whitespace tokens are rebuilt from the token positions when reading the buffer, so don't generate them.
+	tokenizer.set_multiline_mode(true);
+
+	Vector<Token> token_list;
+	for (Token token = tokenizer.scan(); token.type != Token::TK_EOF; token = tokenizer.scan()) {
+		ERR_FAIL_COND_V_MSG(token.type == Token::ERROR, Vector<uint8_t>(), "Can't convert GDScript with errors to a token buffer: " + String(token.literal));
+		token_list.push_back(token);
+	}
+
+	HashMap<String, uint32_t> string_map;
+	Vector<String> strings;
+	HashMap<Variant, uint32_t, VariantHasher, VariantComparator> constant_map;
+	Vector<Variant> constants;
+	Vector<uint32_t> headers;
+	Vector<uint32_t> indices;
+	headers.resize(token_list.size());
+	indices.resize(token_list.size());
+
+	const HashSet<int> &continuation_lines = tokenizer.get_continuation_lines();
+	for (int i = 0; i < token_list.size(); i++) {
+		const Token &token = token_list[i];
+		uint32_t header = token.type;
+		uint32_t index = 0;
+
+		if (token.type == Token::LITERAL) {
+			if (!constant_map.has(token.literal)) {
+				constant_map[token.literal] = constants.size();
+				constants.push_back(token.literal);
+			}
+			header |= TOKEN_HAS_LITERAL;
+			index = constant_map[token.literal];
+		} else if (token.source != token_names[token.type]) {
+			if (!string_map.has(token.source)) {
+				string_map[token.source] = strings.size();
+				strings.push_back(token.source);
+			}
+			header |= TOKEN_HAS_SOURCE;
+			index = string_map[token.source];
+		}
+
+		bool first_in_line = i == 0 || token_list[i - 1].end_line < token.start_line;
+		if (first_in_line && continuation_lines.has(token.start_line)) {
+			header |= TOKEN_CONTINUATION;
+		}
+
+		headers.write[i] = header;
+		indices.write[i] = index;
+	}
+
+	Vector<uint8_t> buffer;
+	buffer.resize(4);
+	memcpy(buffer.ptrw(), "GDSC", 4);
+	_buffer_put_u32(buffer, TOKENIZER_VERSION);
+	_buffer_put_u32(buffer, strings.size());
+	_buffer_put_u32(buffer, constants.size());
+	_buffer_put_u32(buffer, token_list.size());
+
+	for (const String &string : strings) {
+		CharString utf8 = string.utf8();
+		_buffer_put_u32(buffer, utf8.length());
+		int ofs = buffer.size();
+		buffer.resize(ofs + utf8.length());
+		memcpy(&buffer.write[ofs], utf8.get_data(), utf8.length());
+	}
+
+	for (const Variant &constant : constants) {
+		int len = 0;
+		Error err = encode_variant(constant, nullptr, len);
+		ERR_FAIL_COND_V(err != OK, Vector<uint8_t>());
+		_buffer_put_u32(buffer, len);
+		int ofs = buffer.size();
+		buffer.resize(ofs + len);
+		encode_variant(constant, &buffer.write[ofs], len);
+	}
+
+	for (int i = 0; i < token_list.size(); i++) {
+		const Token &token = token_list[i];
+		_buffer_put_u32(buffer, headers[i]);
+		if (headers[i] & (TOKEN_HAS_SOURCE | TOKEN_HAS_LITERAL)) {
+			_buffer_put_u32(buffer, indices[i]);
+		}
+		_buffer_put_u32(buffer, token.start_line);
+		_buffer_put_u32(buffer, token.start_column);
+		_buffer_put_u32(buffer, token.end_line);
+		_buffer_put_u32(buffer, token.end_column);
+	}
+
+	return buffer;
+}
+#endif // TOOLS_ENABLED
+
+bool GDScriptTokenizerBuffer::is_code_buffer(const Vector<uint8_t> &p_buffer) {
+	return p_buffer.size() >= 8 && memcmp(p_buffer.ptr(), "GDSC", 4) == 0;
+}
+
+Error GDScriptTokenizerBuffer::set_code_buffer(const Vector<uint8_t> &p_buffer) {
+	ERR_FAIL_COND_V_MSG(!is_code_buffer(p_buffer), ERR_INVALID_DATA, "Invalid GDScript token buffer.");
+
+	const uint8_t *buf = p_buffer.ptr();
+	const int total_len = p_buffer.size();
+	const uint32_t version = decode_uint32(&buf[4]);
+	ERR_FAIL_COND_V_MSG(version != TOKENIZER_VERSION, ERR_INVALID_DATA, vformat("Unsupported GDScript token buffer version %d (expected %d). Export the project again.", version, TOKENIZER_VERSION));
+	ERR_FAIL_COND_V(total_len < 20, ERR_INVALID_DATA);
+
+	const uint32_t string_count = decode_uint32(&buf[8]);
+	const uint32_t constant_count = decode_uint32(&buf[12]);
+	const uint32_t token_count = decode_uint32(&buf[16]);
+	int ofs = 20;
+
+	Vector<String> strings;
+	strings.resize(string_count);
+	for (uint32_t i = 0; i < string_count; i++) {
+		ERR_FAIL_COND_V(total_len - ofs < 4, ERR_INVALID_DATA);
+		const uint32_t len = decode_uint32(&buf[ofs]);
+		ofs += 4;
+		ERR_FAIL_COND_V(len > uint32_t(total_len - ofs), ERR_INVALID_DATA);
+		strings.write[i].parse_utf8((const char *)&buf[ofs], len);
+		ofs += len;
+	}
+
+	Vector<Variant> constants;
+	constants.resize(constant_count);
+	for (uint32_t i = 0; i < constant_count; i++) {
+		ERR_FAIL_COND_V(total_len - ofs < 4, ERR_INVALID_DATA);
+		const uint32_t len = decode_uint32(&buf[ofs]);
+		ofs += 4;
+		ERR_FAIL_COND_V(len > uint32_t(total_len - ofs), ERR_INVALID_DATA);
+		Error err = decode_variant(constants.write[i], &buf[ofs], len);
+		ERR_FAIL_COND_V(err != OK, err);
+		ofs += len;
+	}
+
+	tokens.resize(token_count);
+	continuations.resize(token_count);
+	for (uint32_t i = 0; i < token_count; i++) {
+		ERR_FAIL_COND_V(total_len - ofs < 20, ERR_INVALID_DATA);
+		const uint32_t header = decode_uint32(&buf[ofs]);
+		ofs += 4;
+		const uint32_t type = header & TOKEN_TYPE_MASK;
+		ERR_FAIL_COND_V(type >= Token::TK_MAX, ERR_INVALID_DATA);
+
+		Token &token = tokens.write[i];
+		token.type = Token::Type(type);
+		if (header & (TOKEN_HAS_SOURCE | TOKEN_HAS_LITERAL)) {
+			const uint32_t index = decode_uint32(&buf[ofs]);
+			ofs += 4;
+			ERR_FAIL_COND_V(total_len - ofs < 16, ERR_INVALID_DATA);
+			if (header & TOKEN_HAS_LITERAL) {
+				ERR_FAIL_COND_V(index >= constant_count, ERR_INVALID_DATA);
+				token.literal = constants[index];
+			} else {
+				ERR_FAIL_COND_V(index >= string_count, ERR_INVALID_DATA);
+				token.source = strings[index];
+			}
+		} else if (token.type != Token::LITERAL) {
+			token.source = token_names[type];
+		}
+		if (token.type == Token::IDENTIFIER || token.type == Token::ANNOTATION) {
+			token.literal = StringName(token.source);
+		}
+
+		token.start_line = decode_uint32(&buf[ofs]);
+		token.start_column = decode_uint32(&buf[ofs + 4]);
+		token.end_line = decode_uint32(&buf[ofs + 8]);
+		token.end_column = decode_uint32(&buf[ofs + 12]);
+		token.leftmost_column = MIN(token.start_column, token.end_column);
+		token.rightmost_column = MAX(token.start_column, token.end_column);
+		ofs += 16;
+
+		continuations.write[i] = header & TOKEN_CONTINUATION;
+	}
+
+	current = 0;
+	line_checked = -1;
+	reached_end = false;
+	pending_indents = 0;
+	indent_stack.clear();
+	indent_stack_stack.clear();
+
+	return OK;
+}
+
+void GDScriptTokenizerBuffer::set_multiline_mode(bool p_state) {
+	multiline_mode = p_state;
+}
+
+void GDScriptTokenizerBuffer::push_expression_indented_block() {
+	indent_stack_stack.push_back(indent_stack);
+}
+
+void GDScriptTokenizerBuffer::pop_expression_indented_block() {
+	ERR_FAIL_COND(indent_stack_stack.size() == 0);
+	indent_stack = indent_stack_stack.back()->get();
+	indent_stack_stack.pop_back();
+}
+
+GDScriptTokenizer::Token GDScriptTokenizerBuffer::_make_newline_token(const Token &p_previous) const {
+	Token newline(Token::NEWLINE);
+	newline.start_line = p_previous.end_line;
+	newline.end_line = p_previous.end_line;
+	newline.start_column = p_previous.end_column;
+	newline.end_column = p_previous.end_column + 1;
+	newline.leftmost_column = newline.start_column;
+	newline.rightmost_column = newline.end_column;
+	return newline;
+}
+
+GDScriptTokenizer::Token GDScriptTokenizerBuffer::_make_indent_token() {
+	// Like the text tokenizer, indentation spans from the beginning of the line to the next token.
+	int line = 1;
+	int column = 1;
+	if (current < tokens.size()) {
+		line = tokens[current].start_line;
+		column = tokens[current].start_column;
+	} else if (!tokens.is_empty()) {
+		line = tokens[tokens.size() - 1].end_line + 1;
+	}
+
+	Token token;
+	token.start_line = line;
+	token.end_line = line;
+	token.start_column = 1;
+	token.leftmost_column = 1;
+	if (pending_indents > 0) {
+		pending_indents--;
+		token.type = Token::INDENT;
+		token.end_column = column;
+	} else {
+		pending_indents++;
+		token.type = Token::DEDENT;
+		token.end_column = column + 1;
+	}
+	token.rightmost_column = token.end_column;
+	return token;
+}
+
+GDScriptTokenizer::Token GDScriptTokenizerBuffer::scan() {
+	if (pending_indents != 0) {
+		return _make_indent_token();
+	}
+
+	if (current >= tokens.size()) {
+		if (!reached_end) {
+			reached_end = true;
+			// Send dedents for every indent level.
+			pending_indents -= indent_stack.size();
+			indent_stack.clear();
+			if (!multiline_mode && !tokens.is_empty()) {
+				return _make_newline_token(tokens[tokens.size() - 1]);
+			}
+			if (pending_indents != 0) {
+				return _make_indent_token();
+			}
+		}
+		Token eof(Token::TK_EOF);
+		eof.start_line = tokens.is_empty() ? 1 : tokens[tokens.size() - 1].end_line + 1;
+		eof.end_line = eof.start_line;
+		eof.start_column = 1;
+		eof.end_column = 1;
+		eof.leftmost_column = 1;
+		eof.rightmost_column = 1;
+		return eof;
+	}
+
+	if (line_checked < current) {
+		// First time reaching this token, check if it starts a new line.
+		line_checked = current;
+		const Token &next = tokens[current];
+		const bool line_start = current == 0 || (next.start_line > tokens[current - 1].end_line && !continuations[current]);
+
+		// Same as in GDScriptTokenizerText::check_indent(), but the indentation is known from the token column.
+		if (line_start && !multiline_mode) {
+			const int indent_count = next.start_column - 1;
+			const int previous_indent = indent_stack.is_empty() ? 0 : indent_stack.back()->get();
+			if (indent_count > previous_indent) {
+				indent_stack.push_back(indent_count);
+				pending_indents++;
+			} else if (indent_count < previous_indent) {
+				while (!indent_stack.is_empty() && indent_stack.back()->get() > indent_count) {
+					indent_stack.pop_back();
+					pending_indents--;
+				}
+				if ((!indent_stack.is_empty() && indent_stack.back()->get() != indent_count) || (indent_stack.is_empty() && indent_count != 0)) {
+					// Mismatched indentation alignment, which is an error in source, so the buffer can't have it.
+					// Still, keep the level in the stack like the text tokenizer does.
+					indent_stack.push_back(indent_count);
+				}
+			}
+
+			if (current > 0) {
+				return _make_newline_token(tokens[current - 1]);
+			}
+			if (pending_indents != 0) {
+				return _make_indent_token();
+			}
+		}
+	}
+
+	return tokens[current++];
+}
@@ -193,11 +193,25 @@ public:
 			new_line = p_new_line;
 		}
 	};
-	const HashMap<int, CommentData> &get_comments() const {
-		return comments;
-	}
+	virtual const HashMap<int, CommentData> &get_comments() const = 0;
 #endif // TOOLS_ENABLED
 
+	static String get_token_name(Token::Type p_token_type);
+
+	virtual int get_cursor_line() const = 0;
+	virtual int get_cursor_column() const = 0;
+	virtual void set_cursor_position(int p_line, int p_column) = 0;
+	virtual void set_multiline_mode(bool p_state) = 0;
+	virtual bool is_past_cursor() const = 0;
+	virtual void push_expression_indented_block() = 0; // For lambdas, or blocks inside expressions.
+	virtual void pop_expression_indented_block() = 0; // For lambdas, or blocks inside expressions.
+
+	virtual Token scan() = 0;
+
+	virtual ~GDScriptTokenizer() {}
+};
+
+class GDScriptTokenizerText : public GDScriptTokenizer {
 private:
 	String source;
 	const char32_t *_source = nullptr;
@@ -230,6 +244,7 @@ private:
 
 #ifdef TOOLS_ENABLED
 	HashMap<int, CommentData> comments;
+	HashSet<int> continuation_lines; // Lines whose first token follows a line continuation with backslash.
 #endif // TOOLS_ENABLED
 
 	_FORCE_INLINE_ bool _is_at_end() { return position >= length; }
@@ -264,20 +279,85 @@ private:
 	Token annotation();
 
 public:
-	Token scan();
-
 	void set_source_code(const String &p_source_code);
 
-	int get_cursor_line() const;
-	int get_cursor_column() const;
-	void set_cursor_position(int p_line, int p_column);
-	void set_multiline_mode(bool p_state);
-	bool is_past_cursor() const;
-	static String get_token_name(Token::Type p_token_type);
-	void push_expression_indented_block(); // For lambdas, or blocks inside expressions.
-	void pop_expression_indented_block(); // For lambdas, or blocks inside expressions.
+	virtual int get_cursor_line() const override;
+	virtual int get_cursor_column() const override;
+	virtual void set_cursor_position(int p_line, int p_column) override;
+	virtual void set_multiline_mode(bool p_state) override;
+	virtual bool is_past_cursor() const override;
+	virtual void push_expression_indented_block() override; // For lambdas, or blocks inside expressions.
+	virtual void pop_expression_indented_block() override; // For lambdas, or blocks inside expressions.
+
+	virtual Token scan() override;
+
+#ifdef TOOLS_ENABLED
+	virtual const HashMap<int, CommentData> &get_comments() const override {
+		return comments;
+	}
+	const HashSet<int> &get_continuation_lines() const {
+		return continuation_lines;
+	}
+#endif // TOOLS_ENABLED
+
+	GDScriptTokenizerText();
+};
+
+// Replays tokens stored by `parse_code_string()`, so exported scripts don't need to be tokenized again.
+// Whitespace tokens (newlines and indentation) are not stored, but rebuilt from the token positions.
+class GDScriptTokenizerBuffer : public GDScriptTokenizer {
+public:
+	enum {
+		TOKEN_TYPE_MASK = 0xFF,
+		TOKEN_HAS_SOURCE = 1 << 8,
+		TOKEN_HAS_LITERAL = 1 << 9,
+		TOKEN_CONTINUATION = 1 << 10, // Token follows a line continuation with backslash.
+	};
 
-	GDScriptTokenizer();
+	static const uint32_t TOKENIZER_VERSION = 1;
+
+private:
+	Vector<Token> tokens;
+	Vector<bool> continuations;
+	int current = 0;
+	int line_checked = -1; // Last token whose line start was already handled.
+
+	bool multiline_mode = false;
+	bool reached_end = false;
+	int pending_indents = 0;
+	List<int> indent_stack;
+	List<List<int>> indent_stack_stack; // For lambdas, which require manipulating the indentation point.
+
+#ifdef TOOLS_ENABLED
+	HashMap<int, CommentData> dummy_comments;
+#endif // TOOLS_ENABLED
+
+	Token _make_newline_token(const Token &p_previous) const;
+	Token _make_indent_token();
+
+public:
+#ifdef TOOLS_ENABLED
+	static Vector<uint8_t> parse_code_string(const String &p_code);
+#endif // TOOLS_ENABLED
+	static bool is_code_buffer(const Vector<uint8_t> &p_buffer);
+
+	Error set_code_buffer(const Vector<uint8_t> &p_buffer);
+
+	virtual int get_cursor_line() const override { return -1; }
+	virtual int get_cursor_column() const override { return -1; }
+	virtual void set_cursor_position(int p_line, int p_column) override {}
+	virtual void set_multiline_mode(bool p_state) override;
+	virtual bool is_past_cursor() const override { return false; }
+	virtual void push_expression_indented_block() override;
+	virtual void pop_expression_indented_block() override;
+
+	virtual Token scan() override;
+
+#ifdef TOOLS_ENABLED
+	virtual const HashMap<int, CommentData> &get_comments() const override {
+		return dummy_comments;
+	}
+#endif // TOOLS_ENABLED
 };
 
 #endif // GDSCRIPT_TOKENIZER_H
@@ -0,0 +1,161 @@
+/**************************************************************************/
+/*  gdscript_tracer.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_tracer.h"
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "gdscript_function.h"
+
+TraceRecorder GDScriptTracer::recorder;
+
+void GDScriptTracer::function_called(const GDScriptFunction *p_function, uint64_t p_begin) {
+	const uint32_t name = recorder.get_name_index(p_function->trace_key, [p_function]() {
+		return String(p_function->name) + " (" + String(p_function->source) + ":" + itos(p_function->_initial_line) + ")";
+	});
+	recorder.record(name, p_begin, OS::get_singleton()->get_ticks_usec());
+}
+
+void GDScriptTracer::start(uint32_t p_events_per_thread) {
+	recorder.start(p_events_per_thread);
+}
+
+void GDScriptTracer::stop() {
+	recorder.stop();
+}
+
+void GDScriptTracer::clear() {
+	recorder.clear();
+}
+
+Error GDScriptTracer::_save_folded_stacks(const String &p_path) {
+	struct SortedEvent {
+		TraceRecorder::Event event;
+		uint32_t index = 0;
+
+		bool contains(const SortedEvent &p_other) const {
+			// Calls are recorded when they return, so a caller is always recorded after its callees.
+			return index > p_other.index && event.begin <= p_other.event.begin && p_other.event.end <= event.end;
+		}
+	};
+
+	struct SortedEventComparator {
+		_FORCE_INLINE_ bool operator()(const SortedEvent &p_a, const SortedEvent &p_b) const {
+			// Callers first.
+			if (p_a.event.begin != p_b.event.begin) {
+				return p_a.event.begin < p_b.event.begin;
+			}
+			if (p_a.event.end != p_b.event.end) {
+				return p_a.event.end > p_b.event.end;
+			}
+			return p_a.index > p_b.index;
+		}
+	};
+
+	struct Frame {
+		SortedEvent event;
+		String stack;
+		uint64_t children_time = 0;
+	};
+
+	LocalVector<TraceRecorder::ThreadEvents> threads;
+	recorder.get_events(threads);
+
+	HashMap<String, uint64_t> self_times;
+	const auto add_self_time = [&self_times](const Frame &p_frame) {
+		const uint64_t total_time = p_frame.event.event.end - p_frame.event.event.begin;
+		const uint64_t self_time = total_time - MIN(p_frame.children_time, total_time);
+		if (HashMap<String, uint64_t>::Iterator E = self_times.find(p_frame.stack)) {
+			E->value += self_time;
+		} else {
+			self_times.insert(p_frame.stack, self_time);
+		}
+	};
+
+	for (const TraceRecorder::ThreadEvents &thread_events : threads) {
+		// Rebuild the call stacks from the calls, ordered by the time they started at.
+		LocalVector<SortedEvent> events;
+		events.resize(thread_events.events.size());
+		for (uint32_t i = 0; i < events.size(); i++) {
+			events[i].event = thread_events.events[i];
+			events[i].index = i;
+		}
+		events.sort_custom<SortedEventComparator>();
+
+		LocalVector<Frame> stack;
+		for (const SortedEvent &event : events) {
+			while (!stack.is_empty() && !stack[stack.size() - 1].event.contains(event)) {
+				add_self_time(stack[stack.size() - 1]);
+				stack.resize(stack.size() - 1);
+			}
+
+			Frame frame;
+			frame.event = event;
+			frame.stack = recorder.get_name(event.event.name);
+			if (!stack.is_empty()) {
+				Frame &caller = stack[stack.size() - 1];
+				caller.children_time += event.event.end - event.event.begin;
+				frame.stack = caller.stack + ";" + frame.stack;
+			}
+			stack.push_back(frame);
+		}
+		while (!stack.is_empty()) {
+			add_self_time(stack[stack.size() - 1]);
+			stack.resize(stack.size() - 1);
+		}
+	}
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, "Cannot open file '" + p_path + "' to save the GDScript trace.");
+
+	for (const KeyValue<String, uint64_t> &E : self_times) {
+		if (E.value > 0) {
+			f->store_line(E.key + " " + itos(E.value));
+		}
+	}
+
+	return OK;
+}
+
+Error GDScriptTracer::save(const String &p_path, Format p_format) {
+	ERR_FAIL_COND_V_MSG(recorder.is_recording(), ERR_BUSY, "Stop tracing before saving the GDScript trace.");
+	switch (p_format) {
+		case FORMAT_CHROME_TRACE:
+			return recorder.save_chrome_trace(p_path);
+		case FORMAT_FOLDED_STACKS:
+			return _save_folded_stacks(p_path);
+	}
+	return ERR_INVALID_PARAMETER;
+}
+
+GDScriptTracer::Format GDScriptTracer::get_format_for_path(const String &p_path) {
+	return p_path.get_extension().to_lower() == "json" ? FORMAT_CHROME_TRACE : FORMAT_FOLDED_STACKS;
+}
@@ -0,0 +1,66 @@
+/**************************************************************************/
+/*  gdscript_tracer.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_TRACER_H
+#define GDSCRIPT_TRACER_H
+
+#include "core/debugger/trace_recorder.h"
+
+class GDScriptFunction;
+
+// Records every GDScript function call, so the call timeline can be written to a file
+// without a debugger connection. Calls are recorded when they return, and the oldest
+// ones are overwritten once the buffer of their thread is full.
+class GDScriptTracer {
+public:
+	enum Format {
+		FORMAT_CHROME_TRACE, // JSON, for chrome://tracing, Perfetto and speedscope.
+		FORMAT_FOLDED_STACKS, // One line per stack with its self time, for flamegraph.pl and friends.
+	};
+
+private:
+	static TraceRecorder recorder;
+
+	static Error _save_folded_stacks(const String &p_path);
+
+public:
+	static _FORCE_INLINE_ bool is_active() { return recorder.is_recording(); }
+
+	static void start(uint32_t p_events_per_thread);
+	static void stop();
+	static void clear();
+	static Error save(const String &p_path, Format p_format);
+	static Format get_format_for_path(const String &p_path);
+
+	// `p_begin` is the time the call started at, in microseconds.
+	static void function_called(const GDScriptFunction *p_function, uint64_t p_begin);
+};
+
+#endif // GDSCRIPT_TRACER_H
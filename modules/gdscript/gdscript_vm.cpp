@@ -34,6 +34,7 @@
 #include "core/os/os.h"
 #include "gdscript.h"
 #include "gdscript_lambda_callable.h"
+#include "gdscript_tracer.h"
 
 #ifdef DEBUG_ENABLED
 static String _get_script_name(const Ref<Script> p_script) {
@@ -201,6 +202,21 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {        \
 		&&OPCODE_OPERATOR,                           \
 		&&OPCODE_OPERATOR_VALIDATED,                 \
+		&&OPCODE_OPERATOR_ADD_INT,                   \
+		&&OPCODE_OPERATOR_SUBTRACT_INT,              \
+		&&OPCODE_OPERATOR_MULTIPLY_INT,              \
+		&&OPCODE_OPERATOR_COMPARE_INT,               \
+		&&OPCODE_OPERATOR_ADD_FLOAT,                 \
+		&&OPCODE_OPERATOR_SUBTRACT_FLOAT,            \
+		&&OPCODE_OPERATOR_MULTIPLY_FLOAT,            \
+		&&OPCODE_OPERATOR_DIVIDE_FLOAT,              \
+		&&OPCODE_OPERATOR_COMPARE_FLOAT,             \
+		&&OPCODE_OPERATOR_ADD_VECTOR2,               \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR2,          \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR2,          \
+		&&OPCODE_OPERATOR_ADD_VECTOR3,               \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR3,          \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3,          \
 		&&OPCODE_TYPE_TEST_BUILTIN,                  \
 		&&OPCODE_TYPE_TEST_ARRAY,                    \
 		&&OPCODE_TYPE_TEST_NATIVE,                   \
@@ -289,6 +305,8 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_JUMP,                               \
 		&&OPCODE_JUMP_IF,                            \
 		&&OPCODE_JUMP_IF_NOT,                        \
+		&&OPCODE_JUMP_IF_NOT_COMPARE_INT,            \
+		&&OPCODE_JUMP_IF_NOT_COMPARE_FLOAT,          \
 		&&OPCODE_JUMP_TO_DEF_ARGUMENT,               \
 		&&OPCODE_JUMP_IF_SHARED,                     \
 		&&OPCODE_RETURN,                             \
@@ -449,6 +467,27 @@ void (*type_init_function_table[])(Variant *) = {
 #define OP_GET_BASIS get_basis
 #define OP_GET_RID get_rid
 
+// Comparison for the typed operator and jump opcodes, which store the operator as an argument.
+template <class T>
+static _FORCE_INLINE_ bool _compare_typed(Variant::Operator p_operator, const T &p_left, const T &p_right) {
+	switch (p_operator) {
+		case Variant::OP_EQUAL:
+			return p_left == p_right;
+		case Variant::OP_NOT_EQUAL:
+			return p_left != p_right;
+		case Variant::OP_LESS:
+			return p_left < p_right;
+		case Variant::OP_LESS_EQUAL:
+			return p_left <= p_right;
+		case Variant::OP_GREATER:
+			return p_left > p_right;
+		case Variant::OP_GREATER_EQUAL:
+			return p_left >= p_right;
+		default:
+			return false;
+	}
+}
+
 #define METHOD_CALL_ON_NULL_VALUE_ERROR(method_pointer) "Cannot call method '" + (method_pointer)->get_name() + "' on a null value."
 #define METHOD_CALL_ON_FREED_INSTANCE_ERROR(method_pointer) "Cannot call method '" + (method_pointer)->get_name() + "' on a previously freed instance."
 
@@ -665,6 +704,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #define GET_INSTRUCTION_ARG(m_v, m_idx) \
 	Variant *m_v = instruction_args[m_idx]
 
+	uint64_t trace_begin = 0;
+	if (unlikely(GDScriptTracer::is_active())) {
+		trace_begin = OS::get_singleton()->get_ticks_usec();
+	}
+
 #ifdef DEBUG_ENABLED
 
 	uint64_t function_start_time = 0;
@@ -745,6 +789,46 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_OPERATOR_TYPED(m_operator, m_v_type, m_op)                                                                              \
+	OPCODE(OPCODE_OPERATOR_##m_operator##_##m_v_type) {                                                                                \
+		CHECK_SPACE(4);                                                                                                                \
+		GET_VARIANT_PTR(a, 0);                                                                                                         \
+		GET_VARIANT_PTR(b, 1);                                                                                                         \
+		GET_VARIANT_PTR(dst, 2);                                                                                                       \
+		*VariantInternal::OP_GET_##m_v_type(dst) = *VariantInternal::OP_GET_##m_v_type(a) m_op *VariantInternal::OP_GET_##m_v_type(b); \
+		ip += 4;                                                                                                                       \
+	}                                                                                                                                  \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_TYPED(ADD, INT, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT, INT, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY, INT, *);
+			OPCODE_OPERATOR_TYPED(ADD, FLOAT, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT, FLOAT, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY, FLOAT, *);
+			OPCODE_OPERATOR_TYPED(DIVIDE, FLOAT, /);
+			OPCODE_OPERATOR_TYPED(ADD, VECTOR2, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT, VECTOR2, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY, VECTOR2, *);
+			OPCODE_OPERATOR_TYPED(ADD, VECTOR3, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT, VECTOR3, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY, VECTOR3, *);
+
+#define OPCODE_OPERATOR_COMPARE(m_v_type)                                                                                                     \
+	OPCODE(OPCODE_OPERATOR_COMPARE_##m_v_type) {                                                                                              \
+		CHECK_SPACE(5);                                                                                                                       \
+		GET_VARIANT_PTR(a, 0);                                                                                                                \
+		GET_VARIANT_PTR(b, 1);                                                                                                                \
+		GET_VARIANT_PTR(dst, 2);                                                                                                              \
+		Variant::Operator op = (Variant::Operator)_code_ptr[ip + 4];                                                                          \
+		*VariantInternal::get_bool(dst) = _compare_typed(op, *VariantInternal::OP_GET_##m_v_type(a), *VariantInternal::OP_GET_##m_v_type(b)); \
+		ip += 5;                                                                                                                              \
+	}                                                                                                                                         \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_COMPARE(INT);
+			OPCODE_OPERATOR_COMPARE(FLOAT);
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -2501,6 +2585,25 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_JUMP_IF_NOT_COMPARE(m_v_type)                                                                       \
+	OPCODE(OPCODE_JUMP_IF_NOT_COMPARE_##m_v_type) {                                                                \
+		CHECK_SPACE(5);                                                                                            \
+		GET_VARIANT_PTR(a, 0);                                                                                     \
+		GET_VARIANT_PTR(b, 1);                                                                                     \
+		Variant::Operator op = (Variant::Operator)_code_ptr[ip + 3];                                               \
+		if (!_compare_typed(op, *VariantInternal::OP_GET_##m_v_type(a), *VariantInternal::OP_GET_##m_v_type(b))) { \
+			int to = _code_ptr[ip + 4];                                                                            \
+			GD_ERR_BREAK(to < 0 || to > _code_size);                                                               \
+			ip = to;                                                                                               \
+		} else {                                                                                                   \
+			ip += 5;                                                                                               \
+		}                                                                                                          \
+	}                                                                                                              \
+	DISPATCH_OPCODE
+
+			OPCODE_JUMP_IF_NOT_COMPARE(INT);
+			OPCODE_JUMP_IF_NOT_COMPARE(FLOAT);
+
 			OPCODE(OPCODE_JUMP_TO_DEF_ARGUMENT) {
 				CHECK_SPACE(2);
 				ip = _default_arg_ptr[defarg];
@@ -3603,6 +3706,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	}
 
 	OPCODES_OUT
+	if (unlikely(trace_begin)) {
+		GDScriptTracer::function_called(this, trace_begin);
+	}
+
 #ifdef DEBUG_ENABLED
 	if (GDScriptLanguage::get_singleton()->profiling) {
 		uint64_t time_taken = OS::get_singleton()->get_ticks_usec() - function_start_time;
@@ -30,6 +30,7 @@
 
 #include "register_types.h"
 
+#include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
@@ -37,6 +38,7 @@
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
 #include "gdscript_cache.h"
+#include "gdscript_parser.h"
 #include "gdscript_tokenizer.h"
 #include "gdscript_utility_functions.h"
 
@@ -83,7 +85,22 @@ public:
 			return;
 		}
 
-		return;
+		if (!GLOBAL_GET("editor/export/convert_gdscript_to_binary_tokens")) {
+			return;
+		}
+
+		// Scripts with parse errors are exported as source, so the errors are still reported when loading them.
+		String source = GDScriptCache::get_source_code(p_path);
+		GDScriptParser parser;
+		if (parser.parse(source, p_path, false) != OK) {
+			return;
+		}
+
+		Vector<uint8_t> buffer = GDScriptTokenizerBuffer::parse_code_string(source);
+		if (buffer.is_empty()) {
+			return;
+		}
+		add_file(p_path.get_basename() + ".gdc", buffer, true);
 	}
 
 	virtual String _get_name() const override { return "GDScript"; }
@@ -32,6 +32,11 @@
 #define GDSCRIPT_TEST_RUNNER_SUITE_H
 
 #include "gdscript_test_runner.h"
+
+#include "core/io/json.h"
+#include "modules/gdscript/gdscript_parser.h"
+#include "modules/gdscript/gdscript_tokenizer.h"
+#include "modules/gdscript/gdscript_tracer.h"
 #include "tests/test_macros.h"
 
 namespace GDScriptTests {
@@ -70,6 +75,87 @@ func _init():
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
 
+TEST_CASE("[Modules][GDScript] Binary tokens replay the source tokens") {
+	const String source = R"(extends RefCounted
+
+# Comment.
+var value := 1 + \
+		2
+
+func _init():
+	if value == 3:
+		var callback := func():
+			return "done"
+		set_meta("result", callback.call())
+	else:
+		pass
+)";
+	const Vector<uint8_t> buffer = GDScriptTokenizerBuffer::parse_code_string(source);
+	REQUIRE_FALSE(buffer.is_empty());
+
+	GDScriptTokenizerText text_tokenizer;
+	text_tokenizer.set_source_code(source);
+	GDScriptTokenizerBuffer buffer_tokenizer;
+	REQUIRE(buffer_tokenizer.set_code_buffer(buffer) == OK);
+
+	// Whitespace tokens aren't stored, so this checks they are rebuilt the same way.
+	for (;;) {
+		const GDScriptTokenizer::Token expected = text_tokenizer.scan();
+		const GDScriptTokenizer::Token token = buffer_tokenizer.scan();
+		REQUIRE_MESSAGE(token.type == expected.type, vformat("Expected %s on line %d, got %s.", expected.get_name(), expected.start_line, token.get_name()));
+		CHECK(token.literal == expected.literal);
+		if (expected.type == GDScriptTokenizer::Token::TK_EOF) {
+			break;
+		}
+		if (expected.type != GDScriptTokenizer::Token::DEDENT) {
+			// The text tokenizer places the final dedents past the last line.
+			CHECK(token.start_line == expected.start_line);
+			CHECK(token.start_column == expected.start_column);
+		}
+	}
+
+	GDScriptParser parser;
+	CHECK_MESSAGE(parser.parse_binary(buffer, "res://binary_tokens.gd") == OK, "The binary tokens should parse successfully.");
+}
+
+TEST_CASE("[Modules][GDScript] Tracer records nested calls") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func _init():
+	for i in 3:
+		helper()
+
+func helper():
+	OS.delay_usec(100)
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+	GDScriptTracer::start(1024);
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+	GDScriptTracer::stop();
+
+	const String folded_path = OS::get_singleton()->get_cache_path().path_join("gdscript_trace.folded");
+	CHECK(GDScriptTracer::save(folded_path, GDScriptTracer::get_format_for_path(folded_path)) == OK);
+	const String folded = FileAccess::get_file_as_string(folded_path);
+	CHECK(folded.contains("_init ("));
+	CHECK_MESSAGE(folded.contains(";helper ("), "The nested call should be recorded below its caller.");
+
+	const String json_path = OS::get_singleton()->get_cache_path().path_join("gdscript_trace.json");
+	CHECK(GDScriptTracer::save(json_path, GDScriptTracer::get_format_for_path(json_path)) == OK);
+	const Dictionary trace = JSON::parse_string(FileAccess::get_file_as_string(json_path));
+	const Array events = trace["traceEvents"];
+	// Three calls to `helper()` and one to `_init()`, besides the implicit initializer and the thread name.
+	CHECK(events.size() >= 5);
+
+	GDScriptTracer::clear();
+}
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
@@ -0,0 +1,48 @@
+func test():
+	var a: int = 7
+	var b: int = 3
+	print(a + b)
+	print(a - b)
+	print(a * b)
+	print(a < b, " ", a >= b, " ", a == 7, " ", a != 7)
+
+	var x: float = 2.5
+	var y: float = 0.5
+	print(x + y)
+	print(x - y)
+	print(x * y)
+	print(x / y)
+	print(x > y, " ", x <= y)
+
+	var u := Vector2(1, 2)
+	var v := Vector2(3, 4)
+	print(u + v)
+	print(v - u)
+	print(u * v)
+
+	var p := Vector3(1, 2, 3)
+	var q := Vector3(4, 5, 6)
+	print(p + q)
+	print(q - p)
+	print(p * q)
+
+	# Comparisons used as conditions jump directly.
+	var count: int = 0
+	while count < 5:
+		count += 1
+	print(count)
+
+	var value: float = 0.0
+	while value <= 1.0:
+		value += 0.25
+	print(value)
+
+	if a > b:
+		print("int greater")
+	else:
+		print("int not greater")
+
+	if x < y:
+		print("float less")
+	elif x != y:
+		print("float not equal")
@@ -84,6 +84,13 @@ using namespace NavigationUtilities;
 GodotNavigationServer::GodotNavigationServer() {}
 
 GodotNavigationServer::~GodotNavigationServer() {
+	// Pending path query results are discarded, nothing should receive callbacks from here.
+	_wait_for_path_query_batches();
+	for (PathQueryBatch *batch : path_query_batches) {
+		memdelete(batch);
+	}
+	path_query_batches.clear();
+
 	flush_queries();
 }
 
@@ -784,15 +791,24 @@ void GodotNavigationServer::map_force_update(RID p_map) {
 	NavMap *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_COND(map == nullptr);
 
+	// Path queries must not run while the map changes.
+	_pause_path_query_batches();
 	flush_queries();
 
 	map->sync();
+	_resume_path_query_batches();
 }
 
 void GodotNavigationServer::process(real_t p_delta_time) {
+	// Path query batches run against the maps as they were synced last, so they are done before any queued command
+	// or sync modifies them. The ones queued meanwhile, including from other threads, are started once the maps are synced.
+	_pause_path_query_batches();
+
 	flush_queries();
 
 	if (!active) {
+		_resume_path_query_batches();
+		_dispatch_path_query_batches();
 		return;
 	}
 
@@ -807,7 +823,7 @@ void GodotNavigationServer::process(real_t p_delta_time) {
 
 	// In c++ we can't be sure that this is performed in the main thread
 	// even with mutable functions.
-	MutexLock lock(operations_mutex);
+	operations_mutex.lock();
 	for (uint32_t i(0); i < active_maps.size(); i++) {
 		active_maps[i]->sync();
 		active_maps[i]->step(p_delta_time);
@@ -838,20 +854,29 @@ void GodotNavigationServer::process(real_t p_delta_time) {
 	pm_edge_merge_count = _new_pm_edge_merge_count;
 	pm_edge_connection_count = _new_pm_edge_connection_count;
 	pm_edge_free_count = _new_pm_edge_free_count;
+	operations_mutex.unlock();
+
+	// Callbacks may queue new batches, which start right away and are dispatched on the next process.
+	_resume_path_query_batches();
+	_dispatch_path_query_batches();
 }
 
 PathQueryResult GodotNavigationServer::_query_path(const PathQueryParameters &p_parameters) const {
-	PathQueryResult r_query_result;
-
 	const NavMap *map = map_owner.get_or_null(p_parameters.map);
-	ERR_FAIL_COND_V(map == nullptr, r_query_result);
+	ERR_FAIL_COND_V(map == nullptr, PathQueryResult());
+
+	return _query_path_on_map(map, p_parameters);
+}
+
+PathQueryResult GodotNavigationServer::_query_path_on_map(const NavMap *p_map, const PathQueryParameters &p_parameters) {
+	PathQueryResult r_query_result;
 
 	// run the pathfinding
 
 	if (p_parameters.pathfinding_algorithm == PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR) {
 		// while postprocessing is still part of map.get_path() need to check and route it here for the correct "optimize" post-processing
 		if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					true,
@@ -860,7 +885,7 @@ PathQueryResult GodotNavigationServer::_query_path(const PathQueryParameters &p_
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_RIDS) ? &r_query_result.path_rids : nullptr,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr);
 		} else if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					false,
@@ -880,6 +905,144 @@ PathQueryResult GodotNavigationServer::_query_path(const PathQueryParameters &p_
 	return r_query_result;
 }
 
+uint32_t GodotNavigationServer::query_path_batch(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const Callable &p_callback) {
+	ERR_FAIL_COND_V(p_query_parameters.is_empty(), 0);
+
+	PathQueryBatch *batch = memnew(PathQueryBatch);
+	batch->parameters.resize(p_query_parameters.size());
+	batch->maps.resize(p_query_parameters.size());
+	batch->results.resize(p_query_parameters.size());
+	batch->callback = p_callback;
+
+	for (int i = 0; i < p_query_parameters.size(); i++) {
+		const Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[i];
+		if (query_parameters.is_null()) {
+			memdelete(batch);
+			ERR_FAIL_V_MSG(0, vformat("Invalid path query parameters at index %d.", i));
+		}
+		batch->parameters[i] = query_parameters->get_parameters();
+
+		if (!map_owner.owns(batch->parameters[i].map)) {
+			memdelete(batch);
+			ERR_FAIL_V_MSG(0, vformat("Invalid navigation map in path query parameters at index %d.", i));
+		}
+	}
+
+	MutexLock lock(path_query_batches_mutex);
+
+	path_query_batch_last_id++;
+	if (path_query_batch_last_id == 0) {
+		path_query_batch_last_id = 1;
+	}
+	batch->id = path_query_batch_last_id;
+	if (!path_query_batches_paused) {
+		_start_path_query_batch(batch);
+	}
+	path_query_batches.push_back(batch);
+
+	return batch->id;
+}
+
+bool GodotNavigationServer::is_path_query_batch_completed(uint32_t p_batch_id) const {
+	MutexLock lock(path_query_batches_mutex);
+
+	for (const PathQueryBatch *batch : path_query_batches) {
+		if (batch->id == p_batch_id) {
+			return batch->started && (batch->group_task == WorkerThreadPool::INVALID_TASK_ID || WorkerThreadPool::get_singleton()->is_group_task_completed(batch->group_task));
+		}
+	}
+
+	// Already dispatched.
+	return true;
+}
+
+void GodotNavigationServer::_query_path_batch_item(uint32_t p_index, PathQueryBatch *p_batch) {
+	if (p_batch->maps[p_index]) {
+		p_batch->results[p_index] = _query_path_on_map(p_batch->maps[p_index], p_batch->parameters[p_index]);
+	}
+}
+
+void GodotNavigationServer::_start_path_query_batch(PathQueryBatch *p_batch) {
+	// Resolved before the workers start, as they must not access the RID owners. Maps freed
+	// since the batch was queued produce empty results.
+	for (uint32_t i = 0; i < p_batch->parameters.size(); i++) {
+		p_batch->maps[i] = map_owner.get_or_null(p_batch->parameters[i].map);
+	}
+
+	p_batch->started = true;
+	p_batch->group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotNavigationServer::_query_path_batch_item, p_batch, p_batch->parameters.size(), -1, true, SNAME("NavigationPathQueryBatch"));
+}
+
+void GodotNavigationServer::_wait_for_path_query_batches() {
+	MutexLock lock(path_query_batches_mutex);
+
+	for (PathQueryBatch *batch : path_query_batches) {
+		if (batch->group_task != WorkerThreadPool::INVALID_TASK_ID) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(batch->group_task);
+			batch->group_task = WorkerThreadPool::INVALID_TASK_ID;
+		}
+	}
+}
+
+void GodotNavigationServer::_pause_path_query_batches() {
+	MutexLock lock(path_query_batches_mutex);
+
+	path_query_batches_paused = true;
+	_wait_for_path_query_batches();
+}
+
+void GodotNavigationServer::_resume_path_query_batches() {
+	MutexLock lock(path_query_batches_mutex);
+
+	path_query_batches_paused = false;
+	for (PathQueryBatch *batch : path_query_batches) {
+		if (!batch->started) {
+			_start_path_query_batch(batch);
+		}
+	}
+}
+
+void GodotNavigationServer::_dispatch_path_query_batches() {
+	// Only the batches completed before the maps changed, the ones started since then are dispatched on the next process.
+	LocalVector<PathQueryBatch *> batches;
+	{
+		MutexLock lock(path_query_batches_mutex);
+		for (uint32_t i = 0; i < path_query_batches.size(); i++) {
+			PathQueryBatch *batch = path_query_batches[i];
+			if (batch->started && batch->group_task == WorkerThreadPool::INVALID_TASK_ID) {
+				batches.push_back(batch);
+				path_query_batches.remove_at(i);
+				i--;
+			}
+		}
+	}
+
+	for (PathQueryBatch *batch : batches) {
+		if (batch->callback.is_valid()) {
+			TypedArray<NavigationPathQueryResult3D> results;
+			results.resize(batch->results.size());
+			for (uint32_t i = 0; i < batch->results.size(); i++) {
+				const PathQueryResult &query_result = batch->results[i];
+
+				Ref<NavigationPathQueryResult3D> result;
+				result.instantiate();
+				result->set_path(query_result.path);
+				result->set_path_types(query_result.path_types);
+				result->set_path_rids(query_result.path_rids);
+				result->set_path_owner_ids(query_result.path_owner_ids);
+				results[i] = result;
+			}
+
+			Variant args[] = { batch->id, results };
+			const Variant *args_p[] = { &args[0], &args[1] };
+			Variant return_value;
+			Callable::CallError call_error;
+			batch->callback.callp(args_p, 2, return_value, call_error);
+		}
+		memdelete(batch);
+	}
+}
+
 int GodotNavigationServer::get_process_info(ProcessInfo p_info) const {
 	switch (p_info) {
 		case INFO_ACTIVE_MAPS: {
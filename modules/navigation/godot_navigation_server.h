@@ -68,6 +68,32 @@ class GodotNavigationServer : public NavigationServer3D {
 
 	LocalVector<SetCommand *> commands;
 
+	struct PathQueryBatch {
+		uint32_t id = 0;
+		LocalVector<NavigationUtilities::PathQueryParameters> parameters;
+		// Resolved when the batch is started, the workers must not access the RID owners.
+		LocalVector<const NavMap *> maps;
+		LocalVector<NavigationUtilities::PathQueryResult> results;
+		Callable callback;
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::INVALID_TASK_ID; // Reset once waited for.
+		bool started = false;
+	};
+
+	/// Path query batches waiting for their results to be dispatched.
+	mutable Mutex path_query_batches_mutex;
+	LocalVector<PathQueryBatch *> path_query_batches;
+	uint32_t path_query_batch_last_id = 0;
+	// Set while the maps change, batches queued meanwhile are started afterwards.
+	bool path_query_batches_paused = false;
+
+	static NavigationUtilities::PathQueryResult _query_path_on_map(const NavMap *p_map, const NavigationUtilities::PathQueryParameters &p_parameters);
+	void _query_path_batch_item(uint32_t p_index, PathQueryBatch *p_batch);
+	void _start_path_query_batch(PathQueryBatch *p_batch);
+	void _wait_for_path_query_batches();
+	void _pause_path_query_batches();
+	void _resume_path_query_batches();
+	void _dispatch_path_query_batches();
+
 	mutable RID_Owner<NavLink> link_owner;
 	mutable RID_Owner<NavMap> map_owner;
 	mutable RID_Owner<NavRegion> region_owner;
@@ -189,6 +215,9 @@ public:
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const override;
 
+	virtual uint32_t query_path_batch(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const Callable &p_callback) override;
+	virtual bool is_path_query_batch_completed(uint32_t p_batch_id) const override;
+
 	int get_process_info(ProcessInfo p_info) const override;
 };
 
@@ -30,7 +30,9 @@
 
 #include "nav_map.h"
 
+#include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/templates/sort_array.h"
 #include "nav_agent.h"
 #include "nav_link.h"
 #include "nav_region.h"
@@ -63,6 +65,7 @@ void NavMap::set_cell_size(float p_cell_size) {
 void NavMap::set_edge_connection_margin(float p_edge_connection_margin) {
 	edge_connection_margin = p_edge_connection_margin;
 	regenerate_links = true;
+	regenerate_connections = true;
 }
 
 void NavMap::set_link_connection_radius(float p_link_connection_radius) {
@@ -70,6 +73,104 @@ void NavMap::set_link_connection_radius(float p_link_connection_radius) {
 	regenerate_links = true;
 }
 
+// Search state of the path queries. Each thread keeps its own, so the buffers only
+// need to grow when a query visits more polygons than the previous ones did.
+struct PathQueryScratch {
+	struct ToVisit {
+		float cost = 0.0;
+		uint32_t id = 0;
+	};
+
+	// Keeps the least cost polygon on top of the heap, the first one added on ties.
+	struct ToVisitComparator {
+		_FORCE_INLINE_ bool operator()(const ToVisit &p_a, const ToVisit &p_b) const {
+			return p_a.cost > p_b.cost || (p_a.cost == p_b.cost && p_a.id > p_b.id);
+		}
+	};
+
+	struct PolygonState {
+		uint32_t search_id = 0;
+		uint32_t navigation_poly_id = 0;
+	};
+
+	LocalVector<gd::NavigationPoly> navigation_polys;
+	LocalVector<ToVisit> to_visit;
+
+	// Navigation poly of each map polygon, only valid if it was set by the current search.
+	LocalVector<PolygonState> polygon_states;
+	uint32_t search_id = 0;
+
+	void begin(uint32_t p_polygon_count) {
+		navigation_polys.clear();
+		to_visit.clear();
+		if (polygon_states.size() < p_polygon_count) {
+			polygon_states.resize(p_polygon_count);
+		}
+
+		search_id++;
+		if (unlikely(search_id == 0)) {
+			for (PolygonState &state : polygon_states) {
+				state.search_id = 0;
+			}
+			search_id = 1;
+		}
+	}
+
+	void add_navigation_poly(const gd::NavigationPoly &p_navigation_poly) {
+		PolygonState &state = polygon_states[p_navigation_poly.poly->id];
+		state.search_id = search_id;
+		state.navigation_poly_id = navigation_polys.size();
+		navigation_polys.push_back(p_navigation_poly);
+	}
+
+	int64_t find_navigation_poly(const gd::Polygon *p_polygon) const {
+		const PolygonState &state = polygon_states[p_polygon->id];
+		return state.search_id == search_id ? int64_t(state.navigation_poly_id) : -1;
+	}
+
+	void push_to_visit(uint32_t p_id, float p_cost) {
+		ToVisit entry;
+		entry.cost = p_cost;
+		entry.id = p_id;
+		to_visit.push_back(entry);
+
+		SortArray<ToVisit, ToVisitComparator> sorter;
+		sorter.push_heap(0, to_visit.size() - 1, 0, entry, to_visit.ptr());
+	}
+
+	ToVisit pop_to_visit() {
+		SortArray<ToVisit, ToVisitComparator> sorter;
+		sorter.pop_heap(0, to_visit.size(), to_visit.ptr());
+
+		const ToVisit entry = to_visit[to_visit.size() - 1];
+		to_visit.resize(to_visit.size() - 1);
+		return entry;
+	}
+};
+
+static thread_local PathQueryScratch path_query_scratch;
+
+static _FORCE_INLINE_ float _get_estimated_cost(const gd::NavigationPoly &p_navigation_poly, const Vector3 &p_end_point) {
+	float cost = p_navigation_poly.traveled_distance;
+	cost += (p_navigation_poly.entry.distance_to(p_end_point) * p_navigation_poly.poly->owner->get_travel_cost());
+	return cost;
+}
+
+static Vector3 _get_closest_point_on_polygon(const gd::Polygon *p_polygon, const Vector3 &p_point) {
+	Vector3 closest_point;
+	float closest_d = 1e20;
+	for (size_t point_id = 2; point_id < p_polygon->points.size(); point_id++) {
+		Face3 f(p_polygon->points[0].pos, p_polygon->points[point_id - 1].pos, p_polygon->points[point_id].pos);
+		Vector3 spoint = f.get_closest_point_to(p_point);
+		float dpoint = spoint.distance_to(p_point);
+		if (dpoint < closest_d) {
+			closest_point = spoint;
+			closest_d = dpoint;
+		}
+	}
+	return closest_point;
+}
+
 gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
 	const int x = int(Math::floor(p_pos.x / cell_size));
 	const int y = int(Math::floor(p_pos.y / cell_size));
@@ -100,36 +201,13 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	const gd::Polygon *end_poly = nullptr;
 	Vector3 begin_point;
 	Vector3 end_point;
-	float begin_d = 1e20;
-	float end_d = 1e20;
 	// Find the initial poly and the end poly on this map.
-	for (const gd::Polygon &p : polygons) {
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
-			continue;
-		}
-
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-
-			Vector3 point = face.get_closest_point_to(p_origin);
-			float distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
-			}
-
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
-			}
-		}
-	}
+	// Only consider the polygons in regions with compatible layers.
+	NavPolygonTree::ClosestPoint closest;
+	begin_poly = _get_closest_polygon(p_origin, 1e20, true, p_navigation_layers, closest);
+	begin_point = closest.point;
+	end_poly = _get_closest_polygon(p_destination, 1e20, true, p_navigation_layers, closest);
+	end_point = closest.point;
 
 	// Check for trivial cases
 	if (!begin_poly || !end_poly) {
@@ -161,9 +239,12 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		return path;
 	}
 
+	// Search state, reused by the following queries made from this thread.
+	PathQueryScratch &scratch = path_query_scratch;
+	scratch.begin(polygon_count + link_polygons.size());
+
 	// List of all reachable navigation polys.
-	LocalVector<gd::NavigationPoly> navigation_polys;
-	navigation_polys.reserve(polygons.size() * 0.75);
+	LocalVector<gd::NavigationPoly> &navigation_polys = scratch.navigation_polys;
 
 	// Add the start polygon to the reachable navigation polygons.
 	gd::NavigationPoly begin_navigation_poly = gd::NavigationPoly(begin_poly);
@@ -171,18 +252,18 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	begin_navigation_poly.entry = begin_point;
 	begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
 	begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
-	navigation_polys.push_back(begin_navigation_poly);
-
-	// List of polygon IDs to visit.
-	List<uint32_t> to_visit;
-	to_visit.push_back(0);
+	scratch.add_navigation_poly(begin_navigation_poly);
 
 	// This is an implementation of the A* algorithm.
+	// The polygons to visit are kept in a binary heap. When the cost of a polygon is reduced it is
+	// pushed again, and the outdated entries are skipped when they reach the top of the heap.
 	int least_cost_id = 0;
 	int prev_least_cost_id = -1;
 	bool found_route = false;
+	uint32_t searched_polygons = 0;
 
 	const gd::Polygon *reachable_end = nullptr;
+	int reachable_end_id = -1;
 	float reachable_d = 1e30;
 	bool is_reachable = true;
 
@@ -211,7 +292,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 				const Vector3 new_entry = Geometry3D::get_closest_point_to_segment(least_cost_poly.entry, pathway);
 				const float new_distance = (least_cost_poly.entry.distance_to(new_entry) * poly_travel_cost) + poly_enter_cost + least_cost_poly.traveled_distance;
 
-				int64_t already_visited_polygon_index = navigation_polys.find(gd::NavigationPoly(connection.polygon));
+				int64_t already_visited_polygon_index = scratch.find_navigation_poly(connection.polygon);
 
 				if (already_visited_polygon_index != -1) {
 					// Polygon already visited, check if we can reduce the travel cost.
@@ -223,6 +304,10 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 						avp.back_navigation_edge_pathway_end = connection.pathway_end;
 						avp.traveled_distance = new_distance;
 						avp.entry = new_entry;
+
+						if (!avp.closed) {
+							scratch.push_to_visit(avp.self_id, _get_estimated_cost(avp, end_point));
+						}
 					}
 				} else {
 					// Add the neighbor polygon to the reachable ones.
@@ -234,19 +319,32 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					new_navigation_poly.back_navigation_edge_pathway_end = connection.pathway_end;
 					new_navigation_poly.traveled_distance = new_distance;
 					new_navigation_poly.entry = new_entry;
-					navigation_polys.push_back(new_navigation_poly);
+					scratch.add_navigation_poly(new_navigation_poly);
 
 					// Add the neighbor polygon to the polygons to visit.
-					to_visit.push_back(navigation_polys.size() - 1);
+					scratch.push_to_visit(new_navigation_poly.self_id, _get_estimated_cost(new_navigation_poly, end_point));
 				}
 			}
 		}
 
 		// Removes the least cost polygon from the list of polygons to visit so we can advance.
-		to_visit.erase(least_cost_id);
+		navigation_polys[least_cost_id].closed = true;
+		searched_polygons++;
+
+		// Find the polygon with the minimum cost from the list of polygons to visit.
+		least_cost_id = -1;
+		while (!scratch.to_visit.is_empty()) {
+			const PathQueryScratch::ToVisit to_visit = scratch.pop_to_visit();
+			const gd::NavigationPoly &np = navigation_polys[to_visit.id];
+			// Skip the entries of polygons already visited, or whose cost was reduced since.
+			if (!np.closed && to_visit.cost == _get_estimated_cost(np, end_point)) {
+				least_cost_id = to_visit.id;
+				break;
+			}
+		}
 
 		// When the list of polygons to visit is empty at this point it means the End Polygon is not reachable
-		if (to_visit.size() == 0) {
+		if (least_cost_id == -1) {
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
 			is_reachable = false;
@@ -257,53 +355,30 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
 			// Set as end point the furthest reachable point.
 			end_poly = reachable_end;
-			end_d = 1e20;
-			for (size_t point_id = 2; point_id < end_poly->points.size(); point_id++) {
-				Face3 f(end_poly->points[0].pos, end_poly->points[point_id - 1].pos, end_poly->points[point_id].pos);
-				Vector3 spoint = f.get_closest_point_to(p_destination);
-				float dpoint = spoint.distance_to(p_destination);
-				if (dpoint < end_d) {
-					end_point = spoint;
-					end_d = dpoint;
-				}
-			}
+			end_point = _get_closest_point_on_polygon(end_poly, p_destination);
 
 			// Reset open and navigation_polys
 			gd::NavigationPoly np = navigation_polys[0];
-			navigation_polys.clear();
-			navigation_polys.push_back(np);
-			to_visit.clear();
-			to_visit.push_back(0);
+			np.closed = false;
+			scratch.begin(polygon_count + link_polygons.size());
+			scratch.add_navigation_poly(np);
 			least_cost_id = 0;
 			prev_least_cost_id = -1;
 
 			reachable_end = nullptr;
+			reachable_end_id = -1;
+			reachable_d = 1e30;
 
 			continue;
 		}
 
-		// Find the polygon with the minimum cost from the list of polygons to visit.
-		least_cost_id = -1;
-		float least_cost = 1e30;
-		for (List<uint32_t>::Element *element = to_visit.front(); element != nullptr; element = element->next()) {
-			gd::NavigationPoly *np = &navigation_polys[element->get()];
-			float cost = np->traveled_distance;
-			cost += (np->entry.distance_to(end_point) * np->poly->owner->get_travel_cost());
-			if (cost < least_cost) {
-				least_cost_id = np->self_id;
-				least_cost = cost;
-			}
-		}
-
-		ERR_BREAK(least_cost_id == -1);
-
 		// Stores the further reachable end polygon, in case our goal is not reachable.
-		if (is_reachable) {
-			float d = navigation_polys[least_cost_id].entry.distance_to(p_destination) * navigation_polys[least_cost_id].poly->owner->get_travel_cost();
-			if (reachable_d > d) {
-				reachable_d = d;
-				reachable_end = navigation_polys[least_cost_id].poly;
-			}
+		// It is also tracked while searching for that polygon, in case the search limit is reached first.
+		float d = navigation_polys[least_cost_id].entry.distance_to(p_destination) * navigation_polys[least_cost_id].poly->owner->get_travel_cost();
+		if (reachable_d > d) {
+			reachable_d = d;
+			reachable_end = navigation_polys[least_cost_id].poly;
+			reachable_end_id = least_cost_id;
 		}
 
 		// Check if we reached the end
@@ -311,6 +386,18 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 			found_route = true;
 			break;
 		}
+
+		// Stop searching once the search limit is reached, and go towards the closest polygon found so far.
+		if (path_search_max_polygons > 0 && searched_polygons >= path_search_max_polygons) {
+			if (reachable_end == nullptr) {
+				break;
+			}
+			least_cost_id = reachable_end_id;
+			end_poly = reachable_end;
+			end_point = _get_closest_point_on_polygon(end_poly, p_destination);
+			found_route = true;
+			break;
+		}
 	}
 
 	// If we did not find a route, return an empty path.
@@ -457,46 +544,29 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 }
 
 Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
-	bool use_collision = p_use_collision;
+	// Prefer the closest intersection with the polygons.
 	Vector3 closest_point;
-	real_t closest_point_d = 1e20;
-
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the segment
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			Vector3 inters;
-			if (f.intersects_segment(p_from, p_to, &inters)) {
-				const real_t d = closest_point_d = p_from.distance_to(inters);
-				if (use_collision == false) {
-					closest_point = inters;
-					use_collision = true;
-					closest_point_d = d;
-				} else if (closest_point_d > d) {
-					closest_point = inters;
-					closest_point_d = d;
-				}
-			}
+	real_t closest_point_ds = 1e20;
+	bool intersects = false;
+	for (const MapRegion *map_region : map_regions) {
+		NavPolygonTree::ClosestPoint closest;
+		if (map_region->polygon_tree.intersect_segment(p_from, p_to, closest) && closest.distance_squared < closest_point_ds) {
+			closest_point = closest.point;
+			closest_point_ds = closest.distance_squared;
+			intersects = true;
 		}
+	}
 
-		if (use_collision == false) {
-			for (size_t point_id = 0; point_id < p.points.size(); point_id += 1) {
-				Vector3 a, b;
-
-				Geometry3D::get_closest_points_between_segments(
-						p_from,
-						p_to,
-						p.points[point_id].pos,
-						p.points[(point_id + 1) % p.points.size()].pos,
-						a,
-						b);
+	if (intersects || p_use_collision) {
+		return closest_point;
+	}
 
-				const real_t d = a.distance_to(b);
-				if (d < closest_point_d) {
-					closest_point_d = d;
-					closest_point = b;
-				}
-			}
+	// Otherwise use the closest point on the polygon edges.
+	for (const MapRegion *map_region : map_regions) {
+		NavPolygonTree::ClosestPoint closest;
+		if (map_region->polygon_tree.get_closest_edge_point_to_segment(p_from, p_to, closest) && closest.distance_squared < closest_point_ds) {
+			closest_point = closest.point;
+			closest_point_ds = closest.distance_squared;
 		}
 	}
 
@@ -520,28 +590,39 @@ RID NavMap::get_closest_point_owner(const Vector3 &p_point) const {
 
 gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_point) const {
 	gd::ClosestPointQueryResult result;
-	real_t closest_point_ds = 1e20;
 
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
-
-		// For each face check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t ds = inters.distance_squared_to(p_point);
-			if (ds < closest_point_ds) {
-				result.point = inters;
-				result.normal = f.get_plane().normal;
-				result.owner = p.owner->get_self();
-				closest_point_ds = ds;
-			}
-		}
+	NavPolygonTree::ClosestPoint closest;
+	const gd::Polygon *polygon = _get_closest_polygon(p_point, 1e20, false, 0, closest);
+	if (polygon) {
+		result.point = closest.point;
+		result.normal = closest.normal;
+		result.owner = polygon->owner->get_self();
 	}
 
 	return result;
 }
 
+gd::Polygon *NavMap::_get_closest_polygon(const Vector3 &p_point, real_t p_max_distance, bool p_filter_layers, uint32_t p_navigation_layers, NavPolygonTree::ClosestPoint &r_closest) const {
+	gd::Polygon *closest_polygon = nullptr;
+	real_t closest_ds = p_max_distance * p_max_distance;
+
+	// On ties, the polygons of the first regions are kept.
+	for (MapRegion *map_region : map_regions) {
+		// All the polygons of a region have its layers.
+		if (p_filter_layers && (p_navigation_layers & map_region->region->get_navigation_layers()) == 0) {
+			continue;
+		}
+		NavPolygonTree::ClosestPoint closest;
+		if (map_region->polygon_tree.get_closest_point(p_point, closest_ds, false, 0, closest)) {
+			closest_polygon = &map_region->polygons[closest.polygon_index];
+			closest_ds = closest.distance_squared;
+			r_closest = closest;
+		}
+	}
+
+	return closest_polygon;
+}
+
 void NavMap::add_region(NavRegion *p_region) {
 	regions.push_back(p_region);
 	regenerate_links = true;
@@ -623,10 +704,28 @@ void NavMap::sync() {
 		regenerate_links = true;
 	}
 
+	// Find the regions that changed, or were added to the map.
+	sync_id++;
 	for (NavRegion *region : regions) {
-		if (region->sync()) {
+		const bool region_changed = region->sync();
+
+		MapRegion *map_region = nullptr;
+		HashMap<NavRegion *, MapRegion *>::Iterator E = map_region_map.find(region);
+		if (E) {
+			map_region = E->value;
+		} else {
+			map_region = memnew(MapRegion);
+			map_region->region = region;
+			map_region_map.insert(region, map_region);
+		}
+
+		if (region_changed || regenerate_connections) {
+			map_region->dirty = true;
+		}
+		if (map_region->dirty) {
 			regenerate_links = true;
 		}
+		map_region->sync_id = sync_id;
 	}
 
 	for (NavLink *link : links) {
@@ -642,190 +741,118 @@ void NavMap::sync() {
 		_new_pm_edge_connection_count = 0;
 		_new_pm_edge_free_count = 0;
 
-		// Remove regions connections.
-		for (NavRegion *region : regions) {
-			region->get_connections().clear();
-		}
-
-		// Resize the polygon count.
-		int count = 0;
-		for (const NavRegion *region : regions) {
-			count += region->get_polygons().size();
-		}
-		polygons.resize(count);
-
-		// Copy all region polygons in the map.
-		count = 0;
-		for (const NavRegion *region : regions) {
-			const LocalVector<gd::Polygon> &polygons_source = region->get_polygons();
-			for (uint32_t n = 0; n < polygons_source.size(); n++) {
-				polygons[count + n] = polygons_source[n];
+		// Remove the connections to the link polygons, they are all created again below.
+		for (gd::Polygon *polygon : link_connected_polygons) {
+			Vector<gd::Edge::Connection> &connections = polygon->edges[0].connections;
+			for (int i = connections.size() - 1; i >= 0; i--) {
+				if (connections[i].edge == -1) {
+					connections.remove_at(i);
+				}
 			}
-			count += region->get_polygons().size();
 		}
+		link_connected_polygons.clear();
 
-		_new_pm_polygon_count = polygons.size();
-
-		// Group all edges per key.
-		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
-		for (gd::Polygon &poly : polygons) {
-			for (uint32_t p = 0; p < poly.points.size(); p++) {
-				int next_point = (p + 1) % poly.points.size();
-				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
-
-				HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(ek);
-				if (!connection) {
-					connections[ek] = Vector<gd::Edge::Connection>();
-					_new_pm_edge_count += 1;
-				}
-				if (connections[ek].size() <= 1) {
-					// Add the polygon/edge tuple to this key.
-					gd::Edge::Connection new_connection;
-					new_connection.polygon = &poly;
-					new_connection.edge = p;
-					new_connection.pathway_start = poly.points[p].pos;
-					new_connection.pathway_end = poly.points[next_point].pos;
-					connections[ek].push_back(new_connection);
-				} else {
-					// The edge is already connected with another edge, skip.
-					ERR_PRINT_ONCE("Attempted to merge a navigation mesh triangle edge with another already-merged edge. This happens when the current `cell_size` is different from the one used to generate the navigation mesh. This will cause navigation problems.");
+		// Disconnect the regions that changed, or were removed, from the unchanged ones.
+		// The connections between unchanged regions are kept as they are.
+		for (MapRegion *map_region : map_regions) {
+			if (map_region->sync_id == sync_id && !map_region->dirty) {
+				continue;
+			}
+			for (MapRegion *neighbor : map_region->neighbors) {
+				if (neighbor->sync_id == sync_id && !neighbor->dirty) {
+					_disconnect_map_region(neighbor, map_region);
 				}
 			}
 		}
 
-		Vector<gd::Edge::Connection> free_edges;
-		for (KeyValue<gd::EdgeKey, Vector<gd::Edge::Connection>> &E : connections) {
-			if (E.value.size() == 2) {
-				// Connect edge that are shared in different polygons.
-				gd::Edge::Connection &c1 = E.value.write[0];
-				gd::Edge::Connection &c2 = E.value.write[1];
-				c1.polygon->edges[c1.edge].connections.push_back(c2);
-				c2.polygon->edges[c2.edge].connections.push_back(c1);
-				// Note: The pathway_start/end are full for those connection and do not need to be modified.
-				_new_pm_edge_merge_count += 1;
-			} else {
-				CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
-				free_edges.push_back(E.value[0]);
+		for (MapRegion *map_region : map_regions) {
+			if (map_region->sync_id != sync_id) {
+				map_region_map.erase(map_region->region);
+				memdelete(map_region);
 			}
 		}
 
-		// Find the compatible near edges.
-		//
-		// Note:
-		// Considering that the edges must be compatible (for obvious reasons)
-		// to be connected, create new polygons to remove that small gap is
-		// not really useful and would result in wasteful computation during
-		// connection, integration and path finding.
-		_new_pm_edge_free_count = free_edges.size();
+		map_regions.resize(regions.size());
+		for (uint32_t i = 0; i < regions.size(); i++) {
+			map_regions[i] = map_region_map[regions[i]];
+		}
 
-		for (int i = 0; i < free_edges.size(); i++) {
-			const gd::Edge::Connection &free_edge = free_edges[i];
-			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
-			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
+		// Copy the polygons of the regions that changed, and connect them with each other.
+		for (MapRegion *map_region : map_regions) {
+			if (map_region->dirty) {
+				_build_map_region(map_region);
+			}
+		}
 
-			for (int j = 0; j < free_edges.size(); j++) {
-				const gd::Edge::Connection &other_edge = free_edges[j];
-				if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
+		// Connect the regions that changed with the regions around them.
+		// The edges shared by two regions are merged first, as those are not connected to other edges.
+		for (int merge = 1; merge >= 0; merge--) {
+			for (uint32_t i = 0; i < map_regions.size(); i++) {
+				MapRegion *map_region = map_regions[i];
+				if (!map_region->dirty || map_region->polygons.is_empty()) {
 					continue;
 				}
 
-				Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
-				Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
-
-				// Compute the projection of the opposite edge on the current one
-				Vector3 edge_vector = edge_p2 - edge_p1;
-				float projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
-				float projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
-				if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
-					continue;
+				// Edges with vertices in the same cell are merged, so look at least one cell away.
+				const AABB bounds = map_region->bounds.grow(MAX(edge_connection_margin, cell_size));
+				for (uint32_t j = 0; j < map_regions.size(); j++) {
+					MapRegion *other = map_regions[j];
+					// Connect two regions that changed only once.
+					if (i == j || (other->dirty && j < i) || other->polygons.is_empty()) {
+						continue;
+					}
+					if (bounds.intersects_inclusive(other->bounds)) {
+						_connect_map_regions(map_region, other, merge);
+					}
 				}
+			}
+		}
 
-				// Check if the two edges are close to each other enough and compute a pathway between the two regions.
-				Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other1;
-				if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
-					other1 = other_edge_p1;
-				} else {
-					other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other1.distance_to(self1) > edge_connection_margin) {
-					continue;
-				}
+		// Number the polygons for the path queries.
+		polygon_count = 0;
+		int merged_free_edge_count = 0;
+		for (MapRegion *map_region : map_regions) {
+			map_region->dirty = false;
+
+			for (gd::Polygon &polygon : map_region->polygons) {
+				polygon.id = polygon_count++;
+			}
 
-				Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other2;
-				if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
-					other2 = other_edge_p2;
+			_new_pm_edge_count += map_region->edge_count;
+			_new_pm_edge_merge_count += map_region->edge_merge_count;
+			for (const FreeEdge &free_edge : map_region->free_edges) {
+				if (free_edge.merged_region) {
+					merged_free_edge_count++;
 				} else {
-					other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+					_new_pm_edge_free_count++;
 				}
-				if (other2.distance_to(self2) > edge_connection_margin) {
-					continue;
-				}
-
-				// The edges can now be connected.
-				gd::Edge::Connection new_connection = other_edge;
-				new_connection.pathway_start = (self1 + other1) / 2.0;
-				new_connection.pathway_end = (self2 + other2) / 2.0;
-				free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
-
-				// Add the connection to the region_connection map.
-				((NavRegion *)free_edge.polygon->owner)->get_connections().push_back(new_connection);
-				_new_pm_edge_connection_count += 1;
 			}
+			_new_pm_edge_connection_count += map_region->region->get_connections().size();
 		}
 
+		// Edges shared by two regions count once.
+		_new_pm_edge_count -= merged_free_edge_count / 2;
+		_new_pm_edge_merge_count += merged_free_edge_count / 2;
+		_new_pm_polygon_count = polygon_count;
+
 		uint32_t link_poly_idx = 0;
 		link_polygons.resize(links.size());
+		for (uint32_t i = 0; i < link_polygons.size(); i++) {
+			link_polygons[i].id = polygon_count + i;
+		}
 
 		// Search for polygons within range of a nav link.
 		for (const NavLink *link : links) {
 			const Vector3 start = link->get_start_position();
 			const Vector3 end = link->get_end_position();
 
-			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_distance = link_connection_radius;
-			Vector3 closest_start_point;
-
-			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_distance = link_connection_radius;
-			Vector3 closest_end_point;
-
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
-
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t start_distance = start_point.distance_to(start);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
-						closest_start_distance = start_distance;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
-				}
-			}
+			// Pick the closest polygons within the search radius of the start and end points.
+			NavPolygonTree::ClosestPoint closest;
+			gd::Polygon *closest_start_polygon = _get_closest_polygon(start, link_connection_radius, false, 0, closest);
+			const Vector3 closest_start_point = closest.point;
 
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t end_distance = end_point.distance_to(end);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
-						closest_end_distance = end_distance;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
-					}
-				}
-			}
+			gd::Polygon *closest_end_polygon = _get_closest_polygon(end, link_connection_radius, false, 0, closest);
+			const Vector3 closest_end_point = closest.point;
 
 			// If we have both a start and end point, then create a synthetic polygon to route through.
 			if (closest_start_polygon && closest_end_polygon) {
@@ -858,6 +885,7 @@ void NavMap::sync() {
 					entry_connection.pathway_start = new_polygon.points[0].pos;
 					entry_connection.pathway_end = new_polygon.points[1].pos;
 					closest_start_polygon->edges[0].connections.push_back(entry_connection);
+					link_connected_polygons.push_back(closest_start_polygon);
 
 					gd::Edge::Connection exit_connection;
 					exit_connection.polygon = closest_end_polygon;
@@ -875,6 +903,7 @@ void NavMap::sync() {
 					entry_connection.pathway_start = new_polygon.points[2].pos;
 					entry_connection.pathway_end = new_polygon.points[3].pos;
 					closest_end_polygon->edges[0].connections.push_back(entry_connection);
+					link_connected_polygons.push_back(closest_end_polygon);
 
 					gd::Edge::Connection exit_connection;
 					exit_connection.polygon = closest_start_polygon;
@@ -903,6 +932,7 @@ void NavMap::sync() {
 
 	regenerate_polygons = false;
 	regenerate_links = false;
+	regenerate_connections = false;
 	agents_dirty = false;
 
 	// Performance Monitor
@@ -916,6 +946,239 @@ void NavMap::sync() {
 	pm_edge_free_count = _new_pm_edge_free_count;
 }
 
+void NavMap::_build_map_region(MapRegion *p_map_region) {
+	NavRegion *region = p_map_region->region;
+	region->get_connections().clear();
+
+	p_map_region->polygons = region->get_polygons();
+	p_map_region->free_edges.clear();
+	p_map_region->free_edge_keys.clear();
+	p_map_region->neighbors.clear();
+	p_map_region->edge_count = 0;
+	p_map_region->edge_merge_count = 0;
+
+	// Group all edges per key.
+	HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
+	for (gd::Polygon &poly : p_map_region->polygons) {
+		for (uint32_t p = 0; p < poly.points.size(); p++) {
+			int next_point = (p + 1) % poly.points.size();
+			gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+
+			HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(ek);
+			if (!connection) {
+				connections[ek] = Vector<gd::Edge::Connection>();
+				p_map_region->edge_count += 1;
+			}
+			if (connections[ek].size() <= 1) {
+				// Add the polygon/edge tuple to this key.
+				gd::Edge::Connection new_connection;
+				new_connection.polygon = &poly;
+				new_connection.edge = p;
+				new_connection.pathway_start = poly.points[p].pos;
+				new_connection.pathway_end = poly.points[next_point].pos;
+				connections[ek].push_back(new_connection);
+			} else {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT_ONCE("Attempted to merge a navigation mesh triangle edge with another already-merged edge. This happens when the current `cell_size` is different from the one used to generate the navigation mesh. This will cause navigation problems.");
+			}
+		}
+	}
+
+	for (KeyValue<gd::EdgeKey, Vector<gd::Edge::Connection>> &E : connections) {
+		if (E.value.size() == 2) {
+			// Connect edge that are shared in different polygons.
+			gd::Edge::Connection &c1 = E.value.write[0];
+			gd::Edge::Connection &c2 = E.value.write[1];
+			c1.polygon->edges[c1.edge].connections.push_back(c2);
+			c2.polygon->edges[c2.edge].connections.push_back(c1);
+			// Note: The pathway_start/end are full for those connection and do not need to be modified.
+			p_map_region->edge_merge_count += 1;
+		} else {
+			CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
+			FreeEdge free_edge;
+			free_edge.polygon = E.value[0].polygon;
+			free_edge.edge = E.value[0].edge;
+			p_map_region->free_edge_keys.insert(E.key, p_map_region->free_edges.size());
+			p_map_region->free_edges.push_back(free_edge);
+		}
+	}
+
+	p_map_region->bounds = AABB();
+	bool first_point = true;
+	for (const gd::Polygon &poly : p_map_region->polygons) {
+		for (const gd::Point &point : poly.points) {
+			if (first_point) {
+				p_map_region->bounds.position = point.pos;
+				first_point = false;
+			} else {
+				p_map_region->bounds.expand_to(point.pos);
+			}
+		}
+	}
+
+	// Index the polygons for the closest point queries.
+	p_map_region->polygon_tree.build(p_map_region->polygons);
+}
+
+void NavMap::_connect_map_regions(MapRegion *p_a, MapRegion *p_b, bool p_merge) {
+	if (p_a->neighbors.find(p_b) == -1) {
+		p_a->neighbors.push_back(p_b);
+		p_b->neighbors.push_back(p_a);
+	}
+
+	if (p_merge) {
+		// Merge the edges that the regions share.
+		for (FreeEdge &free_edge : p_a->free_edges) {
+			if (free_edge.merged_region) {
+				continue;
+			}
+
+			const gd::Polygon *poly = free_edge.polygon;
+			const int next_point = (free_edge.edge + 1) % poly->points.size();
+			const uint32_t *other_edge_index = p_b->free_edge_keys.getptr(gd::EdgeKey(poly->points[free_edge.edge].key, poly->points[next_point].key));
+			if (!other_edge_index) {
+				continue;
+			}
+
+			FreeEdge &other_edge = p_b->free_edges[*other_edge_index];
+			if (other_edge.merged_region) {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT_ONCE("Attempted to merge a navigation mesh triangle edge with another already-merged edge. This happens when the current `cell_size` is different from the one used to generate the navigation mesh. This will cause navigation problems.");
+				continue;
+			}
+
+			gd::Edge::Connection c1;
+			c1.polygon = free_edge.polygon;
+			c1.edge = free_edge.edge;
+			c1.pathway_start = poly->points[free_edge.edge].pos;
+			c1.pathway_end = poly->points[next_point].pos;
+
+			gd::Edge::Connection c2;
+			c2.polygon = other_edge.polygon;
+			c2.edge = other_edge.edge;
+			c2.pathway_start = other_edge.polygon->points[other_edge.edge].pos;
+			c2.pathway_end = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
+
+			c1.polygon->edges[c1.edge].connections.push_back(c2);
+			c2.polygon->edges[c2.edge].connections.push_back(c1);
+
+			free_edge.merged_region = p_b;
+			other_edge.merged_region = p_a;
+		}
+		return;
+	}
+
+	// Find the compatible near edges.
+	//
+	// Note:
+	// Considering that the edges must be compatible (for obvious reasons)
+	// to be connected, create new polygons to remove that small gap is
+	// not really useful and would result in wasteful computation during
+	// connection, integration and path finding.
+	for (const FreeEdge &free_edge : p_a->free_edges) {
+		if (free_edge.merged_region) {
+			continue;
+		}
+
+		AABB edge_aabb(free_edge.polygon->points[free_edge.edge].pos, Vector3());
+		edge_aabb.expand_to(free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos);
+		edge_aabb.grow_by(edge_connection_margin);
+
+		for (const FreeEdge &other_edge : p_b->free_edges) {
+			if (other_edge.merged_region) {
+				continue;
+			}
+
+			// Only the edges closer than the margin can be connected.
+			AABB other_edge_aabb(other_edge.polygon->points[other_edge.edge].pos, Vector3());
+			other_edge_aabb.expand_to(other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos);
+			if (!edge_aabb.intersects_inclusive(other_edge_aabb)) {
+				continue;
+			}
+
+			_connect_free_edges(free_edge, other_edge);
+			_connect_free_edges(other_edge, free_edge);
+		}
+	}
+}
+
+void NavMap::_connect_free_edges(const FreeEdge &p_free_edge, const FreeEdge &p_other_edge) {
+	Vector3 edge_p1 = p_free_edge.polygon->points[p_free_edge.edge].pos;
+	Vector3 edge_p2 = p_free_edge.polygon->points[(p_free_edge.edge + 1) % p_free_edge.polygon->points.size()].pos;
+
+	Vector3 other_edge_p1 = p_other_edge.polygon->points[p_other_edge.edge].pos;
+	Vector3 other_edge_p2 = p_other_edge.polygon->points[(p_other_edge.edge + 1) % p_other_edge.polygon->points.size()].pos;
+
+	// Compute the projection of the opposite edge on the current one
+	Vector3 edge_vector = edge_p2 - edge_p1;
+	float projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
+	float projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
+	if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+		return;
+	}
+
+	// Check if the two edges are close to each other enough and compute a pathway between the two regions.
+	Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
+	Vector3 other1;
+	if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
+		other1 = other_edge_p1;
+	} else {
+		other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+	}
+	if (other1.distance_to(self1) > edge_connection_margin) {
+		return;
+	}
+
+	Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
+	Vector3 other2;
+	if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
+		other2 = other_edge_p2;
+	} else {
+		other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+	}
+	if (other2.distance_to(self2) > edge_connection_margin) {
+		return;
+	}
+
+	// The edges can now be connected.
+	gd::Edge::Connection new_connection;
+	new_connection.polygon = p_other_edge.polygon;
+	new_connection.edge = p_other_edge.edge;
+	new_connection.pathway_start = (self1 + other1) / 2.0;
+	new_connection.pathway_end = (self2 + other2) / 2.0;
+	p_free_edge.polygon->edges[p_free_edge.edge].connections.push_back(new_connection);
+
+	// Add the connection to the region_connection map.
+	((NavRegion *)p_free_edge.polygon->owner)->get_connections().push_back(new_connection);
+}
+
+void NavMap::_disconnect_map_region(MapRegion *p_map_region, const MapRegion *p_other) {
+	// Only the free edges can be connected to other regions.
+	for (FreeEdge &free_edge : p_map_region->free_edges) {
+		Vector<gd::Edge::Connection> &connections = free_edge.polygon->edges[free_edge.edge].connections;
+		for (int i = connections.size() - 1; i >= 0; i--) {
+			if (connections[i].polygon->owner == p_other->region) {
+				connections.remove_at(i);
+			}
+		}
+		if (free_edge.merged_region == p_other) {
+			free_edge.merged_region = nullptr;
+		}
+	}
+
+	Vector<gd::Edge::Connection> &region_connections = p_map_region->region->get_connections();
+	for (int i = region_connections.size() - 1; i >= 0; i--) {
+		if (region_connections[i].polygon->owner == p_other->region) {
+			region_connections.remove_at(i);
+		}
+	}
+
+	int64_t neighbor_index = p_map_region->neighbors.find(const_cast<MapRegion *>(p_other));
+	if (neighbor_index != -1) {
+		p_map_region->neighbors.remove_at_unordered(neighbor_index);
+	}
+}
+
 void NavMap::compute_single_step(uint32_t index, NavAgent **agent) {
 	(*(agent + index))->get_agent()->computeNeighbors(&rvo);
 	(*(agent + index))->get_agent()->computeNewVelocity(deltatime);
@@ -969,7 +1232,11 @@ void NavMap::clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys
 }
 
 NavMap::NavMap() {
+	path_search_max_polygons = GLOBAL_GET("navigation/pathfinding/max_search_polygons");
 }
 
 NavMap::~NavMap() {
+	for (MapRegion *map_region : map_regions) {
+		memdelete(map_region);
+	}
 }
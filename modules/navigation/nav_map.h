@@ -36,6 +36,7 @@
 #include "core/math/math_defs.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/templates/rb_map.h"
+#include "nav_polygon_tree.h"
 #include "nav_utils.h"
 
 #include <KdTree.h>
@@ -58,8 +59,13 @@ class NavMap : public NavRid {
 	/// This value is used to limit how far links search to find polygons to connect to.
 	real_t link_connection_radius = 1.0;
 
+	/// The maximum number of polygons a path query visits before it gives up on the destination, 0 for no limit.
+	uint32_t path_search_max_polygons = 0;
+
 	bool regenerate_polygons = true;
 	bool regenerate_links = true;
+	/// Set when all the connections between regions must be rebuilt.
+	bool regenerate_connections = false;
 
 	/// Map regions
 	LocalVector<NavRegion *> regions;
@@ -68,8 +74,43 @@ class NavMap : public NavRid {
 	LocalVector<NavLink *> links;
 	LocalVector<gd::Polygon> link_polygons;
 
-	/// Map polygons
-	LocalVector<gd::Polygon> polygons;
+	struct MapRegion;
+
+	/// Region edge that isn't shared by two polygons of the region.
+	struct FreeEdge {
+		gd::Polygon *polygon = nullptr;
+		int edge = -1;
+		/// Region this edge shares its vertices with, if any.
+		MapRegion *merged_region = nullptr;
+	};
+
+	/// The polygons of a region as used by the map. They are kept between syncs,
+	/// so only the regions that changed are rebuilt and connected again.
+	struct MapRegion {
+		NavRegion *region = nullptr;
+		LocalVector<gd::Polygon> polygons;
+		LocalVector<FreeEdge> free_edges;
+		HashMap<gd::EdgeKey, uint32_t, gd::EdgeKey> free_edge_keys;
+		/// The other regions close enough to have connections with this one.
+		LocalVector<MapRegion *> neighbors;
+		NavPolygonTree polygon_tree;
+		AABB bounds;
+
+		int edge_count = 0;
+		int edge_merge_count = 0;
+
+		uint32_t sync_id = 0;
+		bool dirty = true;
+	};
+
+	/// Map polygons, per region and in the same order as the regions.
+	LocalVector<MapRegion *> map_regions;
+	HashMap<NavRegion *, MapRegion *> map_region_map;
+	uint32_t polygon_count = 0;
+	uint32_t sync_id = 0;
+
+	/// Region polygons that have connections to the link polygons.
+	LocalVector<gd::Polygon *> link_connected_polygons;
 
 	/// Rvo world
 	RVO::KdTree rvo;
@@ -173,6 +214,13 @@ public:
 	int get_pm_edge_free_count() const { return pm_edge_free_count; }
 
 private:
+	gd::Polygon *_get_closest_polygon(const Vector3 &p_point, real_t p_max_distance, bool p_filter_layers, uint32_t p_navigation_layers, NavPolygonTree::ClosestPoint &r_closest) const;
+
+	void _build_map_region(MapRegion *p_map_region);
+	void _connect_map_regions(MapRegion *p_a, MapRegion *p_b, bool p_merge);
+	void _connect_free_edges(const FreeEdge &p_free_edge, const FreeEdge &p_other_edge);
+	void _disconnect_map_region(MapRegion *p_map_region, const MapRegion *p_other);
+
 	void compute_single_step(uint32_t index, NavAgent **agent);
 	void clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
 };
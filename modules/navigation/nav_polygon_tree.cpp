@@ -0,0 +1,345 @@
+/**************************************************************************/
+/*  nav_polygon_tree.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_polygon_tree.h"
+
+#include "nav_base.h"
+
+#include "core/math/face3.h"
+#include "core/math/geometry_3d.h"
+#include "core/templates/sort_array.h"
+
+static inline real_t _aabb_distance_squared(const AABB &p_aabb, const Vector3 &p_point) {
+	const Vector3 end = p_aabb.position + p_aabb.size;
+	real_t distance = 0.0;
+	for (int i = 0; i < 3; i++) {
+		real_t d = 0.0;
+		if (p_point[i] < p_aabb.position[i]) {
+			d = p_aabb.position[i] - p_point[i];
+		} else if (p_point[i] > end[i]) {
+			d = p_point[i] - end[i];
+		}
+		distance += d * d;
+	}
+	return distance;
+}
+
+static inline real_t _aabb_distance_squared(const AABB &p_a, const AABB &p_b) {
+	const Vector3 a_end = p_a.position + p_a.size;
+	const Vector3 b_end = p_b.position + p_b.size;
+	real_t distance = 0.0;
+	for (int i = 0; i < 3; i++) {
+		real_t d = 0.0;
+		if (b_end[i] < p_a.position[i]) {
+			d = p_a.position[i] - b_end[i];
+		} else if (p_b.position[i] > a_end[i]) {
+			d = p_b.position[i] - a_end[i];
+		}
+		distance += d * d;
+	}
+	return distance;
+}
+
+static inline AABB _segment_aabb(const Vector3 &p_from, const Vector3 &p_to) {
+	AABB aabb(p_from, Vector3());
+	aabb.expand_to(p_to);
+	return aabb;
+}
+
+struct NavPolygonTreeItemCenterComparator {
+	int axis = 0;
+
+	_FORCE_INLINE_ bool operator()(const NavPolygonTree::Item &p_a, const NavPolygonTree::Item &p_b) const {
+		return p_a.center[axis] < p_b.center[axis];
+	}
+};
+
+// Keeps the best candidate found so far while traversing the tree.
+// A candidate replaces the current one if it is strictly closer, or as close but from a polygon
+// with a lower index, so the results do not depend on the traversal order.
+struct NavPolygonTreeQuery {
+	real_t max_distance = 0.0;
+	bool found = false;
+	NavPolygonTree::ClosestPoint result;
+
+	_FORCE_INLINE_ bool is_better(real_t p_distance, uint32_t p_polygon_index) const {
+		return p_distance < max_distance || (found && p_distance == max_distance && p_polygon_index < result.polygon_index);
+	}
+
+	_FORCE_INLINE_ void set_result(real_t p_distance, const NavPolygonTree::Item &p_item, const Vector3 &p_point) {
+		max_distance = p_distance;
+		found = true;
+		result.polygon = p_item.polygon;
+		result.polygon_index = p_item.polygon_index;
+		result.point = p_point;
+		result.distance_squared = p_distance;
+	}
+};
+
+struct NavPolygonTreePointQuery : public NavPolygonTreeQuery {
+	Vector3 point;
+	bool filter_layers = false;
+	uint32_t navigation_layers = 0;
+
+	_FORCE_INLINE_ bool get_distance(const AABB &p_aabb, real_t &r_distance) const {
+		r_distance = _aabb_distance_squared(p_aabb, point);
+		return r_distance <= max_distance;
+	}
+
+	void process(const NavPolygonTree::Item &p_item) {
+		const gd::Polygon &p = *p_item.polygon;
+		if (filter_layers && (navigation_layers & p.owner->get_navigation_layers()) == 0) {
+			return;
+		}
+
+		for (uint32_t point_id = 2; point_id < p.points.size(); point_id++) {
+			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+			const Vector3 closest = f.get_closest_point_to(point);
+			const real_t ds = closest.distance_squared_to(point);
+			if (is_better(ds, p_item.polygon_index)) {
+				set_result(ds, p_item, closest);
+				result.normal = f.get_plane().normal;
+			}
+		}
+	}
+};
+
+struct NavPolygonTreeSegmentIntersectionQuery : public NavPolygonTreeQuery {
+	Vector3 from;
+	Vector3 to;
+	AABB segment_aabb;
+
+	_FORCE_INLINE_ bool get_distance(const AABB &p_aabb, real_t &r_distance) const {
+		if (_aabb_distance_squared(p_aabb, segment_aabb) > 0.0) {
+			return false;
+		}
+		r_distance = _aabb_distance_squared(p_aabb, from);
+		return r_distance <= max_distance;
+	}
+
+	void process(const NavPolygonTree::Item &p_item) {
+		const gd::Polygon &p = *p_item.polygon;
+		for (uint32_t point_id = 2; point_id < p.points.size(); point_id++) {
+			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+			Vector3 inters;
+			if (f.intersects_segment(from, to, &inters)) {
+				const real_t ds = inters.distance_squared_to(from);
+				if (is_better(ds, p_item.polygon_index)) {
+					set_result(ds, p_item, inters);
+					result.normal = f.get_plane().normal;
+				}
+			}
+		}
+	}
+};
+
+struct NavPolygonTreeSegmentEdgeQuery : public NavPolygonTreeQuery {
+	Vector3 from;
+	Vector3 to;
+	AABB segment_aabb;
+
+	_FORCE_INLINE_ bool get_distance(const AABB &p_aabb, real_t &r_distance) const {
+		r_distance = _aabb_distance_squared(p_aabb, segment_aabb);
+		return r_distance <= max_distance;
+	}
+
+	void process(const NavPolygonTree::Item &p_item) {
+		const gd::Polygon &p = *p_item.polygon;
+		for (uint32_t point_id = 0; point_id < p.points.size(); point_id++) {
+			Vector3 a, b;
+			Geometry3D::get_closest_points_between_segments(from, to, p.points[point_id].pos, p.points[(point_id + 1) % p.points.size()].pos, a, b);
+			const real_t ds = a.distance_squared_to(b);
+			if (is_better(ds, p_item.polygon_index)) {
+				set_result(ds, p_item, b);
+			}
+		}
+	}
+};
+
+template <class T>
+void NavPolygonTree::_traverse(T &p_query) const {
+	if (nodes.is_empty()) {
+		return;
+	}
+
+	uint32_t stack[MAX_DEPTH];
+	uint32_t stack_size = 0;
+
+	real_t distance;
+	if (!p_query.get_distance(nodes[0].aabb, distance)) {
+		return;
+	}
+	stack[stack_size++] = 0;
+
+	while (stack_size) {
+		const uint32_t node_index = stack[--stack_size];
+		const Node &node = nodes[node_index];
+
+		if (node.count) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				// The bound may have shrunk since the node was pushed, check each item again.
+				if (p_query.get_distance(items[i].aabb, distance)) {
+					p_query.process(items[i]);
+				}
+			}
+			continue;
+		}
+
+		const uint32_t left = node_index + 1;
+		const uint32_t right = node.first;
+		real_t left_distance, right_distance;
+		const bool left_hit = p_query.get_distance(nodes[left].aabb, left_distance);
+		const bool right_hit = p_query.get_distance(nodes[right].aabb, right_distance);
+
+		ERR_FAIL_COND(stack_size + 2 > MAX_DEPTH);
+
+		// Push the farthest child first, so the closest one is visited first and shrinks the bound.
+		if (left_hit && right_hit) {
+			if (left_distance <= right_distance) {
+				stack[stack_size++] = right;
+				stack[stack_size++] = left;
+			} else {
+				stack[stack_size++] = left;
+				stack[stack_size++] = right;
+			}
+		} else if (left_hit) {
+			stack[stack_size++] = left;
+		} else if (right_hit) {
+			stack[stack_size++] = right;
+		}
+	}
+}
+
+uint32_t NavPolygonTree::_build(uint32_t p_from, uint32_t p_to) {
+	const uint32_t node_index = nodes.size();
+	nodes.push_back(Node());
+
+	AABB aabb = items[p_from].aabb;
+	AABB centers(items[p_from].center, Vector3());
+	for (uint32_t i = p_from + 1; i < p_to; i++) {
+		aabb.merge_with(items[i].aabb);
+		centers.expand_to(items[i].center);
+	}
+	nodes[node_index].aabb = aabb;
+
+	if (p_to - p_from <= MAX_LEAF_ITEMS) {
+		nodes[node_index].first = p_from;
+		nodes[node_index].count = p_to - p_from;
+		return node_index;
+	}
+
+	// Split at the median of the longest axis, which keeps the tree balanced.
+	const uint32_t middle = (p_from + p_to) / 2;
+	SortArray<Item, NavPolygonTreeItemCenterComparator> sorter;
+	sorter.compare.axis = centers.get_longest_axis_index();
+	sorter.nth_element(p_from, p_to, middle, items.ptr());
+
+	_build(p_from, middle);
+	const uint32_t right = _build(middle, p_to);
+	nodes[node_index].first = right;
+	return node_index;
+}
+
+void NavPolygonTree::build(const LocalVector<gd::Polygon> &p_polygons) {
+	clear();
+
+	if (p_polygons.is_empty()) {
+		return;
+	}
+
+	items.resize(p_polygons.size());
+	for (uint32_t i = 0; i < p_polygons.size(); i++) {
+		const gd::Polygon &p = p_polygons[i];
+		Item &item = items[i];
+
+		item.polygon = &p;
+		item.polygon_index = i;
+		item.aabb = AABB(p.points.is_empty() ? p.center : p.points[0].pos, Vector3());
+		for (uint32_t point_id = 1; point_id < p.points.size(); point_id++) {
+			item.aabb.expand_to(p.points[point_id].pos);
+		}
+		// Flat polygons have an empty size on one axis, grow them a bit to be safe with the intersection tests.
+		item.aabb.grow_by(CMP_EPSILON);
+		item.center = item.aabb.get_center();
+	}
+
+	nodes.reserve(2 * (items.size() / MAX_LEAF_ITEMS) + 1);
+	_build(0, items.size());
+}
+
+void NavPolygonTree::clear() {
+	items.clear();
+	nodes.clear();
+}
+
+bool NavPolygonTree::get_closest_point(const Vector3 &p_point, real_t p_max_distance_squared, bool p_filter_layers, uint32_t p_navigation_layers, ClosestPoint &r_result) const {
+	NavPolygonTreePointQuery query;
+	query.max_distance = p_max_distance_squared;
+	query.point = p_point;
+	query.filter_layers = p_filter_layers;
+	query.navigation_layers = p_navigation_layers;
+
+	_traverse(query);
+
+	if (query.found) {
+		r_result = query.result;
+	}
+	return query.found;
+}
+
+bool NavPolygonTree::intersect_segment(const Vector3 &p_from, const Vector3 &p_to, ClosestPoint &r_result) const {
+	NavPolygonTreeSegmentIntersectionQuery query;
+	query.max_distance = p_from.distance_squared_to(p_to) + CMP_EPSILON;
+	query.from = p_from;
+	query.to = p_to;
+	query.segment_aabb = _segment_aabb(p_from, p_to);
+
+	_traverse(query);
+
+	if (query.found) {
+		r_result = query.result;
+	}
+	return query.found;
+}
+
+bool NavPolygonTree::get_closest_edge_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, ClosestPoint &r_result) const {
+	NavPolygonTreeSegmentEdgeQuery query;
+	query.max_distance = 1e20;
+	query.from = p_from;
+	query.to = p_to;
+	query.segment_aabb = _segment_aabb(p_from, p_to);
+
+	_traverse(query);
+
+	if (query.found) {
+		r_result = query.result;
+	}
+	return query.found;
+}
@@ -0,0 +1,99 @@
+/**************************************************************************/
+/*  nav_polygon_tree.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_POLYGON_TREE_H
+#define NAV_POLYGON_TREE_H
+
+#include "nav_utils.h"
+
+#include "core/math/aabb.h"
+#include "core/templates/local_vector.h"
+
+/// Static bounding volume hierarchy over the polygons of a map.
+/// It is rebuilt each time the map polygons change, and used to avoid
+/// testing every polygon when looking for the closest ones to a point or a segment.
+class NavPolygonTree {
+public:
+	struct ClosestPoint {
+		const gd::Polygon *polygon = nullptr;
+		/// Index of the polygon in the array used to build the tree.
+		uint32_t polygon_index = 0;
+		Vector3 point;
+		Vector3 normal;
+		real_t distance_squared = 0.0;
+	};
+
+	struct Item {
+		AABB aabb;
+		Vector3 center;
+		const gd::Polygon *polygon = nullptr;
+		uint32_t polygon_index = 0;
+	};
+
+private:
+	static const uint32_t MAX_LEAF_ITEMS = 4;
+	static const uint32_t MAX_DEPTH = 64;
+
+	struct Node {
+		AABB aabb;
+		/// Leafs: first item. Internal nodes: right child (the left child is the next node).
+		uint32_t first = 0;
+		/// Number of items, zero for internal nodes.
+		uint32_t count = 0;
+	};
+
+	/// Items sorted by leaf.
+	LocalVector<Item> items;
+	LocalVector<Node> nodes;
+
+	uint32_t _build(uint32_t p_from, uint32_t p_to);
+
+	template <class T>
+	void _traverse(T &p_query) const;
+
+public:
+	void build(const LocalVector<gd::Polygon> &p_polygons);
+	void clear();
+
+	bool is_empty() const { return nodes.is_empty(); }
+
+	/// Finds the point closest to `p_point` on the polygons whose squared distance is less than `p_max_distance_squared`.
+	/// If `p_filter_layers` is set, polygons in regions without any of `p_navigation_layers` are ignored.
+	/// Ties are resolved in favor of the lowest polygon index, as a linear search would.
+	bool get_closest_point(const Vector3 &p_point, real_t p_max_distance_squared, bool p_filter_layers, uint32_t p_navigation_layers, ClosestPoint &r_result) const;
+
+	/// Finds the intersection of the segment with the polygons which is closest to `p_from`.
+	bool intersect_segment(const Vector3 &p_from, const Vector3 &p_to, ClosestPoint &r_result) const;
+
+	/// Finds the point on the polygon edges which is closest to the segment.
+	bool get_closest_edge_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, ClosestPoint &r_result) const;
+};
+
+#endif // NAV_POLYGON_TREE_H
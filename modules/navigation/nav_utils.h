@@ -101,6 +101,9 @@ struct Polygon {
 	/// Navigation region or link that contains this polygon.
 	const NavBase *owner = nullptr;
 
+	/// Index of this polygon in its map, set when the map is synced.
+	uint32_t id = 0;
+
 	/// The points of this `Polygon`
 	LocalVector<Point> points;
 
@@ -129,6 +132,8 @@ struct NavigationPoly {
 	Vector3 entry;
 	/// The distance to the destination.
 	float traveled_distance = 0.0;
+	/// Has this poly already been removed from the polygons to visit?
+	bool closed = false;
 
 	NavigationPoly() { poly = nullptr; }
 
@@ -0,0 +1,150 @@
+/**************************************************************************/
+/*  test_nav_polygon_tree.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_NAV_POLYGON_TREE_H
+#define TEST_NAV_POLYGON_TREE_H
+
+#include "modules/navigation/nav_base.h"
+#include "modules/navigation/nav_polygon_tree.h"
+
+#include "core/math/face3.h"
+#include "core/math/random_number_generator.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNavPolygonTree {
+
+// Builds a grid of slightly uneven quads, alternating between two owners.
+static void create_grid(LocalVector<gd::Polygon> &r_polygons, const NavBase *p_owners) {
+	const real_t size = 2.0;
+	for (int x = 0; x < 20; x++) {
+		for (int z = 0; z < 20; z++) {
+			gd::Polygon polygon;
+			polygon.owner = &p_owners[(x + z) % 2];
+
+			const Vector3 origin(x * size, (x * z % 5) * 0.25, z * size);
+			const Vector3 points[4] = { origin, origin + Vector3(size, 0.1, 0), origin + Vector3(size, 0, size), origin + Vector3(0, -0.1, size) };
+			for (int i = 0; i < 4; i++) {
+				gd::Point point;
+				point.pos = points[i];
+				polygon.points.push_back(point);
+			}
+			r_polygons.push_back(polygon);
+		}
+	}
+}
+
+TEST_CASE("[NavPolygonTree] Empty tree") {
+	NavPolygonTree tree;
+	tree.build(LocalVector<gd::Polygon>());
+	CHECK(tree.is_empty());
+
+	NavPolygonTree::ClosestPoint closest;
+	CHECK_FALSE(tree.get_closest_point(Vector3(), 1e20, false, 0, closest));
+	CHECK_FALSE(tree.intersect_segment(Vector3(0, 1, 0), Vector3(0, -1, 0), closest));
+	CHECK_FALSE(tree.get_closest_edge_point_to_segment(Vector3(0, 1, 0), Vector3(0, -1, 0), closest));
+}
+
+TEST_CASE("[NavPolygonTree] Closest point matches a linear search") {
+	NavBase owners[2];
+	owners[0].set_navigation_layers(1);
+	owners[1].set_navigation_layers(2);
+
+	LocalVector<gd::Polygon> polygons;
+	create_grid(polygons, owners);
+
+	NavPolygonTree tree;
+	tree.build(polygons);
+	CHECK_FALSE(tree.is_empty());
+
+	Ref<RandomNumberGenerator> rng = memnew(RandomNumberGenerator);
+	rng->set_seed(42);
+
+	for (int i = 0; i < 500; i++) {
+		const Vector3 point(rng->randf_range(-5, 45), rng->randf_range(-2, 3), rng->randf_range(-5, 45));
+		const bool filter_layers = i % 2;
+		const uint32_t navigation_layers = 1 + (i % 3) / 2;
+		const real_t max_distance_squared = i % 4 ? 1e20 : 2.25;
+
+		real_t expected_distance = max_distance_squared;
+		int64_t expected_index = -1;
+		Vector3 expected_point;
+		for (uint32_t j = 0; j < polygons.size(); j++) {
+			const gd::Polygon &p = polygons[j];
+			if (filter_layers && (navigation_layers & p.owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+			for (uint32_t point_id = 2; point_id < p.points.size(); point_id++) {
+				const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+				const Vector3 closest = f.get_closest_point_to(point);
+				if (closest.distance_squared_to(point) < expected_distance) {
+					expected_distance = closest.distance_squared_to(point);
+					expected_index = j;
+					expected_point = closest;
+				}
+			}
+		}
+
+		NavPolygonTree::ClosestPoint closest;
+		const bool found = tree.get_closest_point(point, max_distance_squared, filter_layers, navigation_layers, closest);
+		CHECK(found == (expected_index != -1));
+		if (found && expected_index != -1) {
+			CHECK(closest.polygon_index == expected_index);
+			CHECK(closest.point == expected_point);
+		}
+	}
+}
+
+TEST_CASE("[NavPolygonTree] Segment queries") {
+	NavBase owners[2];
+	LocalVector<gd::Polygon> polygons;
+	create_grid(polygons, owners);
+
+	NavPolygonTree tree;
+	tree.build(polygons);
+
+	NavPolygonTree::ClosestPoint closest;
+
+	// A vertical segment hits the quad below it, at the intersection closest to its start.
+	REQUIRE(tree.intersect_segment(Vector3(5, 10, 7), Vector3(5, -10, 7), closest));
+	CHECK(closest.polygon_index == 2 * 20 + 3);
+	CHECK(closest.point.x == doctest::Approx(5));
+	CHECK(closest.point.z == doctest::Approx(7));
+
+	// A segment above the grid does not intersect it, but is closest to the corner polygon edges.
+	CHECK_FALSE(tree.intersect_segment(Vector3(-5, 10, -5), Vector3(-1, 10, -1), closest));
+	REQUIRE(tree.get_closest_edge_point_to_segment(Vector3(-5, 10, -5), Vector3(-1, 10, -1), closest));
+	CHECK(closest.polygon_index == 0);
+	CHECK(closest.point.is_equal_approx(Vector3()));
+}
+
+} // namespace TestNavPolygonTree
+
+#endif // TEST_NAV_POLYGON_TREE_H
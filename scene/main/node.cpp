@@ -47,10 +47,13 @@
 #include <stdint.h>
 
 VARIANT_ENUM_CAST(Node::ProcessMode);
+VARIANT_ENUM_CAST(Node::ProcessThreadGroup);
 VARIANT_ENUM_CAST(Node::InternalMode);
 
 int Node::orphan_node_count = 0;
 
+thread_local Node *Node::current_process_thread_group = nullptr;
+
 void Node::_notification(int p_notification) {
 	switch (p_notification) {
 		case NOTIFICATION_PROCESS: {
@@ -77,6 +80,15 @@ void Node::_notification(int p_notification) {
 				data.process_owner = this;
 			}
 
+			if (data.process_thread_group == PROCESS_THREAD_GROUP_INHERIT) {
+				data.process_thread_group_owner = data.parent ? data.parent->data.process_thread_group_owner : nullptr;
+			} else if (data.process_thread_group == PROCESS_THREAD_GROUP_SUB_THREAD) {
+				data.process_thread_group_owner = this;
+				get_tree()->_add_process_group(this);
+			} else {
+				data.process_thread_group_owner = nullptr;
+			}
+
 			if (data.input) {
 				add_to_group("_vp_input" + itos(get_viewport()->get_instance_id()));
 			}
@@ -115,6 +127,12 @@ void Node::_notification(int p_notification) {
 			}
 
 			data.process_owner = nullptr;
+
+			if (data.process_thread_group_owner == this) {
+				get_tree()->_remove_process_group(this);
+			}
+			data.process_thread_group_owner = nullptr;
+
 			if (data.path_cache) {
 				memdelete(data.path_cache);
 				data.path_cache = nullptr;
@@ -326,6 +344,7 @@ void Node::_propagate_exit_tree() {
 }
 
 void Node::move_child(Node *p_child, int p_index) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_NULL(p_child);
 	ERR_FAIL_COND_MSG(p_child->data.parent != this, "Child is not a child of this node.");
 
@@ -429,6 +448,7 @@ void Node::owner_changed_notify() {
 }
 
 void Node::set_physics_process(bool p_process) {
+	ERR_MAIN_THREAD_GUARD;
 	if (data.physics_process == p_process) {
 		return;
 	}
@@ -447,6 +467,7 @@ bool Node::is_physics_processing() const {
 }
 
 void Node::set_physics_process_internal(bool p_process_internal) {
+	ERR_MAIN_THREAD_GUARD;
 	if (data.physics_process_internal == p_process_internal) {
 		return;
 	}
@@ -465,6 +486,7 @@ bool Node::is_physics_processing_internal() const {
 }
 
 void Node::set_process_mode(ProcessMode p_mode) {
+	ERR_MAIN_THREAD_GUARD;
 	if (data.process_mode == p_mode) {
 		return;
 	}
@@ -557,7 +579,97 @@ void Node::_propagate_process_owner(Node *p_owner, int p_pause_notification, int
 	}
 }
 
+void Node::set_process_thread_group(ProcessThreadGroup p_mode) {
+	if (data.process_thread_group == p_mode) {
+		return;
+	}
+
+	if (!is_inside_tree()) {
+		data.process_thread_group = p_mode;
+		return;
+	}
+
+	ERR_FAIL_COND_MSG(Thread::get_caller_id() != Thread::get_main_id(), "Process thread groups can only be changed from the main thread.");
+
+	if (data.process_thread_group_owner == this) {
+		get_tree()->_remove_process_group(this);
+	}
+
+	data.process_thread_group = p_mode;
+
+	Node *owner = nullptr;
+	if (p_mode == PROCESS_THREAD_GROUP_INHERIT) {
+		owner = data.parent ? data.parent->data.process_thread_group_owner : nullptr;
+	} else if (p_mode == PROCESS_THREAD_GROUP_SUB_THREAD) {
+		owner = this;
+		get_tree()->_add_process_group(this);
+	}
+
+	_propagate_process_thread_group_owner(owner);
+}
+
+Node::ProcessThreadGroup Node::get_process_thread_group() const {
+	return data.process_thread_group;
+}
+
+void Node::_propagate_process_thread_group_owner(Node *p_owner) {
+	data.process_thread_group_owner = p_owner;
+
+	for (int i = 0; i < data.children.size(); i++) {
+		Node *c = data.children[i];
+		if (c->data.process_thread_group == PROCESS_THREAD_GROUP_INHERIT) {
+			c->_propagate_process_thread_group_owner(p_owner);
+		}
+	}
+}
+
+void Node::call_deferred_thread_groupp(const StringName &p_method, const Variant **p_args, int p_argcount) {
+	Callable callable(this, p_method);
+	if (p_argcount > 0) {
+		callable = callable.bindp(p_args, p_argcount);
+	}
+	if (!SceneTree::push_process_group_call(callable)) {
+		MessageQueue::get_singleton()->push_callp(this, p_method, p_args, p_argcount);
+	}
+}
+
+void Node::set_deferred_thread_group(const StringName &p_property, const Variant &p_value) {
+	if (!SceneTree::push_process_group_call(Callable(this, SNAME("set")).bind(p_property, p_value))) {
+		MessageQueue::get_singleton()->push_set(this, p_property, p_value);
+	}
+}
+
+void Node::notify_deferred_thread_group(int p_notification) {
+	if (!SceneTree::push_process_group_call(Callable(this, CoreStringNames::get_singleton()->notification).bind(p_notification))) {
+		MessageQueue::get_singleton()->push_notification(this, p_notification);
+	}
+}
+
+Variant Node::_call_deferred_thread_group_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
+	if (p_argcount < 1) {
+		r_error.error = Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS;
+		r_error.argument = 0;
+		return Variant();
+	}
+
+	if (p_args[0]->get_type() != Variant::STRING_NAME && p_args[0]->get_type() != Variant::STRING) {
+		r_error.error = Callable::CallError::CALL_ERROR_INVALID_ARGUMENT;
+		r_error.argument = 0;
+		r_error.expected = Variant::STRING_NAME;
+		return Variant();
+	}
+
+	r_error.error = Callable::CallError::CALL_OK;
+
+	StringName method = *p_args[0];
+
+	call_deferred_thread_groupp(method, &p_args[1], p_argcount - 1);
+
+	return Variant();
+}
+
 void Node::set_multiplayer_authority(int p_peer_id, bool p_recursive) {
+	ERR_THREAD_GUARD;
 	data.multiplayer_authority = p_peer_id;
 
 	if (p_recursive) {
@@ -751,6 +863,7 @@ double Node::get_process_delta_time() const {
 }
 
 void Node::set_process(bool p_process) {
+	ERR_MAIN_THREAD_GUARD;
 	if (data.process == p_process) {
 		return;
 	}
@@ -769,6 +882,7 @@ bool Node::is_processing() const {
 }
 
 void Node::set_process_internal(bool p_process_internal) {
+	ERR_MAIN_THREAD_GUARD;
 	if (data.process_internal == p_process_internal) {
 		return;
 	}
@@ -787,6 +901,7 @@ bool Node::is_processing_internal() const {
 }
 
 void Node::set_process_priority(int p_priority) {
+	ERR_MAIN_THREAD_GUARD;
 	data.process_priority = p_priority;
 
 	// Make sure we are in SceneTree.
@@ -816,6 +931,7 @@ int Node::get_process_priority() const {
 }
 
 void Node::set_process_input(bool p_enable) {
+	ERR_MAIN_THREAD_GUARD;
 	if (p_enable == data.input) {
 		return;
 	}
@@ -837,6 +953,7 @@ bool Node::is_processing_input() const {
 }
 
 void Node::set_process_shortcut_input(bool p_enable) {
+	ERR_MAIN_THREAD_GUARD;
 	if (p_enable == data.shortcut_input) {
 		return;
 	}
@@ -857,6 +974,7 @@ bool Node::is_processing_shortcut_input() const {
 }
 
 void Node::set_process_unhandled_input(bool p_enable) {
+	ERR_MAIN_THREAD_GUARD;
 	if (p_enable == data.unhandled_input) {
 		return;
 	}
@@ -877,6 +995,7 @@ bool Node::is_processing_unhandled_input() const {
 }
 
 void Node::set_process_unhandled_key_input(bool p_enable) {
+	ERR_MAIN_THREAD_GUARD;
 	if (p_enable == data.unhandled_key_input) {
 		return;
 	}
@@ -905,6 +1024,7 @@ void Node::_set_name_nocheck(const StringName &p_name) {
 }
 
 void Node::set_name(const String &p_name) {
+	ERR_MAIN_THREAD_GUARD;
 	String name = p_name.validate_node_name();
 
 	ERR_FAIL_COND(name.is_empty());
@@ -1127,6 +1247,7 @@ void Node::_add_child_nocheck(Node *p_child, const StringName &p_name) {
 }
 
 void Node::add_child(Node *p_child, bool p_force_readable_name, InternalMode p_internal) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_NULL(p_child);
 	ERR_FAIL_COND_MSG(p_child == this, vformat("Can't add child '%s' to itself.", p_child->get_name())); // adding to itself!
 	ERR_FAIL_COND_MSG(p_child->data.parent, vformat("Can't add child '%s' to '%s', already has a parent '%s'.", p_child->get_name(), get_name(), p_child->data.parent->get_name())); //Fail if node has a parent
@@ -1150,6 +1271,7 @@ void Node::add_child(Node *p_child, bool p_force_readable_name, InternalMode p_i
 }
 
 void Node::add_sibling(Node *p_sibling, bool p_force_readable_name) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_NULL(p_sibling);
 	ERR_FAIL_NULL(data.parent);
 	ERR_FAIL_COND_MSG(p_sibling == this, vformat("Can't add sibling '%s' to itself.", p_sibling->get_name())); // adding to itself!
@@ -1167,6 +1289,7 @@ void Node::add_sibling(Node *p_sibling, bool p_force_readable_name) {
 }
 
 void Node::remove_child(Node *p_child) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_NULL(p_child);
 	ERR_FAIL_COND_MSG(data.blocked > 0, "Parent node is busy adding/removing children, `remove_child()` can't be called at this time. Consider using `remove_child.call_deferred(child)` instead.");
 
@@ -1445,6 +1568,7 @@ TypedArray<Node> Node::find_children(const String &p_pattern, const String &p_ty
 }
 
 void Node::reparent(Node *p_parent, bool p_keep_global_transform) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_NULL(p_parent);
 	ERR_FAIL_NULL_MSG(data.parent, "Node needs a parent to be reparented.");
 
@@ -1594,6 +1718,7 @@ void Node::_acquire_unique_name_in_owner() {
 }
 
 void Node::set_unique_name_in_owner(bool p_enabled) {
+	ERR_MAIN_THREAD_GUARD;
 	if (data.unique_name_in_owner == p_enabled) {
 		return;
 	}
@@ -1615,6 +1740,7 @@ bool Node::is_unique_name_in_owner() const {
 }
 
 void Node::set_owner(Node *p_owner) {
+	ERR_MAIN_THREAD_GUARD;
 	if (data.owner) {
 		if (data.unique_name_in_owner) {
 			_release_unique_name_in_owner();
@@ -1802,6 +1928,7 @@ bool Node::is_in_group(const StringName &p_identifier) const {
 }
 
 void Node::add_to_group(const StringName &p_identifier, bool p_persistent) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_COND(!p_identifier.operator String().length());
 
 	if (data.grouped.has(p_identifier)) {
@@ -1822,6 +1949,7 @@ void Node::add_to_group(const StringName &p_identifier, bool p_persistent) {
 }
 
 void Node::remove_from_group(const StringName &p_identifier) {
+	ERR_MAIN_THREAD_GUARD;
 	HashMap<StringName, GroupData>::Iterator E = data.grouped.find(p_identifier);
 
 	if (!E) {
@@ -1922,6 +2050,7 @@ void Node::_propagate_deferred_notification(int p_notification, bool p_reverse)
 }
 
 void Node::propagate_notification(int p_notification) {
+	ERR_THREAD_GUARD;
 	data.blocked++;
 	notification(p_notification);
 
@@ -1932,6 +2061,7 @@ void Node::propagate_notification(int p_notification) {
 }
 
 void Node::propagate_call(const StringName &p_method, const Array &p_args, const bool p_parent_first) {
+	ERR_THREAD_GUARD;
 	data.blocked++;
 
 	if (p_parent_first && has_method(p_method)) {
@@ -2452,6 +2582,7 @@ static void find_owned_by(Node *p_by, Node *p_node, List<Node *> *p_owned) {
 }
 
 void Node::replace_by(Node *p_node, bool p_keep_groups) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_NULL(p_node);
 	ERR_FAIL_COND(p_node->data.parent);
 
@@ -2672,6 +2803,9 @@ void Node::print_orphan_nodes() {
 }
 
 void Node::queue_free() {
+	// The deletion queue is shared by the whole tree, whether this node is inside it or not.
+	ERR_FAIL_COND_MSG(current_process_thread_group, "Can't queue free a node while processing a process thread group. Use call_deferred_thread_group(\"queue_free\") instead.");
+
 	// There are users which instantiate multiple scene trees for their games.
 	// Use the node's own tree to handle its deletion when relevant.
 	if (is_inside_tree()) {
@@ -2783,6 +2917,7 @@ bool Node::is_displayed_folded() const {
 }
 
 void Node::request_ready() {
+	ERR_THREAD_GUARD;
 	data.ready_first = true;
 }
 
@@ -2892,6 +3027,10 @@ void Node::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_processing_unhandled_key_input"), &Node::is_processing_unhandled_key_input);
 	ClassDB::bind_method(D_METHOD("set_process_mode", "mode"), &Node::set_process_mode);
 	ClassDB::bind_method(D_METHOD("get_process_mode"), &Node::get_process_mode);
+	ClassDB::bind_method(D_METHOD("set_process_thread_group", "mode"), &Node::set_process_thread_group);
+	ClassDB::bind_method(D_METHOD("get_process_thread_group"), &Node::get_process_thread_group);
+	ClassDB::bind_method(D_METHOD("set_deferred_thread_group", "property", "value"), &Node::set_deferred_thread_group);
+	ClassDB::bind_method(D_METHOD("notify_deferred_thread_group", "what"), &Node::notify_deferred_thread_group);
 	ClassDB::bind_method(D_METHOD("can_process"), &Node::can_process);
 
 	ClassDB::bind_method(D_METHOD("set_display_folded", "fold"), &Node::set_display_folded);
@@ -2944,6 +3083,14 @@ void Node::_bind_methods() {
 
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "_import_path", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL), "_set_import_path", "_get_import_path");
 
+	{
+		MethodInfo mi;
+		mi.name = "call_deferred_thread_group";
+		mi.arguments.push_back(PropertyInfo(Variant::STRING_NAME, "method"));
+
+		ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "call_deferred_thread_group", &Node::_call_deferred_thread_group_bind, mi, varray(), false);
+	}
+
 	{
 		MethodInfo mi;
 
@@ -3011,6 +3158,10 @@ void Node::_bind_methods() {
 	BIND_ENUM_CONSTANT(PROCESS_MODE_ALWAYS);
 	BIND_ENUM_CONSTANT(PROCESS_MODE_DISABLED);
 
+	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_INHERIT);
+	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_MAIN_THREAD);
+	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_SUB_THREAD);
+
 	BIND_ENUM_CONSTANT(DUPLICATE_SIGNALS);
 	BIND_ENUM_CONSTANT(DUPLICATE_GROUPS);
 	BIND_ENUM_CONSTANT(DUPLICATE_SCRIPTS);
@@ -3037,6 +3188,7 @@ void Node::_bind_methods() {
 	ADD_GROUP("Process", "process_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_mode", PROPERTY_HINT_ENUM, "Inherit,Pausable,When Paused,Always,Disabled"), "set_process_mode", "get_process_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_priority"), "set_process_priority", "get_process_priority");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_group", PROPERTY_HINT_ENUM, "Inherit,Main Thread,Sub Thread"), "set_process_thread_group", "get_process_thread_group");
 
 	ADD_GROUP("Editor Description", "editor_");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "editor_description", PROPERTY_HINT_MULTILINE_TEXT), "set_editor_description", "get_editor_description");
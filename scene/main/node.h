@@ -42,6 +42,12 @@ class SceneState;
 class Tween;
 class PropertyTweener;
 
+// While process thread groups are processed on sub-threads, nodes of other groups must not be accessed,
+// and the scene tree (shared by all groups) must not be changed. Use the *_deferred_thread_group() functions instead.
+#define ERR_THREAD_GUARD ERR_FAIL_COND_MSG(!is_accessible_from_caller_thread(), "Caller thread can't call this function on node '" + String(get_name()) + "', as it belongs to another process thread group. Use call_deferred_thread_group() or set_deferred_thread_group() instead.");
+#define ERR_THREAD_GUARD_V(m_ret) ERR_FAIL_COND_V_MSG(!is_accessible_from_caller_thread(), (m_ret), "Caller thread can't call this function on node '" + String(get_name()) + "', as it belongs to another process thread group. Use call_deferred_thread_group() or set_deferred_thread_group() instead.");
+#define ERR_MAIN_THREAD_GUARD ERR_FAIL_COND_MSG(!is_tree_editable_from_caller_thread(), "Caller thread can't call this function on node '" + String(get_name()) + "' while processing a process thread group, as it changes the scene tree. Use call_deferred_thread_group() or set_deferred_thread_group() instead.");
+
 class Node : public Object {
 	GDCLASS(Node, Object);
 
@@ -54,6 +60,12 @@ public:
 		PROCESS_MODE_DISABLED, // never process
 	};
 
+	enum ProcessThreadGroup {
+		PROCESS_THREAD_GROUP_INHERIT, // same as parent node
+		PROCESS_THREAD_GROUP_MAIN_THREAD, // processed on the main thread
+		PROCESS_THREAD_GROUP_SUB_THREAD, // this node and inheriting children are processed together, in parallel with other sub-thread groups
+	};
+
 	enum DuplicateFlags {
 		DUPLICATE_SIGNALS = 1,
 		DUPLICATE_GROUPS = 2,
@@ -128,6 +140,9 @@ private:
 		ProcessMode process_mode = PROCESS_MODE_INHERIT;
 		Node *process_owner = nullptr;
 
+		ProcessThreadGroup process_thread_group = PROCESS_THREAD_GROUP_INHERIT;
+		Node *process_thread_group_owner = nullptr; // nullptr when processed on the main thread.
+
 		int multiplayer_authority = 1; // Server by default.
 		Variant rpc_config;
 
@@ -175,6 +190,7 @@ private:
 	void _propagate_exit_tree();
 	void _propagate_after_exit_tree();
 	void _propagate_process_owner(Node *p_owner, int p_pause_notification, int p_enabled_notification);
+	void _propagate_process_thread_group_owner(Node *p_owner);
 	void _propagate_groups_dirty();
 	Array _get_node_and_resource(const NodePath &p_path);
 
@@ -184,6 +200,7 @@ private:
 	TypedArray<Node> _get_children(bool p_include_internal = true) const;
 	TypedArray<StringName> _get_groups() const;
 
+	Variant _call_deferred_thread_group_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	Error _rpc_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	Error _rpc_id_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 
@@ -192,6 +209,8 @@ private:
 
 	friend class SceneTree;
 
+	static thread_local Node *current_process_thread_group; // Owner of the group processed by the caller thread, if any.
+
 	void _set_tree(SceneTree *p_tree);
 	void _propagate_pause_notification(bool p_enable);
 
@@ -456,6 +475,31 @@ public:
 	bool can_process_notification(int p_what) const;
 	bool is_enabled() const;
 
+	void set_process_thread_group(ProcessThreadGroup p_mode);
+	ProcessThreadGroup get_process_thread_group() const;
+
+	// Nodes outside the tree can always be accessed, nodes inside it only when not processing a sub-thread group, or from the thread processing their group.
+	_FORCE_INLINE_ bool is_accessible_from_caller_thread() const {
+		return !current_process_thread_group || !data.inside_tree || data.process_thread_group_owner == current_process_thread_group;
+	}
+	_FORCE_INLINE_ bool is_tree_editable_from_caller_thread() const {
+		return !current_process_thread_group || !data.inside_tree;
+	}
+
+	// Deferred to the end of the sub-thread processing phase when called while processing a sub-thread group, or regular deferred calls otherwise.
+	void call_deferred_thread_groupp(const StringName &p_method, const Variant **p_args, int p_argcount);
+	template <typename... VarArgs>
+	void call_deferred_thread_group(const StringName &p_method, VarArgs... p_args) {
+		Variant args[sizeof...(p_args) + 1] = { p_args..., Variant() }; // +1 makes sure zero sized arrays are also supported.
+		const Variant *argptrs[sizeof...(p_args) + 1];
+		for (uint32_t i = 0; i < sizeof...(p_args); i++) {
+			argptrs[i] = &args[i];
+		}
+		call_deferred_thread_groupp(p_method, sizeof...(p_args) == 0 ? nullptr : (const Variant **)argptrs, sizeof...(p_args));
+	}
+	void set_deferred_thread_group(const StringName &p_property, const Variant &p_value);
+	void notify_deferred_thread_group(int p_notification);
+
 	void request_ready();
 
 	static void print_orphan_nodes();
@@ -32,12 +32,14 @@
 
 #include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/engine_trace.h"
 #include "core/input/input.h"
 #include "core/io/dir_access.h"
 #include "core/io/image_loader.h"
 #include "core/io/marshalls.h"
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/keyboard.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
@@ -412,6 +414,7 @@ void SceneTree::initialize() {
 }
 
 bool SceneTree::physics_process(double p_time) {
+	TRACE_SCOPE("SceneTree::physics_process");
 	root_lock++;
 
 	current_frame++;
@@ -443,6 +446,7 @@ bool SceneTree::physics_process(double p_time) {
 }
 
 bool SceneTree::process(double p_time) {
+	TRACE_SCOPE("SceneTree::process");
 	root_lock++;
 
 	MainLoop::process(p_time);
@@ -858,12 +862,21 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
 
 	call_lock++;
 
+	bool use_process_groups = !process_groups.is_empty() && (p_notification == Node::NOTIFICATION_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PROCESS || p_notification == Node::NOTIFICATION_PHYSICS_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
+	if (use_process_groups) {
+		_process_sub_thread_groups(gr_nodes, gr_node_count, p_notification);
+	}
+
 	for (int i = 0; i < gr_node_count; i++) {
 		Node *n = gr_nodes[i];
 		if (call_lock && call_skip.has(n)) {
 			continue;
 		}
 
+		if (use_process_groups && n->data.process_thread_group_owner) {
+			continue; // Already processed in its group.
+		}
+
 		if (!n->can_process()) {
 			continue;
 		}
@@ -881,6 +894,98 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
 	}
 }
 
+void SceneTree::_add_process_group(Node *p_owner) {
+	ERR_FAIL_COND(process_groups.has(p_owner));
+	ProcessGroup *pg = memnew(ProcessGroup);
+	pg->owner = p_owner;
+	process_groups.insert(p_owner, pg);
+}
+
+void SceneTree::_remove_process_group(Node *p_owner) {
+	HashMap<Node *, ProcessGroup *>::Iterator E = process_groups.find(p_owner);
+	ERR_FAIL_COND(!E);
+	ERR_FAIL_COND_MSG(!active_process_groups.is_empty(), "Can't remove a process group while sub-thread groups are being processed.");
+	memdelete(E->value);
+	process_groups.remove(E);
+}
+
+void SceneTree::_process_group_task(uint32_t p_index, int p_notification) {
+	ProcessGroup *pg = active_process_groups[p_index];
+	current_process_group = pg;
+	Node::current_process_thread_group = pg->owner;
+
+	for (Node *n : pg->nodes) {
+		if (call_skip.has(n)) {
+			continue;
+		}
+		if (!n->can_process()) {
+			continue;
+		}
+		if (!n->can_process_notification(p_notification)) {
+			continue;
+		}
+
+		n->notification(p_notification);
+	}
+
+	current_process_group = nullptr;
+	Node::current_process_thread_group = nullptr;
+}
+
+void SceneTree::_process_sub_thread_groups(Node **p_nodes, int p_node_count, int p_notification) {
+	// Nodes keep their relative order inside each group, groups are processed in parallel.
+	for (int i = 0; i < p_node_count; i++) {
+		Node *owner = p_nodes[i]->data.process_thread_group_owner;
+		if (!owner) {
+			continue;
+		}
+		ProcessGroup *pg = process_groups[owner];
+		if (pg->nodes.is_empty()) {
+			active_process_groups.push_back(pg);
+		}
+		pg->nodes.push_back(p_nodes[i]);
+	}
+
+	if (active_process_groups.is_empty()) {
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneTree::_process_group_task, p_notification, active_process_groups.size(), -1, true, SNAME("SceneTreeProcessGroups"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Flush on the main thread, in group order so results don't depend on thread scheduling.
+	// Calls are collected first, as they may add or remove process groups.
+	LocalVector<Callable> calls;
+	for (ProcessGroup *pg : active_process_groups) {
+		pg->nodes.clear();
+		for (const Callable &callable : pg->deferred_calls) {
+			calls.push_back(callable);
+		}
+		pg->deferred_calls.clear();
+	}
+	active_process_groups.clear();
+
+	for (const Callable &callable : calls) {
+		if (!callable.is_valid()) {
+			continue; // Object was freed meanwhile.
+		}
+		Variant ret;
+		Callable::CallError ce;
+		callable.callp(nullptr, 0, ret, ce);
+		if (ce.error != Callable::CallError::CALL_OK) {
+			ERR_PRINT("Error calling deferred thread group method: " + Variant::get_callable_error_text(callable, nullptr, 0, ce) + ".");
+		}
+	}
+}
+
+bool SceneTree::push_process_group_call(const Callable &p_callable) {
+	if (!current_process_group) {
+		return false;
+	}
+	current_process_group->deferred_calls.push_back(p_callable);
+	return true;
+}
+
 void SceneTree::_call_input_pause(const StringName &p_group, CallInputType p_call_type, const Ref<InputEvent> &p_input, Viewport *p_viewport) {
 	HashMap<StringName, Group>::Iterator E = group_map.find(p_group);
 	if (!E) {
@@ -1340,6 +1445,7 @@ void SceneTree::_bind_methods() {
 }
 
 SceneTree *SceneTree::singleton = nullptr;
+thread_local SceneTree::ProcessGroup *SceneTree::current_process_group = nullptr;
 
 SceneTree::IdleCallback SceneTree::idle_callbacks[SceneTree::MAX_IDLE_CALLBACKS];
 int SceneTree::idle_callback_count = 0;
@@ -33,6 +33,7 @@
 
 #include "core/os/main_loop.h"
 #include "core/os/thread_safe.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/self_list.h"
 #include "scene/resources/mesh.h"
 
@@ -137,6 +138,23 @@ private:
 	int call_lock = 0;
 	HashSet<Node *> call_skip; // Skip erased nodes.
 
+	// Nodes under a PROCESS_THREAD_GROUP_SUB_THREAD owner are processed on the WorkerThreadPool, one task per owner.
+	// Calls deferred with Node::call_deferred_thread_group() while doing so are flushed on the main thread afterward.
+	struct ProcessGroup {
+		Node *owner = nullptr;
+		LocalVector<Node *> nodes; // Only valid while processing.
+		LocalVector<Callable> deferred_calls;
+	};
+
+	HashMap<Node *, ProcessGroup *> process_groups;
+	LocalVector<ProcessGroup *> active_process_groups;
+	static thread_local ProcessGroup *current_process_group;
+
+	void _add_process_group(Node *p_owner);
+	void _remove_process_group(Node *p_owner);
+	void _process_group_task(uint32_t p_index, int p_notification);
+	void _process_sub_thread_groups(Node **p_nodes, int p_node_count, int p_notification);
+
 	List<ObjectID> delete_queue;
 
 	HashMap<UGCall, Vector<Variant>, UGCall> unique_group_calls;
@@ -275,6 +293,9 @@ public:
 
 	void flush_transform_notifications();
 
+	// Returns false if not called from a process group thread.
+	static bool push_process_group_call(const Callable &p_callable);
+
 	virtual void initialize() override;
 
 	virtual bool physics_process(double p_time) override;
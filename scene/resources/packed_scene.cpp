@@ -70,18 +70,70 @@ static Array _sanitize_node_pinned_properties(Node *p_node) {
 	return pinned;
 }
 
+void SceneState::_build_instantiation_plan() const {
+	MutexLock lock(instantiation_plan_mutex);
+	if (instantiation_plan_ready.is_set()) {
+		return; // Built by another thread while waiting.
+	}
+
+	instantiation_plan_offsets.resize(nodes.size());
+	instantiation_plan_setters.clear();
+
+	for (int i = 0; i < nodes.size(); i++) {
+		const NodeData &n = nodes[i];
+		instantiation_plan_offsets[i] = instantiation_plan_setters.size();
+
+		// Only nodes created from a built-in class can have their setters resolved ahead of time,
+		// instances and extension classes may handle properties in their own way.
+		bool from_class = n.instance < 0 && n.type != TYPE_INSTANTIATED && !(i == 0 && base_scene_idx >= 0) && n.type >= 0 && n.type < names.size();
+		StringName type;
+		if (from_class) {
+			type = names[n.type];
+			// Missing classes are reported when the node is instantiated.
+			from_class = ClassDB::class_exists(type);
+			if (from_class) {
+				ClassDB::APIType api = ClassDB::get_api_type(type);
+				from_class = api != ClassDB::API_EXTENSION && api != ClassDB::API_EDITOR_EXTENSION;
+			}
+		}
+
+		for (const NodeData::Property &prop : n.properties) {
+			InstantiationSetter setter;
+			if (from_class && !(prop.name & FLAG_PATH_PROPERTY_IS_NODE) && prop.name >= 0 && prop.name < names.size() && names[prop.name] != CoreStringNames::get_singleton()->_script) {
+				bool valid = false;
+				int index = ClassDB::get_property_index(type, names[prop.name], &valid);
+				StringName setter_name = valid ? ClassDB::get_property_setter(type, names[prop.name]) : StringName();
+				if (setter_name != StringName()) {
+					setter.setter = ClassDB::get_method(type, setter_name);
+					setter.index = index;
+				}
+			}
+			instantiation_plan_setters.push_back(setter);
+		}
+	}
+
+	instantiation_plan_ready.set();
+}
+
+void SceneState::_clear_instantiation_plan() {
+	MutexLock lock(instantiation_plan_mutex);
+	instantiation_plan_ready.clear();
+	instantiation_plan_offsets.clear();
+	instantiation_plan_setters.clear();
+}
+
 Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	// Nodes where instantiation failed (because something is missing.)
 	List<Node *> stray_instances;
 
-#define NODE_FROM_ID(p_name, p_id)                      \
-	Node *p_name;                                       \
-	if (p_id & FLAG_ID_IS_PATH) {                       \
-		NodePath np = node_paths[p_id & FLAG_MASK];     \
-		p_name = ret_nodes[0]->get_node_or_null(np);    \
-	} else {                                            \
-		ERR_FAIL_INDEX_V(p_id &FLAG_MASK, nc, nullptr); \
-		p_name = ret_nodes[p_id & FLAG_MASK];           \
+#define NODE_FROM_ID(p_name, p_id)                         \
+	Node *p_name;                                          \
+	if (p_id & FLAG_ID_IS_PATH) {                          \
+		const NodePath &np = node_paths[p_id & FLAG_MASK]; \
+		p_name = ret_nodes[0]->get_node_or_null(np);       \
+	} else {                                               \
+		ERR_FAIL_INDEX_V(p_id &FLAG_MASK, nc, nullptr);    \
+		p_name = ret_nodes[p_id & FLAG_MASK];              \
 	}
 
 	int nc = nodes.size();
@@ -111,6 +163,13 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 	LocalVector<DeferredNodePathProperties> deferred_node_paths;
 
+	// Plain runtime instantiation goes through setters resolved ahead of time.
+	// The editor needs the regular path, as it tracks edits made through Object::set().
+	bool use_plan = p_edit_state == GEN_EDIT_STATE_DISABLED && !Engine::get_singleton()->is_editor_hint();
+	if (use_plan && !instantiation_plan_ready.is_set()) {
+		_build_instantiation_plan();
+	}
+
 	for (int i = 0; i < nc; i++) {
 		const NodeData &n = nd[i];
 
@@ -136,6 +195,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 		Node *node = nullptr;
 		MissingNode *missing_node = nullptr;
+		bool created_from_class = false;
 
 		if (i == 0 && base_scene_idx >= 0) {
 			//scene inheritance on root node
@@ -184,6 +244,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			Object *obj = ClassDB::instantiate(snames[n.type]);
 
 			node = Object::cast_to<Node>(obj);
+			created_from_class = node != nullptr;
 
 			if (!node) {
 				if (obj) {
@@ -229,6 +290,12 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			if (nprop_count) {
 				const NodeData::Property *nprops = &n.properties[0];
 
+				// Compatibility classes may have created a node of another type, in which case the plan doesn't apply.
+				const InstantiationSetter *nsetters = nullptr;
+				if (use_plan && created_from_class && node->get_class_name() == snames[n.type]) {
+					nsetters = instantiation_plan_setters.ptr() + instantiation_plan_offsets[i];
+				}
+
 				Dictionary missing_resource_properties;
 
 				for (int j = 0; j < nprop_count; j++) {
@@ -340,7 +407,19 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 						}
 
 						if (set_valid) {
-							node->set(snames[nprops[j].name], value, &valid);
+							if (nsetters && nsetters[j].setter && !node->get_script_instance()) {
+								Callable::CallError ce;
+								if (nsetters[j].index >= 0) {
+									Variant index = nsetters[j].index;
+									const Variant *args[2] = { &index, &value };
+									nsetters[j].setter->call(node, args, 2, ce);
+								} else {
+									const Variant *args[1] = { &value };
+									nsetters[j].setter->call(node, args, 1, ce);
+								}
+							} else {
+								node->set(snames[nprops[j].name], value, &valid);
+							}
 						}
 					}
 				}
@@ -398,7 +477,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			if (p_edit_state == GEN_EDIT_STATE_MAIN) {
 				_sanitize_node_pinned_properties(node);
 			} else {
-				node->remove_meta("_edit_pinned_properties_");
+				node->remove_meta(SNAME("_edit_pinned_properties_"));
 			}
 		}
 
@@ -1006,6 +1085,7 @@ String SceneState::get_path() const {
 }
 
 void SceneState::clear() {
+	_clear_instantiation_plan();
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1206,6 +1286,8 @@ bool SceneState::is_connection(int p_node, const StringName &p_signal, int p_to_
 }
 
 void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
+	_clear_instantiation_plan();
+
 	ERR_FAIL_COND(!p_dictionary.has("names"));
 	ERR_FAIL_COND(!p_dictionary.has("variants"));
 	ERR_FAIL_COND(!p_dictionary.has("node_count"));
@@ -1683,6 +1765,7 @@ int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int
 	nd.instance = p_instance;
 	nd.index = p_index;
 
+	_clear_instantiation_plan();
 	nodes.push_back(nd);
 
 	return nodes.size() - 1;
@@ -1699,6 +1782,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 		prop.name |= FLAG_PATH_PROPERTY_IS_NODE;
 	}
 	prop.value = p_value;
+	_clear_instantiation_plan();
 	nodes.write[p_node].properties.push_back(prop);
 }
 
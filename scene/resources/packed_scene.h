@@ -32,6 +32,7 @@
 #define PACKED_SCENE_H
 
 #include "core/io/resource.h"
+#include "core/templates/local_vector.h"
 #include "scene/main/node.h"
 
 class SceneState : public RefCounted {
@@ -89,6 +90,21 @@ class SceneState : public RefCounted {
 
 	Vector<ConnectionData> connections;
 
+	struct InstantiationSetter {
+		MethodBind *setter = nullptr;
+		int index = -1;
+	};
+
+	// Property setters resolved once per scene, so instantiating at runtime
+	// doesn't need to look every property up by name on each node.
+	mutable Mutex instantiation_plan_mutex;
+	mutable SafeFlag instantiation_plan_ready;
+	mutable LocalVector<uint32_t> instantiation_plan_offsets;
+	mutable LocalVector<InstantiationSetter> instantiation_plan_setters;
+
+	void _build_instantiation_plan() const;
+	void _clear_instantiation_plan();
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 
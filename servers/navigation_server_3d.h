@@ -257,6 +257,11 @@ public:
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const = 0;
 
+	/// Runs a batch of path queries on the worker threads, against the maps as they were last synced.
+	/// The results are passed to the callback when the server is next processed.
+	virtual uint32_t query_path_batch(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const Callable &p_callback) = 0;
+	virtual bool is_path_query_batch_completed(uint32_t p_batch_id) const = 0;
+
 	NavigationServer3D();
 	~NavigationServer3D() override;
 
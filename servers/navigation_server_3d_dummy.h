@@ -111,6 +111,8 @@ public:
 	void set_active(bool p_active) override {}
 	void process(real_t delta_time) override {}
 	NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const override { return NavigationUtilities::PathQueryResult(); }
+	uint32_t query_path_batch(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const Callable &p_callback) override { return 0; }
+	bool is_path_query_batch_completed(uint32_t p_batch_id) const override { return true; }
 	int get_process_info(ProcessInfo p_info) const override { return 0; }
 	void set_debug_enabled(bool p_enabled) {}
 	bool get_debug_enabled() const { return false; }
@@ -106,6 +106,12 @@ class GodotBody2D : public GodotCollisionObject2D {
 	virtual void _shapes_changed() override;
 	Transform2D new_transform;
 
+	// Broadphase and space updates deferred by the integration steps, which can run on worker threads.
+	Vector2 pending_motion;
+	bool pending_motion_update = false;
+	bool pending_shapes_update = false;
+	bool pending_deactivation = false;
+
 	List<Pair<GodotConstraint2D *, int>> constraint_list;
 
 	struct AreaCMP {
@@ -314,8 +320,11 @@ public:
 	_FORCE_INLINE_ real_t get_friction() const { return friction; }
 	_FORCE_INLINE_ real_t get_bounce() const { return bounce; }
 
+	// Safe to call concurrently for different bodies, must be followed by the matching finalize call on the physics thread.
 	void integrate_forces(real_t p_step);
+	void finalize_integrate_forces();
 	void integrate_velocities(real_t p_step);
+	void finalize_integrate_velocities();
 
 	_FORCE_INLINE_ Vector2 get_velocity_in_local_point(const Vector2 &rel_pos) const {
 		return linear_velocity + Vector2(-angular_velocity * rel_pos.y, angular_velocity * rel_pos.x);
@@ -101,27 +101,38 @@ void GodotStep2D::_solve_island(uint32_t p_island_index, void *p_userdata) const
 	}
 }
 
-void GodotStep2D::_check_suspend(LocalVector<GodotBody2D *> &p_body_island) const {
+void GodotStep2D::_check_suspend(uint32_t p_island_index, void *p_userdata) {
+	const LocalVector<GodotBody2D *> &body_island = body_islands[p_island_index];
+
 	bool can_sleep = true;
 
-	uint32_t body_count = p_body_island.size();
+	uint32_t body_count = body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
-		GodotBody2D *body = p_body_island[body_index];
+		GodotBody2D *body = body_island[body_index];
 
 		if (!body->sleep_test(delta)) {
 			can_sleep = false;
 		}
 	}
 
-	// Put all to sleep or wake up everyone.
-	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
-		GodotBody2D *body = p_body_island[body_index];
+	// Activation changes the space's active list, so it's applied afterwards on the physics thread.
+	body_island_can_sleep[p_island_index] = can_sleep;
+}
 
-		bool active = body->is_active();
+void GodotStep2D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
 
-		if (active == can_sleep) {
-			body->set_active(!can_sleep);
-		}
+void GodotStep2D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
+void GodotStep2D::_fill_active_bodies(const SelfList<GodotBody2D>::List &p_body_list) {
+	active_bodies.clear();
+	const SelfList<GodotBody2D> *b = p_body_list.first();
+	while (b) {
+		active_bodies.push_back(b->self());
+		b = b->next();
 	}
 }
 
@@ -142,16 +153,18 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	_fill_active_bodies(*body_list);
+	uint32_t body_count = active_bodies.size();
 
-	const SelfList<GodotBody2D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_integrate_forces, nullptr, body_count, -1, true, SNAME("Physics2DIntegrateForces"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Warning: Broadphase updates are not thread-safe, so they're applied here once all bodies are integrated.
+	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
+		active_bodies[body_index]->finalize_integrate_forces();
 	}
 
-	p_space->set_active_objects(active_count);
+	p_space->set_active_objects((int)body_count);
 
 	// Update the broadphase to register collision pairs.
 	p_space->update();
@@ -192,7 +205,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
+	const SelfList<GodotBody2D> *b = body_list->first();
 
 	uint32_t body_island_count = 0;
 
@@ -240,7 +253,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -271,17 +284,33 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody2D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n; // in case it shuts itself down
+	// Solving constraints can wake up bodies, so the active list needs to be gathered again.
+	_fill_active_bodies(*body_list);
+	body_count = active_bodies.size();
+
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_integrate_velocities, nullptr, body_count, -1, true, SNAME("Physics2DIntegrateVelocities"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
+		active_bodies[body_index]->finalize_integrate_velocities();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
 
+	body_island_can_sleep.resize(body_island_count);
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_check_suspend, nullptr, body_island_count, -1, true, SNAME("Physics2DCheckSuspend"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Put all to sleep or wake up everyone.
 	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
-		_check_suspend(body_islands[island_index]);
+		const LocalVector<GodotBody2D *> &body_island = body_islands[island_index];
+		bool can_sleep = body_island_can_sleep[island_index];
+
+		for (GodotBody2D *body : body_island) {
+			if (body->is_active() == can_sleep) {
+				body->set_active(!can_sleep);
+			}
+		}
 	}
 
 	{ //profile
@@ -41,7 +41,9 @@ class GodotStep2D {
 	int iterations = 0;
 	real_t delta = 0.0;
 
+	LocalVector<GodotBody2D *> active_bodies;
 	LocalVector<LocalVector<GodotBody2D *>> body_islands;
+	LocalVector<bool> body_island_can_sleep;
 	LocalVector<LocalVector<GodotConstraint2D *>> constraint_islands;
 	LocalVector<GodotConstraint2D *> all_constraints;
 
@@ -49,7 +51,10 @@ class GodotStep2D {
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint2D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr) const;
-	void _check_suspend(LocalVector<GodotBody2D *> &p_body_island) const;
+	void _check_suspend(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _integrate_forces(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _integrate_velocities(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _fill_active_bodies(const SelfList<GodotBody2D>::List &p_body_list);
 
 public:
 	void step(GodotSpace2D *p_space, real_t p_delta);
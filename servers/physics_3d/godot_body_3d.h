@@ -112,6 +112,12 @@ class GodotBody3D : public GodotCollisionObject3D {
 	virtual void _shapes_changed() override;
 	Transform3D new_transform;
 
+	// Broadphase and space updates deferred by the integration steps, which can run on worker threads.
+	Vector3 pending_motion;
+	bool pending_motion_update = false;
+	bool pending_shapes_update = false;
+	bool pending_deactivation = false;
+
 	HashMap<GodotConstraint3D *, int> constraint_map;
 
 	Vector<AreaCMP> areas;
@@ -315,8 +321,11 @@ public:
 	void set_axis_lock(PhysicsServer3D::BodyAxis p_axis, bool lock);
 	bool is_axis_locked(PhysicsServer3D::BodyAxis p_axis) const;
 
+	// Safe to call concurrently for different bodies, must be followed by the matching finalize call on the physics thread.
 	void integrate_forces(real_t p_step);
+	void finalize_integrate_forces();
 	void integrate_velocities(real_t p_step);
+	void finalize_integrate_velocities();
 
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
@@ -67,6 +67,7 @@ class GodotBroadPhase3DBVH : public GodotBroadPhase3D {
 
 	static void *_pair_callback(void *, uint32_t, GodotCollisionObject3D *, int, uint32_t, GodotCollisionObject3D *, int);
 	static void _unpair_callback(void *, uint32_t, GodotCollisionObject3D *, int, uint32_t, GodotCollisionObject3D *, int, void *);
+	static void _parallel_for_callback(void *, void (*)(void *, uint32_t), void *, uint32_t);
 
 	PairCallback pair_callback = nullptr;
 	void *pair_userdata = nullptr;
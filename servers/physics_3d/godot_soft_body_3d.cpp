@@ -190,23 +190,23 @@ void GodotSoftBody3D::update_normals_and_centroids() {
 }
 
 void GodotSoftBody3D::update_bounds() {
+	compute_bounds();
+	update_shape_bounds();
+}
+
+void GodotSoftBody3D::compute_bounds() {
 	AABB prev_bounds = bounds;
 	prev_bounds.grow_by(collision_margin);
 
 	bounds = AABB();
-
-	const uint32_t nodes_count = nodes.size();
-	if (nodes_count == 0) {
-		deinitialize_shape();
-		return;
-	}
+	bounds_moved = false;
 
 	bool first = true;
-	bool moved = false;
+	const uint32_t nodes_count = nodes.size();
 	for (uint32_t node_index = 0; node_index < nodes_count; ++node_index) {
 		const Node &node = nodes[node_index];
 		if (!prev_bounds.has_point(node.x)) {
-			moved = true;
+			bounds_moved = true;
 		}
 		if (first) {
 			bounds.position = node.x;
@@ -215,9 +215,17 @@ void GodotSoftBody3D::update_bounds() {
 			bounds.expand_to(node.x);
 		}
 	}
+}
+
+void GodotSoftBody3D::update_shape_bounds() {
+	// Updates the broadphase, not thread-safe.
+	if (nodes.size() == 0) {
+		deinitialize_shape();
+		return;
+	}
 
 	if (get_space()) {
-		initialize_shape(moved);
+		initialize_shape(bounds_moved);
 	}
 }
 
@@ -1043,8 +1051,8 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 		node.f = Vector3();
 	}
 
-	// Bounds and tree update.
-	update_bounds();
+	// Bounds and tree update, the shape is updated in finalize_predict_motion.
+	compute_bounds();
 
 	// Node tree update.
 	for (const Node &node : nodes) {
@@ -1065,6 +1073,10 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 	face_tree.optimize_incremental(1);
 }
 
+void GodotSoftBody3D::finalize_predict_motion() {
+	update_shape_bounds();
+}
+
 void GodotSoftBody3D::solve_constraints(real_t p_delta) {
 	const real_t inv_delta = 1.0 / p_delta;
 
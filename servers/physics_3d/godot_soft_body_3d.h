@@ -88,6 +88,7 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 	LocalVector<uint32_t> map_visual_to_physics;
 
 	AABB bounds;
+	bool bounds_moved = false;
 
 	real_t collision_margin = 0.05;
 
@@ -201,7 +202,9 @@ public:
 	void set_drag_coefficient(real_t p_val);
 	_FORCE_INLINE_ real_t get_drag_coefficient() const { return drag_coefficient; }
 
+	// Safe to call concurrently for different soft bodies, predict_motion must be followed by finalize_predict_motion on the physics thread.
 	void predict_motion(real_t p_delta);
+	void finalize_predict_motion();
 	void solve_constraints(real_t p_delta);
 
 	_FORCE_INLINE_ uint32_t get_node_index(void *p_node) const { return static_cast<Node *>(p_node)->index; }
@@ -220,6 +223,8 @@ protected:
 private:
 	void update_normals_and_centroids();
 	void update_bounds();
+	void compute_bounds();
+	void update_shape_bounds();
 	void update_constants();
 	void update_area();
 	void reset_link_rest_lengths();
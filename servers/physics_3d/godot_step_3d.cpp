@@ -32,6 +32,7 @@
 
 #include "godot_joint_3d.h"
 
+#include "core/debugger/engine_trace.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
@@ -158,31 +159,51 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	}
 }
 
-void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
+void GodotStep3D::_check_suspend(uint32_t p_island_index, void *p_userdata) {
+	const LocalVector<GodotBody3D *> &body_island = body_islands[p_island_index];
+
 	bool can_sleep = true;
 
-	uint32_t body_count = p_body_island.size();
+	uint32_t body_count = body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
-		GodotBody3D *body = p_body_island[body_index];
+		GodotBody3D *body = body_island[body_index];
 
 		if (!body->sleep_test(delta)) {
 			can_sleep = false;
 		}
 	}
 
-	// Put all to sleep or wake up everyone.
-	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
-		GodotBody3D *body = p_body_island[body_index];
+	// Activation changes the space's active list, so it's applied afterwards on the physics thread.
+	body_island_can_sleep[p_island_index] = can_sleep;
+}
 
-		bool active = body->is_active();
+void GodotStep3D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
 
-		if (active == can_sleep) {
-			body->set_active(!can_sleep);
-		}
+void GodotStep3D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
+void GodotStep3D::_predict_soft_body_motion(uint32_t p_soft_body_index, void *p_userdata) {
+	active_soft_bodies[p_soft_body_index]->predict_motion(delta);
+}
+
+void GodotStep3D::_solve_soft_body_constraints(uint32_t p_soft_body_index, void *p_userdata) {
+	active_soft_bodies[p_soft_body_index]->solve_constraints(delta);
+}
+
+void GodotStep3D::_fill_active_bodies(const SelfList<GodotBody3D>::List &p_body_list) {
+	active_bodies.clear();
+	const SelfList<GodotBody3D> *b = p_body_list.first();
+	while (b) {
+		active_bodies.push_back(b->self());
+		b = b->next();
 	}
 }
 
 void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
+	TRACE_SCOPE("GodotStep3D::step");
 	p_space->lock(); // can't access space during this
 
 	p_space->setup(); //update inertias, etc
@@ -201,25 +222,36 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	_fill_active_bodies(*body_list);
 
-	const SelfList<GodotBody3D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	active_soft_bodies.clear();
+	const SelfList<GodotSoftBody3D> *sb = soft_body_list->first();
+	while (sb) {
+		active_soft_bodies.push_back(sb->self());
+		sb = sb->next();
 	}
 
+	uint32_t body_count = active_bodies.size();
+	uint32_t soft_body_count = active_soft_bodies.size();
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_forces, nullptr, body_count, -1, true, SNAME("Physics3DIntegrateForces"));
+
 	/* UPDATE SOFT BODY MOTION */
 
-	const SelfList<GodotSoftBody3D> *sb = soft_body_list->first();
-	while (sb) {
-		sb->self()->predict_motion(p_delta);
-		sb = sb->next();
-		active_count++;
+	WorkerThreadPool::GroupID soft_body_group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_predict_soft_body_motion, nullptr, soft_body_count, -1, true, SNAME("Physics3DSoftBodyPredictMotion"));
+
+	// Warning: Broadphase updates are not thread-safe, so they're applied here once all bodies are integrated.
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
+		active_bodies[body_index]->finalize_integrate_forces();
+	}
+
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(soft_body_group_task);
+	for (uint32_t soft_body_index = 0; soft_body_index < soft_body_count; ++soft_body_index) {
+		active_soft_bodies[soft_body_index]->finalize_predict_motion();
 	}
 
-	p_space->set_active_objects(active_count);
+	p_space->set_active_objects((int)(body_count + soft_body_count));
 
 	// Update the broadphase to register collision pairs.
 	p_space->update();
@@ -260,7 +292,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
+	const SelfList<GodotBody3D> *b = body_list->first();
 
 	uint32_t body_island_count = 0;
 
@@ -344,7 +376,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -375,27 +407,42 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
+	// Solving constraints can wake up bodies, so the active list needs to be gathered again.
+	_fill_active_bodies(*body_list);
+	body_count = active_bodies.size();
+
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_velocities, nullptr, body_count, -1, true, SNAME("Physics3DIntegrateVelocities"));
+
+	/* UPDATE SOFT BODY CONSTRAINTS */
+
+	// Soft bodies don't depend on rigid body integration, so they're solved while the rigid bodies are finalized.
+	soft_body_group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_soft_body_constraints, nullptr, soft_body_count, -1, true, SNAME("Physics3DSoftBodySolveConstraints"));
+
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
+		active_bodies[body_index]->finalize_integrate_velocities();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
 
-	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
-		_check_suspend(body_islands[island_index]);
-	}
+	body_island_can_sleep.resize(body_island_count);
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_check_suspend, nullptr, body_island_count, -1, true, SNAME("Physics3DCheckSuspend"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
-	/* UPDATE SOFT BODY CONSTRAINTS */
+	// Put all to sleep or wake up everyone.
+	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
+		const LocalVector<GodotBody3D *> &body_island = body_islands[island_index];
+		bool can_sleep = body_island_can_sleep[island_index];
 
-	sb = soft_body_list->first();
-	while (sb) {
-		sb->self()->solve_constraints(p_delta);
-		sb = sb->next();
+		for (GodotBody3D *body : body_island) {
+			if (body->is_active() == can_sleep) {
+				body->set_active(!can_sleep);
+			}
+		}
 	}
 
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(soft_body_group_task);
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_VELOCITIES, profile_endtime - profile_begtime);
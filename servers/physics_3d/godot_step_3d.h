@@ -41,7 +41,10 @@ class GodotStep3D {
 	int iterations = 0;
 	real_t delta = 0.0;
 
+	LocalVector<GodotBody3D *> active_bodies;
+	LocalVector<GodotSoftBody3D *> active_soft_bodies;
 	LocalVector<LocalVector<GodotBody3D *>> body_islands;
+	LocalVector<bool> body_island_can_sleep;
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
 
@@ -50,7 +53,12 @@ class GodotStep3D {
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
-	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
+	void _check_suspend(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _integrate_forces(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _integrate_velocities(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _predict_soft_body_motion(uint32_t p_soft_body_index, void *p_userdata = nullptr);
+	void _solve_soft_body_constraints(uint32_t p_soft_body_index, void *p_userdata = nullptr);
+	void _fill_active_bodies(const SelfList<GodotBody3D>::List &p_body_list);
 
 public:
 	void step(GodotSpace3D *p_space, real_t p_delta);
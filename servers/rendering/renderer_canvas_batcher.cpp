@@ -0,0 +1,302 @@
+/**************************************************************************/
+/*  renderer_canvas_batcher.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "renderer_canvas_batcher.h"
+
+bool RendererCanvasBatcher::_get_texture_size(RID p_texture, RS::CanvasItemTextureFilter p_filter, RS::CanvasItemTextureRepeat p_repeat, Size2 &r_size) {
+	if (last_size_valid && last_size_texture == p_texture) {
+		r_size = last_size;
+		return true;
+	}
+
+	last_size_valid = false;
+	if (!texture_size_func || !texture_size_func(texture_size_userdata, p_texture, p_filter, p_repeat, last_size) || last_size.x <= 0 || last_size.y <= 0) {
+		return false;
+	}
+
+	last_size_texture = p_texture;
+	last_size_valid = true;
+	r_size = last_size;
+	return true;
+}
+
+bool RendererCanvasBatcher::_get_item_texture(const Item *p_item, RS::CanvasItemTextureRepeat &r_repeat, RID &r_texture, bool &r_draws, bool &r_needs_size) const {
+	RS::CanvasItemTextureRepeat repeat = r_repeat;
+	r_draws = false;
+	r_needs_size = false;
+
+	for (const Item::Command *c = p_item->commands; c; c = c->next) {
+		RID texture;
+
+		switch (c->type) {
+			case Item::Command::TYPE_RECT: {
+				const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
+				if (rect->flags & (RendererCanvasRender::CANVAS_RECT_CLIP_UV | RendererCanvasRender::CANVAS_RECT_IS_GROUP | RendererCanvasRender::CANVAS_RECT_MSDF | RendererCanvasRender::CANVAS_RECT_LCD)) {
+					return false;
+				}
+				if (rect->flags & RendererCanvasRender::CANVAS_RECT_TILE) {
+					// Sticks for the rest of the item, like when drawing it on its own.
+					repeat = RS::CANVAS_ITEM_TEXTURE_REPEAT_ENABLED;
+				}
+				if (rect->texture.is_valid() && (rect->flags & RendererCanvasRender::CANVAS_RECT_REGION)) {
+					r_needs_size = true;
+				}
+				texture = rect->texture;
+			} break;
+			case Item::Command::TYPE_NINEPATCH: {
+				const Item::CommandNinePatch *np = static_cast<const Item::CommandNinePatch *>(c);
+				// Only stretching maps linearly to vertices, tiling is done per pixel.
+				if (np->texture.is_null() || np->axis_x != RS::NINE_PATCH_STRETCH || np->axis_y != RS::NINE_PATCH_STRETCH) {
+					return false;
+				}
+				if (np->rect.size.x <= 0 || np->rect.size.y <= 0 || np->rect.size.x < np->margin[SIDE_LEFT] + np->margin[SIDE_RIGHT] || np->rect.size.y < np->margin[SIDE_TOP] + np->margin[SIDE_BOTTOM]) {
+					return false;
+				}
+				r_needs_size = true;
+				texture = np->texture;
+			} break;
+			case Item::Command::TYPE_PRIMITIVE: {
+				const Item::CommandPrimitive *primitive = static_cast<const Item::CommandPrimitive *>(c);
+				if (primitive->point_count < 3 || primitive->point_count > 4) {
+					return false;
+				}
+				texture = primitive->texture;
+			} break;
+			case Item::Command::TYPE_TRANSFORM: {
+				continue; // Doesn't draw anything.
+			}
+			default: {
+				return false;
+			}
+		}
+
+		if (!r_draws) {
+			r_draws = true;
+			r_texture = texture;
+			r_repeat = repeat;
+		} else if (texture != r_texture || repeat != r_repeat) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void RendererCanvasBatcher::_add_vertex(const Transform2D &p_xform, const Vector2 &p_position, const Vector2 &p_uv, const Color &p_color) {
+	const Vector2 position = p_xform.xform(p_position);
+
+	Vertex vertex;
+	vertex.position[0] = position.x;
+	vertex.position[1] = position.y;
+	vertex.color[0] = p_color.r;
+	vertex.color[1] = p_color.g;
+	vertex.color[2] = p_color.b;
+	vertex.color[3] = p_color.a;
+	vertex.uv[0] = p_uv.x;
+	vertex.uv[1] = p_uv.y;
+	vertices.push_back(vertex);
+}
+
+void RendererCanvasBatcher::_add_quad(const Transform2D &p_xform, const Vector2 *p_points, const Vector2 *p_uvs, const Color &p_color) {
+	// Same split as the quad index array used when drawing rects.
+	static const uint32_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+	for (uint32_t i = 0; i < 6; i++) {
+		_add_vertex(p_xform, p_points[indices[i]], p_uvs[indices[i]], p_color);
+	}
+}
+
+void RendererCanvasBatcher::_add_item_vertices(const Item *p_item, const Transform2D &p_transform, const Size2 &p_texture_size) {
+	// Corners of a rect in the order the canvas shader expands them.
+	static const Vector2 corners[4] = { Vector2(0, 0), Vector2(0, 1), Vector2(1, 1), Vector2(1, 0) };
+
+	const Color &base_color = p_item->final_modulate;
+	Transform2D xform = p_transform;
+
+	for (const Item::Command *c = p_item->commands; c; c = c->next) {
+		switch (c->type) {
+			case Item::Command::TYPE_RECT: {
+				const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
+
+				Rect2 dst_rect = rect->rect;
+				if (dst_rect.size.width < 0) {
+					dst_rect.position.x += dst_rect.size.width;
+					dst_rect.size.width *= -1;
+				}
+				if (dst_rect.size.height < 0) {
+					dst_rect.position.y += dst_rect.size.height;
+					dst_rect.size.height *= -1;
+				}
+
+				Rect2 src_rect(0, 0, 1, 1);
+				bool transpose = false;
+				if (rect->texture.is_valid()) {
+					if (rect->flags & RendererCanvasRender::CANVAS_RECT_REGION) {
+						src_rect = Rect2(rect->source.position / p_texture_size, rect->source.size / p_texture_size);
+					}
+					if (rect->flags & RendererCanvasRender::CANVAS_RECT_FLIP_H) {
+						src_rect.size.x *= -1;
+					}
+					if (rect->flags & RendererCanvasRender::CANVAS_RECT_FLIP_V) {
+						src_rect.size.y *= -1;
+					}
+					transpose = rect->flags & RendererCanvasRender::CANVAS_RECT_TRANSPOSE;
+				}
+
+				Vector2 points[4];
+				Vector2 uvs[4];
+				for (int i = 0; i < 4; i++) {
+					const Vector2 &base = corners[i];
+					uvs[i] = src_rect.position + src_rect.size.abs() * (transpose ? Vector2(base.y, base.x) : base);
+					// Flipping mirrors the vertices rather than the UVs.
+					const Vector2 mirrored(src_rect.size.x < 0 ? 1.0 - base.x : base.x, src_rect.size.y < 0 ? 1.0 - base.y : base.y);
+					points[i] = dst_rect.position + dst_rect.size * mirrored;
+				}
+
+				_add_quad(xform, points, uvs, rect->modulate * base_color);
+			} break;
+			case Item::Command::TYPE_NINEPATCH: {
+				const Item::CommandNinePatch *np = static_cast<const Item::CommandNinePatch *>(c);
+
+				const Rect2 src_rect = np->source != Rect2() ? np->source : Rect2(Point2(), p_texture_size);
+				const Rect2 &dst_rect = np->rect;
+				const Color color = np->color * base_color;
+
+				const real_t dst_x[4] = { dst_rect.position.x, dst_rect.position.x + np->margin[SIDE_LEFT], dst_rect.position.x + dst_rect.size.x - np->margin[SIDE_RIGHT], dst_rect.position.x + dst_rect.size.x };
+				const real_t dst_y[4] = { dst_rect.position.y, dst_rect.position.y + np->margin[SIDE_TOP], dst_rect.position.y + dst_rect.size.y - np->margin[SIDE_BOTTOM], dst_rect.position.y + dst_rect.size.y };
+				const real_t uv_x[4] = { src_rect.position.x / p_texture_size.x, (src_rect.position.x + np->margin[SIDE_LEFT]) / p_texture_size.x, (src_rect.position.x + src_rect.size.x - np->margin[SIDE_RIGHT]) / p_texture_size.x, (src_rect.position.x + src_rect.size.x) / p_texture_size.x };
+				const real_t uv_y[4] = { src_rect.position.y / p_texture_size.y, (src_rect.position.y + np->margin[SIDE_TOP]) / p_texture_size.y, (src_rect.position.y + src_rect.size.y - np->margin[SIDE_BOTTOM]) / p_texture_size.y, (src_rect.position.y + src_rect.size.y) / p_texture_size.y };
+
+				for (int y = 0; y < 3; y++) {
+					for (int x = 0; x < 3; x++) {
+						if (x == 1 && y == 1 && !np->draw_center) {
+							continue;
+						}
+						if (dst_x[x + 1] <= dst_x[x] || dst_y[y + 1] <= dst_y[y]) {
+							continue; // Zero sized margin.
+						}
+
+						Vector2 points[4];
+						Vector2 uvs[4];
+						for (int i = 0; i < 4; i++) {
+							const int cx = x + int(corners[i].x);
+							const int cy = y + int(corners[i].y);
+							points[i] = Vector2(dst_x[cx], dst_y[cy]);
+							uvs[i] = Vector2(uv_x[cx], uv_y[cy]);
+						}
+
+						_add_quad(xform, points, uvs, color);
+					}
+				}
+			} break;
+			case Item::Command::TYPE_PRIMITIVE: {
+				const Item::CommandPrimitive *primitive = static_cast<const Item::CommandPrimitive *>(c);
+
+				for (uint32_t i = 0; i < 3; i++) {
+					_add_vertex(xform, primitive->points[i], primitive->uvs[i], primitive->colors[i] * base_color);
+				}
+				if (primitive->point_count == 4) {
+					static const uint32_t second_half[3] = { 0, 2, 3 };
+					for (uint32_t i = 0; i < 3; i++) {
+						const uint32_t j = second_half[i];
+						_add_vertex(xform, primitive->points[j], primitive->uvs[j], primitive->colors[j] * base_color);
+					}
+				}
+			} break;
+			case Item::Command::TYPE_TRANSFORM: {
+				const Item::CommandTransform *transform = static_cast<const Item::CommandTransform *>(c);
+				xform = p_transform * transform->xform;
+			} break;
+			default: {
+				break; // Rejected when checking the item.
+			}
+		}
+	}
+}
+
+void RendererCanvasBatcher::begin(TextureSizeFunc p_texture_size_func, void *p_userdata) {
+	batches.clear();
+	vertices.clear();
+	item_count = 0;
+
+	texture_size_func = p_texture_size_func;
+	texture_size_userdata = p_userdata;
+	last_size_valid = false;
+}
+
+void RendererCanvasBatcher::add_item(const Item *p_item, const Transform2D &p_transform, RS::CanvasItemTextureFilter p_filter, RS::CanvasItemTextureRepeat p_repeat, bool p_batchable) {
+	const uint32_t item_index = item_count++;
+
+	RS::CanvasItemTextureRepeat repeat = p_repeat;
+	RID texture;
+	bool draws = false;
+	bool needs_size = false;
+	Size2 texture_size(1, 1);
+
+	if (p_batchable) {
+		p_batchable = _get_item_texture(p_item, repeat, texture, draws, needs_size) && (!needs_size || _get_texture_size(texture, p_filter, repeat, texture_size));
+	}
+
+	if (!p_batchable) {
+		Batch batch;
+		batch.item_from = item_index;
+		batch.item_count = 1;
+		batch.clip_owner = p_item->final_clip_owner;
+		batches.push_back(batch);
+		return;
+	}
+
+	Batch *batch = batches.is_empty() ? nullptr : &batches[batches.size() - 1];
+	bool join = batch && batch->batched && batch->clip_owner == p_item->final_clip_owner;
+	if (join && draws && batch->vertex_count > 0) {
+		join = batch->texture == texture && batch->filter == p_filter && batch->repeat == repeat;
+	}
+
+	if (!join) {
+		Batch new_batch;
+		new_batch.item_from = item_index;
+		new_batch.clip_owner = p_item->final_clip_owner;
+		new_batch.vertex_from = vertices.size();
+		new_batch.batched = true;
+		batches.push_back(new_batch);
+		batch = &batches[batches.size() - 1];
+	}
+
+	batch->item_count++;
+
+	if (draws) {
+		if (batch->vertex_count == 0) {
+			batch->texture = texture;
+			batch->filter = p_filter;
+			batch->repeat = repeat;
+		}
+		_add_item_vertices(p_item, p_transform, texture_size);
+		batch->vertex_count = vertices.size() - batch->vertex_from;
+	}
+}
@@ -0,0 +1,95 @@
+/**************************************************************************/
+/*  renderer_canvas_batcher.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef RENDERER_CANVAS_BATCHER_H
+#define RENDERER_CANVAS_BATCHER_H
+
+#include "core/templates/local_vector.h"
+#include "servers/rendering/renderer_canvas_render.h"
+
+// Merges consecutive canvas items drawing only rects, stretched nine-patches and primitives
+// into CPU transformed triangle lists, so a run sharing texture, sampler and clip can be
+// drawn at once. Doesn't touch the GPU, uploading and drawing is left to the renderer.
+class RendererCanvasBatcher {
+public:
+	typedef RendererCanvasRender::Item Item;
+
+	struct Vertex {
+		float position[2];
+		float color[4];
+		float uv[2];
+	};
+
+	// A run of items in drawing order. Batched runs are drawn at once from their vertices,
+	// other runs hold a single item the renderer must draw on its own.
+	struct Batch {
+		uint32_t item_from = 0;
+		uint32_t item_count = 0;
+		const Item *clip_owner = nullptr;
+		RID texture;
+		RS::CanvasItemTextureFilter filter = RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT;
+		RS::CanvasItemTextureRepeat repeat = RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT;
+		uint32_t vertex_from = 0;
+		uint32_t vertex_count = 0;
+		bool batched = false;
+	};
+
+	// Returns the size in pixels of a canvas texture, needed to map regions and nine-patch margins.
+	typedef bool (*TextureSizeFunc)(void *p_userdata, RID p_texture, RS::CanvasItemTextureFilter p_filter, RS::CanvasItemTextureRepeat p_repeat, Size2 &r_size);
+
+private:
+	LocalVector<Batch> batches;
+	LocalVector<Vertex> vertices;
+	uint32_t item_count = 0;
+
+	TextureSizeFunc texture_size_func = nullptr;
+	void *texture_size_userdata = nullptr;
+
+	RID last_size_texture;
+	Size2 last_size;
+	bool last_size_valid = false;
+
+	bool _get_texture_size(RID p_texture, RS::CanvasItemTextureFilter p_filter, RS::CanvasItemTextureRepeat p_repeat, Size2 &r_size);
+	bool _get_item_texture(const Item *p_item, RS::CanvasItemTextureRepeat &r_repeat, RID &r_texture, bool &r_draws, bool &r_needs_size) const;
+
+	_FORCE_INLINE_ void _add_vertex(const Transform2D &p_xform, const Vector2 &p_position, const Vector2 &p_uv, const Color &p_color);
+	void _add_quad(const Transform2D &p_xform, const Vector2 *p_points, const Vector2 *p_uvs, const Color &p_color);
+	void _add_item_vertices(const Item *p_item, const Transform2D &p_transform, const Size2 &p_texture_size);
+
+public:
+	void begin(TextureSizeFunc p_texture_size_func, void *p_userdata);
+	// Items must be added in drawing order. When p_batchable is false the item always gets its own run.
+	void add_item(const Item *p_item, const Transform2D &p_transform, RS::CanvasItemTextureFilter p_filter, RS::CanvasItemTextureRepeat p_repeat, bool p_batchable);
+
+	const LocalVector<Batch> &get_batches() const { return batches; }
+	const LocalVector<Vertex> &get_vertices() const { return vertices; }
+};
+
+#endif // RENDERER_CANVAS_BATCHER_H
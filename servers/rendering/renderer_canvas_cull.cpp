@@ -223,6 +223,48 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 	}
 }
 
+void RendererCanvasCull::_update_subtree_rect(Item *p_item) {
+	if (!p_item->subtree_rect_dirty) {
+		return;
+	}
+
+	// Viewports, back buffer copies and canvas groups are handled even when offscreen,
+	// and items with a skeleton or updated when visible get a new rect every frame.
+	bool unbounded = p_item->vp_render || p_item->copy_back_buffer || p_item->canvas_group || p_item->update_when_visible || p_item->skeleton.is_valid();
+	bool has_rect = false;
+	Rect2 rect;
+
+	if (p_item->commands != nullptr || p_item->visibility_notifier) {
+		rect = p_item->get_rect();
+		if (p_item->visibility_notifier && p_item->visibility_notifier->area.size != Vector2()) {
+			rect = rect.merge(p_item->visibility_notifier->area);
+		}
+		has_rect = true;
+	}
+
+	// Hidden children are included too, so showing them doesn't need to invalidate anything.
+	int child_item_count = p_item->child_items.size();
+	Item **child_items = p_item->child_items.ptrw();
+	for (int i = 0; i < child_item_count; i++) {
+		Item *child = child_items[i];
+		_update_subtree_rect(child);
+		unbounded = unbounded || child->subtree_unbounded;
+		if (!child->subtree_has_rect) {
+			continue;
+		}
+
+		// Grown by a unit to account for transforms snapped to pixels.
+		Rect2 child_rect = child->xform.xform(child->subtree_rect).grow(1.0);
+		rect = has_rect ? rect.merge(child_rect) : child_rect;
+		has_rect = true;
+	}
+
+	p_item->subtree_rect = rect;
+	p_item->subtree_has_rect = has_rect;
+	p_item->subtree_unbounded = unbounded;
+	p_item->subtree_rect_dirty = false;
+}
+
 void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_canvas_clip, Item *p_material_owner, bool allow_y_sort, uint32_t canvas_cull_mask) {
 	Item *ci = p_canvas_item;
 
@@ -234,6 +276,25 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 		return;
 	}
 
+	Transform2D xform = ci->xform;
+	if (snapping_2d_transforms_to_pixel) {
+		xform.columns[2] = xform.columns[2].floor();
+	}
+	xform = p_transform * xform;
+
+	_update_subtree_rect(ci);
+	if (!ci->subtree_unbounded) {
+		if (!ci->subtree_has_rect) {
+			return; // Nothing to draw in the whole subtree.
+		}
+
+		Rect2 global_subtree_rect = xform.xform(ci->subtree_rect);
+		global_subtree_rect.position += p_clip_rect.position;
+		if (!p_clip_rect.intersects(global_subtree_rect, true)) {
+			return; // Fully offscreen.
+		}
+	}
+
 	if (ci->children_order_dirty) {
 		ci->child_items.sort_custom<ItemIndexSort>();
 		ci->children_order_dirty = false;
@@ -247,12 +308,6 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 		}
 	}
 
-	Transform2D xform = ci->xform;
-	if (snapping_2d_transforms_to_pixel) {
-		xform.columns[2] = xform.columns[2].floor();
-	}
-	xform = p_transform * xform;
-
 	Rect2 global_rect = xform.xform(rect);
 	global_rect.position += p_clip_rect.position;
 
@@ -461,6 +516,7 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 		} else if (canvas_item_owner.owns(canvas_item->parent)) {
 			Item *item_owner = canvas_item_owner.get_or_null(canvas_item->parent);
 			item_owner->child_items.erase(canvas_item);
+			item_owner->mark_subtree_rect_dirty();
 
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -468,6 +524,7 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 		}
 
 		canvas_item->parent = RID();
+		canvas_item->bounds_parent = nullptr;
 	}
 
 	if (p_parent.is_valid()) {
@@ -481,6 +538,8 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 			Item *item_owner = canvas_item_owner.get_or_null(p_parent);
 			item_owner->child_items.push_back(canvas_item);
 			item_owner->children_order_dirty = true;
+			item_owner->mark_subtree_rect_dirty();
+			canvas_item->bounds_parent = item_owner;
 
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -515,6 +574,10 @@ void RendererCanvasCull::canvas_item_set_transform(RID p_item, const Transform2D
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->xform = p_transform;
+
+	if (canvas_item->bounds_parent) {
+		canvas_item->bounds_parent->mark_subtree_rect_dirty();
+	}
 }
 
 void RendererCanvasCull::canvas_item_set_visibility_layer(RID p_item, uint32_t p_visibility_layer) {
@@ -551,6 +614,7 @@ void RendererCanvasCull::canvas_item_set_custom_rect(RID p_item, bool p_custom_r
 
 	canvas_item->custom_rect = p_custom_rect;
 	canvas_item->rect = p_rect;
+	canvas_item->mark_subtree_rect_dirty();
 }
 
 void RendererCanvasCull::canvas_item_set_modulate(RID p_item, const Color &p_color) {
@@ -579,6 +643,7 @@ void RendererCanvasCull::canvas_item_set_update_when_visible(RID p_item, bool p_
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->update_when_visible = p_update;
+	canvas_item->mark_subtree_rect_dirty();
 }
 
 void RendererCanvasCull::canvas_item_add_line(RID p_item, const Point2 &p_from, const Point2 &p_to, const Color &p_color, float p_width, bool p_antialiased) {
@@ -1598,6 +1663,7 @@ void RendererCanvasCull::canvas_item_attach_skeleton(RID p_item, RID p_skeleton)
 		return;
 	}
 	canvas_item->skeleton = p_skeleton;
+	canvas_item->mark_subtree_rect_dirty();
 
 	Item::Command *c = canvas_item->commands;
 
@@ -1635,6 +1701,8 @@ void RendererCanvasCull::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_e
 		canvas_item->copy_back_buffer->rect = p_rect;
 		canvas_item->copy_back_buffer->full = p_rect == Rect2();
 	}
+
+	canvas_item->mark_subtree_rect_dirty();
 }
 
 void RendererCanvasCull::canvas_item_clear(RID p_item) {
@@ -1695,6 +1763,8 @@ void RendererCanvasCull::canvas_item_set_visibility_notifier(RID p_item, bool p_
 			canvas_item->visibility_notifier = nullptr;
 		}
 	}
+
+	canvas_item->mark_subtree_rect_dirty();
 }
 
 void RendererCanvasCull::canvas_item_set_canvas_group_mode(RID p_item, RS::CanvasGroupMode p_mode, float p_clear_margin, bool p_fit_empty, float p_fit_margin, bool p_blur_mipmaps) {
@@ -1716,6 +1786,8 @@ void RendererCanvasCull::canvas_item_set_canvas_group_mode(RID p_item, RS::Canva
 		canvas_item->canvas_group->blur_mipmaps = p_blur_mipmaps;
 		canvas_item->canvas_group->clear_margin = p_clear_margin;
 	}
+
+	canvas_item->mark_subtree_rect_dirty();
 }
 
 RID RendererCanvasCull::canvas_light_allocate() {
@@ -2156,6 +2228,7 @@ bool RendererCanvasCull::free(RID p_rid) {
 			} else if (canvas_item_owner.owns(canvas_item->parent)) {
 				Item *item_owner = canvas_item_owner.get_or_null(canvas_item->parent);
 				item_owner->child_items.erase(canvas_item);
+				item_owner->mark_subtree_rect_dirty();
 
 				if (item_owner->sort_y) {
 					_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -2165,6 +2238,7 @@ bool RendererCanvasCull::free(RID p_rid) {
 
 		for (int i = 0; i < canvas_item->child_items.size(); i++) {
 			canvas_item->child_items[i]->parent = RID();
+			canvas_item->child_items[i]->bounds_parent = nullptr;
 		}
 
 		if (canvas_item->visibility_notifier != nullptr) {
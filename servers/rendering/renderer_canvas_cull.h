@@ -72,6 +72,34 @@ public:
 
 		VisibilityNotifierData *visibility_notifier = nullptr;
 
+		// Bounds of the item and all its children in local space, so culling can skip subtrees that are fully offscreen.
+		// They are only recomputed when something below the item changed.
+		Item *bounds_parent = nullptr;
+		Rect2 subtree_rect;
+		bool subtree_rect_dirty = true;
+		bool subtree_has_rect = false;
+		bool subtree_unbounded = false; // Something in the subtree must be processed even when offscreen.
+
+		void mark_subtree_rect_dirty() {
+			// Ancestors of a dirty item are always dirty, so propagation can stop at the first one.
+			Item *item = this;
+			while (item && !item->subtree_rect_dirty) {
+				item->subtree_rect_dirty = true;
+				item = item->bounds_parent;
+			}
+		}
+
+		template <class T>
+		T *alloc_command() {
+			mark_subtree_rect_dirty();
+			return RendererCanvasRender::Item::alloc_command<T>();
+		}
+
+		void clear() {
+			mark_subtree_rect_dirty();
+			RendererCanvasRender::Item::clear();
+		}
+
 		Item() {
 			children_order_dirty = true;
 			E = nullptr;
@@ -181,6 +209,7 @@ public:
 
 private:
 	void _render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, uint32_t canvas_cull_mask);
+	void _update_subtree_rect(Item *p_item);
 	void _cull_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_canvas_clip, Item *p_material_owner, bool allow_y_sort, uint32_t canvas_cull_mask);
 
 	RendererCanvasRender::Item **z_list;
@@ -1050,6 +1050,131 @@ RID RendererCanvasRenderRD::_create_base_uniform_set(RID p_to_render_target, boo
 	return uniform_set;
 }
 
+RID RendererCanvasRenderRD::_get_item_material(const Item *p_item) const {
+	RID material = p_item->material_owner == nullptr ? p_item->material : p_item->material_owner->material;
+
+	if (p_item->use_canvas_group) {
+		if (p_item->canvas_group->mode == RS::CANVAS_GROUP_MODE_CLIP_AND_DRAW) {
+			material = default_clip_children_material;
+		} else {
+			if (material.is_null()) {
+				if (p_item->canvas_group->mode == RS::CANVAS_GROUP_MODE_CLIP_ONLY) {
+					material = default_clip_children_material;
+				} else {
+					material = default_canvas_group_material;
+				}
+			}
+		}
+	}
+
+	return material;
+}
+
+bool RendererCanvasRenderRD::_batch_texture_size_func(void *p_userdata, RID p_texture, RS::CanvasItemTextureFilter p_filter, RS::CanvasItemTextureRepeat p_repeat, Size2 &r_size) {
+	RendererCanvasRenderRD *canvas_render = static_cast<RendererCanvasRenderRD *>(p_userdata);
+
+	RID uniform_set;
+	Color specular_shininess;
+	Size2i size;
+	bool use_normal;
+	bool use_specular;
+
+	// Same lookup used when binding the texture, so the uniform set is reused by the draw.
+	if (!RendererRD::TextureStorage::get_singleton()->canvas_texture_get_uniform_set(p_texture, p_filter, p_repeat, canvas_render->shader.default_version_rd_shader, CANVAS_TEXTURE_UNIFORM_SET, uniform_set, size, specular_shininess, use_normal, use_specular)) {
+		return false;
+	}
+
+	r_size = size;
+	return true;
+}
+
+bool RendererCanvasRenderRD::_is_item_batchable(const Item *p_item, RID p_material, Light *p_lights) const {
+	// Custom shaders may depend on the per command vertex data or model matrix, and lit items need per item light lists.
+	if (p_material.is_valid() || using_directional_lights) {
+		return false;
+	}
+
+	for (Light *light = p_lights; light; light = light->next_ptr) {
+		if (light->render_index_cache >= 0 && p_item->light_mask & light->item_mask && p_item->z_final >= light->z_min && p_item->z_final <= light->z_max && p_item->global_rect_cache.intersects_transformed(light->xform_cache, light->rect_cache)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void RendererCanvasRenderRD::_batch_items(int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights) {
+	RendererCanvasBatcher &batcher = batching.batcher;
+	batcher.begin(_batch_texture_size_func, this);
+
+	for (int i = 0; i < p_item_count; i++) {
+		const Item *ci = items[i];
+
+		RS::CanvasItemTextureFilter filter = ci->texture_filter != RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT ? ci->texture_filter : default_filter;
+		RS::CanvasItemTextureRepeat repeat = ci->texture_repeat != RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT ? ci->texture_repeat : default_repeat;
+		bool batchable = batching.enabled && _is_item_batchable(ci, _get_item_material(ci), p_lights);
+
+		batcher.add_item(ci, p_canvas_transform_inverse * ci->final_transform, filter, repeat, batchable);
+	}
+
+	const LocalVector<RendererCanvasBatcher::Vertex> &vertices = batcher.get_vertices();
+	if (vertices.is_empty()) {
+		return;
+	}
+
+	if (vertices.size() > batching.vertex_buffer_size) {
+		if (batching.vertex_buffer.is_valid()) {
+			RD::get_singleton()->free(batching.vertex_buffer);
+		}
+		batching.vertex_buffer_size = next_power_of_2(vertices.size());
+		batching.vertex_buffer = RD::get_singleton()->vertex_buffer_create(batching.vertex_buffer_size * sizeof(RendererCanvasBatcher::Vertex));
+	}
+
+	RD::get_singleton()->buffer_update(batching.vertex_buffer, 0, vertices.size() * sizeof(RendererCanvasBatcher::Vertex), vertices.ptr());
+}
+
+void RendererCanvasRenderRD::_render_batch(RD::DrawListID p_draw_list, const RendererCanvasBatcher::Batch &p_batch, RD::FramebufferFormatID p_framebuffer_format) {
+	RendererRD::MeshStorage *mesh_storage = RendererRD::MeshStorage::get_singleton();
+
+	RID pipeline = shader.pipeline_variants.variants[PIPELINE_LIGHT_MODE_DISABLED][PIPELINE_VARIANT_ATTRIBUTE_TRIANGLES].get_render_pipeline(batching.vertex_format, p_framebuffer_format);
+	RD::get_singleton()->draw_list_bind_render_pipeline(p_draw_list, pipeline);
+
+	// Vertices are already in canvas space and modulated.
+	PushConstant push_constant;
+	memset(&push_constant, 0, sizeof(PushConstant));
+	_update_transform_2d_to_mat2x3(Transform2D(), push_constant.world);
+	for (int i = 0; i < 4; i++) {
+		push_constant.modulation[i] = 1.0;
+	}
+
+	RID last_texture;
+	Size2 texpixel_size;
+	_bind_canvas_texture(p_draw_list, p_batch.texture, p_batch.filter, p_batch.repeat, last_texture, push_constant, texpixel_size);
+
+	RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
+
+	const uint64_t offset = uint64_t(p_batch.vertex_from) * sizeof(RendererCanvasBatcher::Vertex);
+	Vector<RID> buffers;
+	buffers.push_back(batching.vertex_buffer);
+	buffers.push_back(batching.vertex_buffer);
+	buffers.push_back(batching.vertex_buffer);
+	buffers.push_back(mesh_storage->mesh_get_default_rd_buffer(RendererRD::MeshStorage::DEFAULT_RD_BUFFER_BONES));
+	buffers.push_back(mesh_storage->mesh_get_default_rd_buffer(RendererRD::MeshStorage::DEFAULT_RD_BUFFER_WEIGHTS));
+	Vector<uint64_t> offsets;
+	offsets.push_back(offset);
+	offsets.push_back(offset);
+	offsets.push_back(offset);
+	offsets.push_back(0);
+	offsets.push_back(0);
+
+	RID vertex_array = RD::get_singleton()->vertex_array_create(p_batch.vertex_count, batching.vertex_format, buffers, offsets);
+	ERR_FAIL_COND(vertex_array.is_null());
+	batching.vertex_arrays.push_back(vertex_array);
+
+	RD::get_singleton()->draw_list_bind_vertex_array(p_draw_list, vertex_array);
+	RD::get_singleton()->draw_list_draw(p_draw_list, false);
+}
+
 void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights, bool &r_sdf_used, bool p_to_backbuffer) {
 	RendererRD::MaterialStorage *material_storage = RendererRD::MaterialStorage::get_singleton();
 	RendererRD::TextureStorage *texture_storage = RendererRD::TextureStorage::get_singleton();
@@ -1084,6 +1209,9 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 
 	RD::FramebufferFormatID fb_format = RD::get_singleton()->framebuffer_get_format(framebuffer);
 
+	// Needs to happen before the draw list begins, as it uploads the batched vertices.
+	_batch_items(p_item_count, canvas_transform_inverse, p_lights);
+
 	RD::DrawListID draw_list = RD::get_singleton()->draw_list_begin(framebuffer, clear ? RD::INITIAL_ACTION_CLEAR : RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_READ, RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_DISCARD, clear_colors);
 
 	RD::get_singleton()->draw_list_bind_uniform_set(draw_list, fb_uniform_set, BASE_UNIFORM_SET);
@@ -1093,8 +1221,9 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 
 	PipelineVariants *pipeline_variants = &shader.pipeline_variants;
 
-	for (int i = 0; i < p_item_count; i++) {
-		Item *ci = items[i];
+	for (const RendererCanvasBatcher::Batch &batch : batching.batcher.get_batches()) {
+		// All items in a batch share the clip.
+		Item *ci = items[batch.item_from];
 
 		if (current_clip != ci->final_clip_owner) {
 			current_clip = ci->final_clip_owner;
@@ -1108,22 +1237,18 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 			}
 		}
 
-		RID material = ci->material_owner == nullptr ? ci->material : ci->material_owner->material;
-
-		if (ci->use_canvas_group) {
-			if (ci->canvas_group->mode == RS::CANVAS_GROUP_MODE_CLIP_AND_DRAW) {
-				material = default_clip_children_material;
-			} else {
-				if (material.is_null()) {
-					if (ci->canvas_group->mode == RS::CANVAS_GROUP_MODE_CLIP_ONLY) {
-						material = default_clip_children_material;
-					} else {
-						material = default_canvas_group_material;
-					}
-				}
+		if (batch.batched) {
+			if (batch.vertex_count > 0) {
+				_render_batch(draw_list, batch, fb_format);
+				// Batches are drawn with the default shader.
+				pipeline_variants = &shader.pipeline_variants;
+				prev_material = RID();
 			}
+			continue;
 		}
 
+		RID material = _get_item_material(ci);
+
 		if (material != prev_material) {
 			CanvasMaterialData *material_data = nullptr;
 			if (material.is_valid()) {
@@ -1152,6 +1277,11 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 	}
 
 	RD::get_singleton()->draw_list_end();
+
+	for (const RID &vertex_array : batching.vertex_arrays) {
+		RD::get_singleton()->free(vertex_array);
+	}
+	batching.vertex_arrays.clear();
 }
 
 void RendererCanvasRenderRD::canvas_render_items(RID p_to_render_target, Item *p_item_list, const Color &p_modulate, Light *p_light_list, Light *p_directional_light_list, const Transform2D &p_canvas_transform, RenderingServer::CanvasItemTextureFilter p_default_filter, RenderingServer::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, bool &r_sdf_used) {
@@ -2627,6 +2757,37 @@ RendererCanvasRenderRD::RendererCanvasRenderRD() {
 
 	state.shadow_texture_size = GLOBAL_GET("rendering/2d/shadow_atlas/size");
 
+	{ //batching
+		batching.enabled = GLOBAL_GET("rendering/2d/batching/enabled");
+
+		// Interleaved in a single buffer, bones and weights come from the default buffers like for polygons without them.
+		Vector<RD::VertexAttribute> attributes;
+		RD::VertexAttribute va;
+		va.format = RD::DATA_FORMAT_R32G32_SFLOAT;
+		va.location = RS::ARRAY_VERTEX;
+		va.offset = offsetof(RendererCanvasBatcher::Vertex, position);
+		va.stride = sizeof(RendererCanvasBatcher::Vertex);
+		attributes.push_back(va);
+		va.format = RD::DATA_FORMAT_R32G32B32A32_SFLOAT;
+		va.location = RS::ARRAY_COLOR;
+		va.offset = offsetof(RendererCanvasBatcher::Vertex, color);
+		attributes.push_back(va);
+		va.format = RD::DATA_FORMAT_R32G32_SFLOAT;
+		va.location = RS::ARRAY_TEX_UV;
+		va.offset = offsetof(RendererCanvasBatcher::Vertex, uv);
+		attributes.push_back(va);
+		va.format = RD::DATA_FORMAT_R32G32B32A32_UINT;
+		va.location = RS::ARRAY_BONES;
+		va.offset = 0;
+		va.stride = 0;
+		attributes.push_back(va);
+		va.format = RD::DATA_FORMAT_R32G32B32A32_SFLOAT;
+		va.location = RS::ARRAY_WEIGHTS;
+		attributes.push_back(va);
+
+		batching.vertex_format = RD::get_singleton()->vertex_format_create(attributes);
+	}
+
 	//create functions for shader and material
 	material_storage->shader_set_data_request_function(RendererRD::MaterialStorage::SHADER_TYPE_2D, _create_shader_funcs);
 	material_storage->material_set_data_request_function(RendererRD::MaterialStorage::SHADER_TYPE_2D, _create_material_funcs);
@@ -2747,6 +2908,10 @@ RendererCanvasRenderRD::~RendererCanvasRenderRD() {
 		RD::get_singleton()->free(state.lights_uniform_buffer);
 	}
 
+	if (batching.vertex_buffer.is_valid()) {
+		RD::get_singleton()->free(batching.vertex_buffer);
+	}
+
 	//shadow rendering
 	{
 		shadow_render.shader.version_free(shadow_render.shader_version);
@@ -31,6 +31,7 @@
 #ifndef RENDERER_CANVAS_RENDER_RD_H
 #define RENDERER_CANVAS_RENDER_RD_H
 
+#include "servers/rendering/renderer_canvas_batcher.h"
 #include "servers/rendering/renderer_canvas_render.h"
 #include "servers/rendering/renderer_compositor.h"
 #include "servers/rendering/renderer_rd/pipeline_cache_rd.h"
@@ -400,6 +401,15 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 
 	Item *items[MAX_RENDER_ITEMS];
 
+	struct Batching {
+		bool enabled = true;
+		RendererCanvasBatcher batcher;
+		RID vertex_buffer;
+		uint32_t vertex_buffer_size = 0; // In vertices.
+		RD::VertexFormatID vertex_format = RD::INVALID_ID;
+		LocalVector<RID> vertex_arrays; // Freed once the draw list ends.
+	} batching;
+
 	bool using_directional_lights = false;
 	RID default_canvas_texture;
 
@@ -415,6 +425,11 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 
 	inline void _bind_canvas_texture(RD::DrawListID p_draw_list, RID p_texture, RS::CanvasItemTextureFilter p_base_filter, RS::CanvasItemTextureRepeat p_base_repeat, RID &r_last_texture, PushConstant &push_constant, Size2 &r_texpixel_size); //recursive, so regular inline used instead.
 	void _render_item(RenderingDevice::DrawListID p_draw_list, RID p_render_target, const Item *p_item, RenderingDevice::FramebufferFormatID p_framebuffer_format, const Transform2D &p_canvas_transform_inverse, Item *&current_clip, Light *p_lights, PipelineVariants *p_pipeline_variants, bool &r_sdf_used);
+	RID _get_item_material(const Item *p_item) const;
+	static bool _batch_texture_size_func(void *p_userdata, RID p_texture, RS::CanvasItemTextureFilter p_filter, RS::CanvasItemTextureRepeat p_repeat, Size2 &r_size);
+	bool _is_item_batchable(const Item *p_item, RID p_material, Light *p_lights) const;
+	void _batch_items(int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights);
+	void _render_batch(RD::DrawListID p_draw_list, const RendererCanvasBatcher::Batch &p_batch, RD::FramebufferFormatID p_framebuffer_format);
 	void _render_items(RID p_to_render_target, int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights, bool &r_sdf_used, bool p_to_backbuffer = false);
 
 	_FORCE_INLINE_ void _update_transform_2d_to_mat2x4(const Transform2D &p_transform, float *p_mat2x4);
@@ -31,6 +31,7 @@
 #include "renderer_scene_cull.h"
 
 #include "core/config/project_settings.h"
+#include "core/debugger/engine_trace.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "rendering_server_default.h"
@@ -1543,6 +1544,96 @@ void RendererSceneCull::instance_geometry_get_shader_parameter_list(RID p_instan
 	}
 }
 
+RendererSceneCull::Scenario::Indexer &RendererSceneCull::_get_instance_indexer(Instance *p_instance) {
+	if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
+		return p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY];
+	} else {
+		return p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES];
+	}
+}
+
+void RendererSceneCull::_indexer_insert(Instance *p_instance, const AABB &p_aabb) {
+	Scenario::Indexer &indexer = _get_instance_indexer(p_instance);
+
+	if (indexer_static_frames > 0) {
+		// Most instances never move, the ones that do are taken out of the static tree on their first move.
+		p_instance->indexer_id = indexer.static_bvh.insert(p_aabb, p_instance);
+		p_instance->indexer_static = true;
+		indexer.static_changes++;
+	} else {
+		p_instance->indexer_id = indexer.dynamic_bvh.insert(p_aabb, p_instance);
+		p_instance->indexer_static = false;
+	}
+}
+
+void RendererSceneCull::_indexer_update(Instance *p_instance, const AABB &p_aabb) {
+	Scenario::Indexer &indexer = _get_instance_indexer(p_instance);
+
+	if (p_instance->transformed_aabb == p_instance->prev_transformed_aabb) {
+		// Not a move, keep it where it is.
+		if (p_instance->indexer_static) {
+			indexer.static_bvh.update(p_instance->indexer_id, p_aabb);
+		} else {
+			indexer.dynamic_bvh.update(p_instance->indexer_id, p_aabb);
+		}
+		return;
+	}
+
+	if (p_instance->indexer_static) {
+		indexer.static_bvh.remove(p_instance->indexer_id);
+		indexer.static_changes++;
+		p_instance->indexer_id = indexer.dynamic_bvh.insert(p_aabb, p_instance);
+		p_instance->indexer_static = false;
+	} else {
+		indexer.dynamic_bvh.update(p_instance->indexer_id, p_aabb);
+	}
+
+	if (indexer_static_frames > 0) {
+		// Keep the list ordered by the frame each instance last moved.
+		if (p_instance->indexer_dynamic_item.in_list()) {
+			p_instance->scenario->dynamic_instances.remove(&p_instance->indexer_dynamic_item);
+		}
+		p_instance->indexer_moved_frame = indexer_frame;
+		p_instance->scenario->dynamic_instances.add_last(&p_instance->indexer_dynamic_item);
+	}
+}
+
+void RendererSceneCull::_indexer_remove(Instance *p_instance) {
+	Scenario::Indexer &indexer = _get_instance_indexer(p_instance);
+
+	if (p_instance->indexer_static) {
+		indexer.static_bvh.remove(p_instance->indexer_id);
+		indexer.static_changes++;
+	} else {
+		indexer.dynamic_bvh.remove(p_instance->indexer_id);
+	}
+
+	if (p_instance->indexer_dynamic_item.in_list()) {
+		p_instance->scenario->dynamic_instances.remove(&p_instance->indexer_dynamic_item);
+	}
+
+	p_instance->indexer_id = DynamicBVH::ID();
+	p_instance->indexer_static = false;
+}
+
+void RendererSceneCull::_update_static_indexers(Scenario *p_scenario) {
+	while (p_scenario->dynamic_instances.first()) {
+		Instance *instance = p_scenario->dynamic_instances.first()->self();
+		if (instance->indexer_moved_frame + indexer_static_frames > indexer_frame) {
+			break; // The rest moved more recently.
+		}
+
+		p_scenario->dynamic_instances.remove(&instance->indexer_dynamic_item);
+
+		// Static instances don't need the motion quantized bounds.
+		Scenario::Indexer &indexer = _get_instance_indexer(instance);
+		indexer.dynamic_bvh.remove(instance->indexer_id);
+		instance->indexer_id = indexer.static_bvh.insert(instance->transformed_aabb, instance);
+		instance->indexer_static = true;
+		indexer.static_changes++;
+	}
+}
+
 void RendererSceneCull::_update_instance(Instance *p_instance) {
 	p_instance->version++;
 
@@ -1679,11 +1770,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 	}
 
 	if (!p_instance->indexer_id.is_valid()) {
-		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
-			p_instance->indexer_id = p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].insert(bvh_aabb, p_instance);
-		} else {
-			p_instance->indexer_id = p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].insert(bvh_aabb, p_instance);
-		}
+		_indexer_insert(p_instance, bvh_aabb);
 
 		p_instance->array_index = p_instance->scenario->instance_data.size();
 		InstanceData idata;
@@ -1768,11 +1855,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		p_instance->scenario->instance_aabbs.push_back(InstanceBounds(p_instance->transformed_aabb));
 		_update_instance_visibility_dependencies(p_instance);
 	} else {
-		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
-			p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].update(p_instance->indexer_id, bvh_aabb);
-		} else {
-			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, bvh_aabb);
-		}
+		_indexer_update(p_instance, bvh_aabb);
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = InstanceBounds(p_instance->transformed_aabb);
 	}
 
@@ -1845,13 +1928,7 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 		pair_allocator.free(pair);
 	}
 
-	if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
-		p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].remove(p_instance->indexer_id);
-	} else {
-		p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].remove(p_instance->indexer_id);
-	}
-
-	p_instance->indexer_id = DynamicBVH::ID();
+	_indexer_remove(p_instance);
 
 	//replace this by last
 	int32_t swap_with_index = p_instance->scenario->instance_data.size() - 1;
@@ -2277,14 +2354,12 @@ void RendererSceneCull::_light_instance_setup_directional_shadow(int p_shadow_in
 	}
 }
 
-bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_screen_mesh_lod_threshold, uint32_t p_visible_layers) {
+bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, Scenario *p_scenario, uint32_t p_visible_layers) {
 	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
 	Transform3D light_transform = p_instance->transform;
 	light_transform.orthonormalize(); //scale does not count on lights
 
-	bool animated_material_found = false;
-
 	switch (RSG::light_storage->light_get_type(p_instance->base)) {
 		case RS::LIGHT_DIRECTIONAL: {
 		} break;
@@ -2296,63 +2371,21 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 					return true;
 				}
 				for (int i = 0; i < 2; i++) {
-					//using this one ensures that raster deferred will have it
-					RENDER_TIMESTAMP("Cull OmniLight3D Shadow Paraboloid, Half " + itos(i));
-
 					real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
 
 					real_t z = i == 0 ? -1 : 1;
-					Vector<Plane> planes;
-					planes.resize(6);
-					planes.write[0] = light_transform.xform(Plane(Vector3(0, 0, z), radius));
-					planes.write[1] = light_transform.xform(Plane(Vector3(1, 0, z).normalized(), radius));
-					planes.write[2] = light_transform.xform(Plane(Vector3(-1, 0, z).normalized(), radius));
-					planes.write[3] = light_transform.xform(Plane(Vector3(0, 1, z).normalized(), radius));
-					planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
-					planes.write[5] = light_transform.xform(Plane(Vector3(0, 0, -z), 0));
-
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
-
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
-
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
-					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
-
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask)) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-
-							if (instance->mesh_instance.is_valid()) {
-								RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
-
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-					}
-
-					RSG::mesh_storage->update_mesh_instances();
+					ShadowCullJob &job = _light_shadow_cull_job_push(light, p_scenario, p_visible_layers);
+					job.planes[0] = light_transform.xform(Plane(Vector3(0, 0, z), radius));
+					job.planes[1] = light_transform.xform(Plane(Vector3(1, 0, z).normalized(), radius));
+					job.planes[2] = light_transform.xform(Plane(Vector3(-1, 0, z).normalized(), radius));
+					job.planes[3] = light_transform.xform(Plane(Vector3(0, 1, z).normalized(), radius));
+					job.planes[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
+					job.planes[5] = light_transform.xform(Plane(Vector3(0, 0, -z), 0));
+					job.points = Geometry3D::compute_convex_mesh_points(job.planes, 6);
 
 					RSG::light_storage->light_instance_set_shadow_transform(light->instance, Projection(), light_transform, radius, 0, i, 0);
-					shadow_data.light = light->instance;
-					shadow_data.pass = i;
+					job.shadow_data->light = light->instance;
+					job.shadow_data->pass = i;
 				}
 			} else { //shadow cube
 
@@ -2365,9 +2398,6 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 				cm.set_perspective(90, 1, radius * 0.005f, radius);
 
 				for (int i = 0; i < 6; i++) {
-					RENDER_TIMESTAMP("Cull OmniLight3D Shadow Cube, Side " + itos(i));
-					//using this one ensures that raster deferred will have it
-
 					static const Vector3 view_normals[6] = {
 						Vector3(+1, 0, 0),
 						Vector3(-1, 0, 0),
@@ -2387,49 +2417,16 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 					Transform3D xform = light_transform * Transform3D().looking_at(view_normals[i], view_up[i]);
 
+					ShadowCullJob &job = _light_shadow_cull_job_push(light, p_scenario, p_visible_layers);
 					Vector<Plane> planes = cm.get_projection_planes(xform);
-
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
-
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
-
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
-					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
-
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask)) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-							if (instance->mesh_instance.is_valid()) {
-								RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
-
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
+					for (int j = 0; j < 6; j++) {
+						job.planes[j] = planes[j];
 					}
+					job.points = Geometry3D::compute_convex_mesh_points(job.planes, 6);
 
-					RSG::mesh_storage->update_mesh_instances();
 					RSG::light_storage->light_instance_set_shadow_transform(light->instance, cm, xform, radius, 0, i, 0);
-
-					shadow_data.light = light->instance;
-					shadow_data.pass = i;
+					job.shadow_data->light = light->instance;
+					job.shadow_data->pass = i;
 				}
 
 				//restore the regular DP matrix
@@ -2438,8 +2435,6 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 		} break;
 		case RS::LIGHT_SPOT: {
-			RENDER_TIMESTAMP("Cull SpotLight3D Shadow");
-
 			if (max_shadows_used + 1 > MAX_UPDATE_SHADOWS) {
 				return true;
 			}
@@ -2450,54 +2445,100 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 			Projection cm;
 			cm.set_perspective(angle * 2.0, 1.0, 0.005f * radius, radius);
 
+			ShadowCullJob &job = _light_shadow_cull_job_push(light, p_scenario, p_visible_layers);
 			Vector<Plane> planes = cm.get_projection_planes(light_transform);
+			for (int j = 0; j < 6; j++) {
+				job.planes[j] = planes[j];
+			}
+			job.points = Geometry3D::compute_convex_mesh_points(job.planes, 6);
 
-			instance_shadow_cull_result.clear();
+			RSG::light_storage->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0, 0);
+			job.shadow_data->light = light->instance;
+			job.shadow_data->pass = 0;
 
-			Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
+		} break;
+	}
 
-			struct CullConvex {
-				PagedArray<Instance *> *result;
-				_FORCE_INLINE_ bool operator()(void *p_data) {
-					Instance *p_instance = (Instance *)p_data;
-					result->push_back(p_instance);
-					return false;
-				}
-			};
+	return false;
+}
 
-			CullConvex cull_convex;
-			cull_convex.result = &instance_shadow_cull_result;
+RendererSceneCull::ShadowCullJob &RendererSceneCull::_light_shadow_cull_job_push(InstanceLightData *p_light, Scenario *p_scenario, uint32_t p_visible_layers) {
+	if (shadow_cull_jobs_used == shadow_cull_jobs.size()) {
+		shadow_cull_jobs.push_back(ShadowCullJob());
+	}
 
-			p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
+	ShadowCullJob &job = shadow_cull_jobs[shadow_cull_jobs_used++];
+	job.light = p_light;
+	job.scenario = p_scenario;
+	job.visible_layers = p_visible_layers;
+	job.shadow_data = &render_shadow_data[max_shadows_used++];
+	job.animated_material_found = false;
+	job.mesh_instances.clear();
+	return job;
+}
 
-			RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
+void RendererSceneCull::_light_shadow_cull_threaded(uint32_t p_job, ShadowCullJob *p_jobs) {
+	ShadowCullJob &job = p_jobs[p_job];
 
-			for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-				Instance *instance = instance_shadow_cull_result[j];
-				if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !(p_visible_layers & instance->layer_mask)) {
-					continue;
-				} else {
-					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-						animated_material_found = true;
-					}
+	struct CullConvex {
+		ShadowCullJob *job;
+		_FORCE_INLINE_ bool operator()(void *p_data) {
+			Instance *instance = (Instance *)p_data;
+			if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !(job->visible_layers & instance->layer_mask)) {
+				return false;
+			}
 
-					if (instance->mesh_instance.is_valid()) {
-						RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-					}
-				}
-				shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
+			InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(instance->base_data);
+			if (!geom->can_cast_shadows) {
+				return false;
+			}
+			if (geom->material_is_animated) {
+				job->animated_material_found = true;
+			}
+			if (instance->mesh_instance.is_valid()) {
+				// Mesh storage is not thread safe, these are updated once all shadows are culled.
+				job->mesh_instances.push_back(instance->mesh_instance);
 			}
 
-			RSG::mesh_storage->update_mesh_instances();
+			job->shadow_data->instances.push_back(geom->geometry_instance);
+			return false;
+		}
+	};
 
-			RSG::light_storage->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0, 0);
-			shadow_data.light = light->instance;
-			shadow_data.pass = 0;
+	CullConvex cull_convex;
+	cull_convex.job = &job;
 
-		} break;
+	job.scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(job.planes, 6, job.points.ptr(), job.points.size(), cull_convex);
+}
+
+void RendererSceneCull::_light_shadow_cull_jobs_process() {
+	if (shadow_cull_jobs_used == 0) {
+		return;
 	}
 
-	return animated_material_found;
+	RENDER_TIMESTAMP("Cull Light3D Shadows");
+
+	if (shadow_cull_jobs_used > 1) {
+		// Every shadow pass writes to its own RenderShadowData, so they can all be culled at once.
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_light_shadow_cull_threaded, shadow_cull_jobs.ptr(), shadow_cull_jobs_used, -1, true, SNAME("RenderCullShadows"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_light_shadow_cull_threaded(0, shadow_cull_jobs.ptr());
+	}
+
+	for (uint32_t i = 0; i < shadow_cull_jobs_used; i++) {
+		ShadowCullJob &job = shadow_cull_jobs[i];
+		for (const RID &mesh_instance : job.mesh_instances) {
+			RSG::mesh_storage->mesh_instance_check_for_update(mesh_instance);
+		}
+		if (job.animated_material_found) {
+			job.light->shadow_dirty = true;
+		}
+	}
+
+	RSG::mesh_storage->update_mesh_instances();
+
+	shadow_cull_jobs_used = 0;
 }
 
 void RendererSceneCull::render_camera(const Ref<RenderSceneBuffers> &p_render_buffers, RID p_camera, RID p_scenario, RID p_viewport, Size2 p_viewport_size, bool p_use_taa, float p_screen_mesh_lod_threshold, RID p_shadow_atlas, Ref<XRInterface> &p_xr_interface, RenderInfo *r_render_info) {
@@ -2965,6 +3006,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 }
 
 void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_camera_data, const Ref<RenderSceneBuffers> &p_render_buffers, RID p_environment, RID p_force_camera_attributes, uint32_t p_visible_layers, RID p_scenario, RID p_viewport, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass, float p_screen_mesh_lod_threshold, bool p_using_shadows, RenderingMethod::RenderInfo *r_render_info) {
+	TRACE_SCOPE("RendererSceneCull::_render_scene");
 	Instance *render_reflection_probe = instance_owner.get_or_null(p_reflection_probe); //if null, not rendering to it
 
 	Scenario *scenario = scenario_owner.get_or_null(p_scenario);
@@ -3246,14 +3288,14 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 			bool redraw = RSG::light_storage->shadow_atlas_update_light(p_shadow_atlas, light->instance, coverage, light->last_version);
 
 			if (redraw && max_shadows_used < MAX_UPDATE_SHADOWS) {
-				//must redraw!
-				RENDER_TIMESTAMP("> Render Light3D " + itos(i));
-				light->shadow_dirty = _light_instance_update_shadow(ins, p_camera_data->main_transform, p_camera_data->main_projection, p_camera_data->is_orthogonal, p_camera_data->vaspect, p_shadow_atlas, scenario, p_screen_mesh_lod_threshold, p_visible_layers);
-				RENDER_TIMESTAMP("< Render Light3D " + itos(i));
+				//must redraw! the shadow passes are set up here, and culled all together below
+				light->shadow_dirty = _light_instance_update_shadow(ins, scenario, p_visible_layers);
 			} else {
 				light->shadow_dirty = redraw;
 			}
 		}
+
+		_light_shadow_cull_jobs_process();
 	}
 
 	//render SDFGI
@@ -4010,9 +4052,26 @@ void RendererSceneCull::update() {
 	scenario_owner.fill_owned_buffer(rids);
 	for (uint32_t i = 0; i < rid_count; i++) {
 		Scenario *s = scenario_owner.get_or_null(rids[i]);
-		s->indexers[Scenario::INDEXER_GEOMETRY].optimize_incremental(indexer_update_iterations);
-		s->indexers[Scenario::INDEXER_VOLUMES].optimize_incremental(indexer_update_iterations);
+		if (indexer_static_frames > 0) {
+			_update_static_indexers(s);
+		}
+		for (int j = 0; j < Scenario::INDEXER_MAX; j++) {
+			Scenario::Indexer &indexer = s->indexers[j];
+			indexer.dynamic_bvh.optimize_incremental(indexer_update_iterations);
+			// The static trees only need to catch up after instances are moved in or out.
+			if (indexer.static_changes > 0) {
+				if (indexer.static_changes * 4 >= uint32_t(indexer.static_bvh.get_leaf_count())) {
+					// After bulk changes, such as a level being loaded, rebuilding is cheaper than catching up.
+					indexer.static_bvh.optimize_top_down();
+				} else {
+					// Give every leaf moved in or out a pass on top of the usual budget.
+					indexer.static_bvh.optimize_incremental(indexer_update_iterations + indexer.static_changes);
+				}
+				indexer.static_changes = 0;
+			}
+		}
 	}
+	indexer_frame++;
 	scene_render->update();
 	update_dirty_instances();
 	render_particle_colliders();
@@ -4130,7 +4189,6 @@ RendererSceneCull::RendererSceneCull() {
 	singleton = this;
 
 	instance_cull_result.set_page_pool(&instance_cull_page_pool);
-	instance_shadow_cull_result.set_page_pool(&instance_cull_page_pool);
 
 	for (uint32_t i = 0; i < MAX_UPDATE_SHADOWS; i++) {
 		render_shadow_data[i].instances.set_page_pool(&geometry_instance_cull_page_pool);
@@ -4146,6 +4204,7 @@ RendererSceneCull::RendererSceneCull() {
 	}
 
 	indexer_update_iterations = GLOBAL_GET("rendering/limits/spatial_indexer/update_iterations_per_frame");
+	indexer_static_frames = GLOBAL_GET("rendering/limits/spatial_indexer/static_instance_frames");
 	thread_cull_threshold = GLOBAL_GET("rendering/limits/spatial_indexer/threaded_cull_minimum_instances");
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
 
@@ -4155,12 +4214,15 @@ RendererSceneCull::RendererSceneCull() {
 		taa_jitter_array[i].y = get_halton_value(i, 3);
 	}
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	// Unless the rasterizer is requested, modules providing another occlusion culling backend replace it when they are initialized.
+	raster_occlusion_culling = memnew(RendererSceneOcclusionCullRaster);
+	if (int(GLOBAL_GET("rendering/occlusion_culling/backend")) == 1) {
+		RendererSceneOcclusionCull::force_singleton(raster_occlusion_culling);
+	}
 }
 
 RendererSceneCull::~RendererSceneCull() {
 	instance_cull_result.reset();
-	instance_shadow_cull_result.reset();
 
 	for (uint32_t i = 0; i < MAX_UPDATE_SHADOWS; i++) {
 		render_shadow_data[i].instances.reset();
@@ -4175,7 +4237,7 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	if (raster_occlusion_culling) {
+		memdelete(raster_occlusion_culling);
 	}
 }
@@ -39,7 +39,7 @@
 #include "core/templates/pass_func.h"
 #include "core/templates/rid_owner.h"
 #include "core/templates/self_list.h"
-#include "servers/rendering/renderer_scene_occlusion_cull.h"
+#include "servers/rendering/renderer_scene_occlusion_cull_raster.h"
 #include "servers/rendering/renderer_scene_render.h"
 #include "servers/rendering/rendering_method.h"
 #include "servers/rendering/storage/utilities.h"
@@ -115,7 +115,7 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	RendererSceneOcclusionCullRaster *raster_occlusion_culling = nullptr;
 
 	/* SCENARIO API */
 
@@ -313,7 +313,40 @@ public:
 			INDEXER_MAX
 		};
 
-		DynamicBVH indexers[INDEXER_MAX];
+		// Instances that stopped moving are kept in a static tree that is rarely modified,
+		// so updates and refits are only paid for the ones that move. Queries go through both.
+		struct Indexer {
+			DynamicBVH static_bvh;
+			DynamicBVH dynamic_bvh;
+			uint32_t static_changes = 0; // Leaves inserted into or removed from the static tree since it was last optimized.
+
+			void set_index(uint32_t p_index) {
+				static_bvh.set_index(p_index);
+				dynamic_bvh.set_index(p_index);
+			}
+
+			template <class QueryResult>
+			_FORCE_INLINE_ void aabb_query(const AABB &p_aabb, QueryResult &r_result) {
+				static_bvh.aabb_query(p_aabb, r_result);
+				dynamic_bvh.aabb_query(p_aabb, r_result);
+			}
+
+			template <class QueryResult>
+			_FORCE_INLINE_ void convex_query(const Plane *p_planes, int p_plane_count, const Vector3 *p_points, int p_point_count, QueryResult &r_result) {
+				static_bvh.convex_query(p_planes, p_plane_count, p_points, p_point_count, r_result);
+				dynamic_bvh.convex_query(p_planes, p_plane_count, p_points, p_point_count, r_result);
+			}
+
+			template <class QueryResult>
+			_FORCE_INLINE_ void ray_query(const Vector3 &p_from, const Vector3 &p_to, QueryResult &r_result) {
+				static_bvh.ray_query(p_from, p_to, r_result);
+				dynamic_bvh.ray_query(p_from, p_to, r_result);
+			}
+		};
+
+		Indexer indexers[INDEXER_MAX];
+		// Instances in the dynamic trees, in the order they last moved.
+		SelfList<Instance>::List dynamic_instances;
 
 		RID self;
 
@@ -342,6 +375,8 @@ public:
 	};
 
 	int indexer_update_iterations = 0;
+	uint32_t indexer_static_frames = 0;
+	uint64_t indexer_frame = 0;
 
 	mutable RID_Owner<Scenario, true> scenario_owner;
 
@@ -435,6 +470,9 @@ public:
 		RID self;
 		//scenario stuff
 		DynamicBVH::ID indexer_id;
+		bool indexer_static = false;
+		uint64_t indexer_moved_frame = 0;
+		SelfList<Instance> indexer_dynamic_item;
 		int32_t array_index = -1;
 		int32_t visibility_index = -1;
 		float visibility_range_begin = 0.0f;
@@ -521,6 +559,7 @@ public:
 		}
 
 		Instance() :
+				indexer_dynamic_item(this),
 				scenario_item(this),
 				update_item(this) {
 			base_type = RS::INSTANCE_NONE;
@@ -729,8 +768,8 @@ public:
 		Instance *instance = nullptr;
 		PagedAllocator<InstancePair> *pair_allocator = nullptr;
 		SelfList<InstancePair>::List pairs_found;
-		DynamicBVH *bvh = nullptr;
-		DynamicBVH *bvh2 = nullptr; //some may need to cull in two
+		Scenario::Indexer *bvh = nullptr;
+		Scenario::Indexer *bvh2 = nullptr; //some may need to cull in two
 		uint32_t pair_mask;
 		uint64_t pair_pass;
 		uint32_t cull_mask = 0xFFFFFFFF; // Needed for decals and lights in the mobile and compatibility renderers.
@@ -790,7 +829,6 @@ public:
 	PagedArrayPool<RID> rid_cull_page_pool;
 
 	PagedArray<Instance *> instance_cull_result;
-	PagedArray<Instance *> instance_shadow_cull_result;
 
 	struct InstanceCullResult {
 		PagedArray<RenderGeometryInstance *> geometry_instances;
@@ -979,6 +1017,12 @@ public:
 	virtual Variant instance_geometry_get_shader_parameter(RID p_instance, const StringName &p_parameter) const;
 	virtual Variant instance_geometry_get_shader_parameter_default_value(RID p_instance, const StringName &p_parameter) const;
 
+	_FORCE_INLINE_ Scenario::Indexer &_get_instance_indexer(Instance *p_instance);
+	void _indexer_insert(Instance *p_instance, const AABB &p_aabb);
+	void _indexer_update(Instance *p_instance, const AABB &p_aabb);
+	void _indexer_remove(Instance *p_instance);
+	void _update_static_indexers(Scenario *p_scenario);
+
 	_FORCE_INLINE_ void _update_instance(Instance *p_instance);
 	_FORCE_INLINE_ void _update_instance_aabb(Instance *p_instance);
 	_FORCE_INLINE_ void _update_dirty_instance(Instance *p_instance);
@@ -987,7 +1031,25 @@ public:
 
 	void _light_instance_setup_directional_shadow(int p_shadow_index, Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect);
 
-	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_scren_mesh_lod_threshold, uint32_t p_visible_layers = 0xFFFFFF);
+	// One frustum of a positional light shadow, culled against the scenario on its own thread.
+	struct ShadowCullJob {
+		InstanceLightData *light = nullptr;
+		Scenario *scenario = nullptr;
+		uint32_t visible_layers = 0;
+		Plane planes[6];
+		Vector<Vector3> points;
+		RendererSceneRender::RenderShadowData *shadow_data = nullptr;
+		bool animated_material_found = false;
+		LocalVector<RID> mesh_instances;
+	};
+
+	LocalVector<ShadowCullJob> shadow_cull_jobs;
+	uint32_t shadow_cull_jobs_used = 0;
+
+	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, Scenario *p_scenario, uint32_t p_visible_layers = 0xFFFFFF);
+	ShadowCullJob &_light_shadow_cull_job_push(InstanceLightData *p_light, Scenario *p_scenario, uint32_t p_visible_layers);
+	void _light_shadow_cull_threaded(uint32_t p_job, ShadowCullJob *p_jobs);
+	void _light_shadow_cull_jobs_process();
 
 	RID _render_get_environment(RID p_camera, RID p_scenario);
 
@@ -31,6 +31,7 @@
 #include "renderer_scene_occlusion_cull.h"
 
 RendererSceneOcclusionCull *RendererSceneOcclusionCull::singleton = nullptr;
+bool RendererSceneOcclusionCull::singleton_forced = false;
 
 const Vector3 RendererSceneOcclusionCull::HZBuffer::corners[8] = {
 	Vector3(0, 0, 0),
@@ -38,6 +38,7 @@
 class RendererSceneOcclusionCull {
 protected:
 	static RendererSceneOcclusionCull *singleton;
+	static bool singleton_forced;
 
 public:
 	class HZBuffer {
@@ -192,12 +193,23 @@ public:
 
 	virtual void set_build_quality(RS::ViewportOcclusionCullingBuildQuality p_quality) {}
 
+	// Keeps the backend picked by the rendering server when modules register their own.
+	static void force_singleton(RendererSceneOcclusionCull *p_singleton) {
+		singleton = p_singleton;
+		singleton_forced = true;
+	}
+
 	RendererSceneOcclusionCull() {
-		singleton = this;
+		if (!singleton_forced) {
+			singleton = this;
+		}
 	};
 
 	virtual ~RendererSceneOcclusionCull() {
-		singleton = nullptr;
+		if (singleton == this) {
+			singleton = nullptr;
+			singleton_forced = false;
+		}
 	};
 };
 
@@ -0,0 +1,447 @@
+/**************************************************************************/
+/*  renderer_scene_occlusion_cull_raster.cpp                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "renderer_scene_occlusion_cull_raster.h"
+
+#include "core/math/bvh_simd.h"
+#include "core/object/worker_thread_pool.h"
+
+void RendererSceneOcclusionCullRaster::RasterHZBuffer::begin(const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	cam_inv_transform = p_cam_transform.affine_inverse();
+	cam_projection = p_cam_projection;
+	cam_orthogonal = p_cam_orthogonal;
+	z_near = p_cam_projection.get_z_near();
+	debug_tex_range = p_cam_projection.get_z_far();
+
+	triangles.clear();
+
+	uint32_t band_count = is_empty() ? 0 : (sizes[0].y + BAND_HEIGHT - 1) / BAND_HEIGHT;
+	band_triangles.resize(band_count);
+	for (uint32_t i = 0; i < band_count; i++) {
+		band_triangles[i].clear();
+	}
+}
+
+void RendererSceneOcclusionCullRaster::RasterHZBuffer::add_occluder(const Vector3 *p_vertices, uint32_t p_vertex_count, const uint32_t *p_indices, uint32_t p_index_count) {
+	if (is_empty()) {
+		return;
+	}
+
+	view_vertices.resize(p_vertex_count);
+	for (uint32_t i = 0; i < p_vertex_count; i++) {
+		view_vertices[i] = cam_inv_transform.xform(p_vertices[i]);
+	}
+
+	for (uint32_t i = 0; i + 2 < p_index_count; i += 3) {
+		ERR_CONTINUE(p_indices[i] >= p_vertex_count || p_indices[i + 1] >= p_vertex_count || p_indices[i + 2] >= p_vertex_count);
+
+		const Vector3 *v[3] = { &view_vertices[p_indices[i]], &view_vertices[p_indices[i + 1]], &view_vertices[p_indices[i + 2]] };
+
+		// Clip against the near plane, nothing behind it can be projected.
+		Vector3 clipped[4];
+		int clipped_count = 0;
+		for (int j = 0; j < 3; j++) {
+			const Vector3 &current = *v[j];
+			const Vector3 &next = *v[(j + 1) % 3];
+			bool current_inside = current.z <= -z_near;
+			bool next_inside = next.z <= -z_near;
+
+			if (current_inside) {
+				clipped[clipped_count++] = current;
+			}
+			if (current_inside != next_inside) {
+				real_t t = (-z_near - current.z) / (next.z - current.z);
+				clipped[clipped_count++] = current.lerp(next, t);
+			}
+		}
+
+		if (clipped_count >= 3) {
+			_add_triangle(clipped[0], clipped[1], clipped[2]);
+		}
+		if (clipped_count == 4) {
+			_add_triangle(clipped[0], clipped[2], clipped[3]);
+		}
+	}
+}
+
+void RendererSceneOcclusionCullRaster::RasterHZBuffer::_add_triangle(const Vector3 &p_a, const Vector3 &p_b, const Vector3 &p_c) {
+	const Size2i &size = sizes[0];
+	const Vector3 *view[3] = { &p_a, &p_b, &p_c };
+
+	Vector2 screen[3];
+	float depth[3];
+	for (int i = 0; i < 3; i++) {
+		Plane projected = cam_projection.xform4(Plane(*view[i], 1.0));
+		real_t w = projected.d;
+		if (w <= 0.0) {
+			return;
+		}
+		screen[i] = Vector2((projected.normal.x / w * 0.5f + 0.5f) * size.x, (projected.normal.y / w * 0.5f + 0.5f) * size.y);
+		depth[i] = cam_orthogonal ? -view[i]->z : 1.0f / -view[i]->z;
+	}
+
+	float area = (screen[1].x - screen[0].x) * (screen[2].y - screen[0].y) - (screen[1].y - screen[0].y) * (screen[2].x - screen[0].x);
+	if (Math::abs(area) < 1e-8f) {
+		return;
+	}
+
+	// Edge i is the one opposite to vertex i, so it evaluates to the barycentric weight of that vertex times the area.
+	Triangle triangle;
+	float sign = area > 0.0f ? 1.0f : -1.0f;
+	for (int i = 0; i < 3; i++) {
+		const Vector2 &from = screen[(i + 1) % 3];
+		const Vector2 &to = screen[(i + 2) % 3];
+		triangle.edges[i][0] = (from.y - to.y) * sign;
+		triangle.edges[i][1] = (to.x - from.x) * sign;
+		triangle.edges[i][2] = (from.x * to.y - from.y * to.x) * sign;
+	}
+
+	float inv_area = 1.0f / Math::abs(area);
+	for (int i = 0; i < 3; i++) {
+		triangle.depth[i] = 0.0f;
+		for (int j = 0; j < 3; j++) {
+			triangle.depth[i] += triangle.edges[j][i] * depth[j] * inv_area;
+		}
+	}
+
+	// Pixels are sampled at their centers.
+	Vector2 min = screen[0].min(screen[1]).min(screen[2]);
+	Vector2 max = screen[0].max(screen[1]).max(screen[2]);
+	triangle.min_x = MAX(0, int(Math::ceil(min.x - 0.5f)));
+	triangle.min_y = MAX(0, int(Math::ceil(min.y - 0.5f)));
+	triangle.max_x = MIN(size.x - 1, int(Math::floor(max.x - 0.5f)));
+	triangle.max_y = MIN(size.y - 1, int(Math::floor(max.y - 0.5f)));
+
+	if (triangle.min_x > triangle.max_x || triangle.min_y > triangle.max_y) {
+		return;
+	}
+
+	uint32_t index = triangles.size();
+	triangles.push_back(triangle);
+
+	for (int i = triangle.min_y / BAND_HEIGHT; i <= triangle.max_y / BAND_HEIGHT; i++) {
+		band_triangles[i].push_back(index);
+	}
+}
+
+void RendererSceneOcclusionCullRaster::RasterHZBuffer::_rasterize_band(uint32_t p_band, void *p_userdata) {
+	const Size2i &size = sizes[0];
+	int from_y = p_band * BAND_HEIGHT;
+	int to_y = MIN(from_y + BAND_HEIGHT, size.y);
+
+	float *depth_buffer = mips[0];
+	for (int i = from_y * size.x; i < to_y * size.x; i++) {
+		depth_buffer[i] = FLT_MAX;
+	}
+
+	for (const uint32_t &index : band_triangles[p_band]) {
+		const Triangle &triangle = triangles[index];
+		int min_y = MAX(triangle.min_y, from_y);
+		int max_y = MIN(triangle.max_y, to_y - 1);
+		float start_x = triangle.min_x + 0.5f;
+
+		for (int y = min_y; y <= max_y; y++) {
+			float pixel_y = y + 0.5f;
+			float e0 = triangle.edges[0][0] * start_x + triangle.edges[0][1] * pixel_y + triangle.edges[0][2];
+			float e1 = triangle.edges[1][0] * start_x + triangle.edges[1][1] * pixel_y + triangle.edges[1][2];
+			float e2 = triangle.edges[2][0] * start_x + triangle.edges[2][1] * pixel_y + triangle.edges[2][2];
+			float d = triangle.depth[0] * start_x + triangle.depth[1] * pixel_y + triangle.depth[2];
+
+			const float e0_step = triangle.edges[0][0];
+			const float e1_step = triangle.edges[1][0];
+			const float e2_step = triangle.edges[2][0];
+			const float d_step = triangle.depth[0];
+			const bool orthogonal = cam_orthogonal;
+
+			float *row = &depth_buffer[y * size.x + triangle.min_x];
+			int count = triangle.max_x - triangle.min_x + 1;
+
+			int x = 0;
+#ifdef BVH_SIMD_ENABLED
+			// Four pixels at a time: a pixel is outside when any of its edge functions is negative.
+			const float lane_offsets[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+			const BVHSIMD::Float4 lanes = BVHSIMD::load(lane_offsets);
+			const BVHSIMD::Float4 zero = BVHSIMD::splat(0.0f);
+			const BVHSIMD::Float4 one = BVHSIMD::splat(1.0f);
+			for (; x + 4 <= count; x += 4) {
+				BVHSIMD::Float4 fx = BVHSIMD::add(BVHSIMD::splat(float(x)), lanes);
+				BVHSIMD::Float4 w0 = BVHSIMD::add(BVHSIMD::splat(e0), BVHSIMD::mul(BVHSIMD::splat(e0_step), fx));
+				BVHSIMD::Float4 w1 = BVHSIMD::add(BVHSIMD::splat(e1), BVHSIMD::mul(BVHSIMD::splat(e1_step), fx));
+				BVHSIMD::Float4 w2 = BVHSIMD::add(BVHSIMD::splat(e2), BVHSIMD::mul(BVHSIMD::splat(e2_step), fx));
+				BVHSIMD::Mask4 outside = BVHSIMD::mask_or(BVHSIMD::mask_or(BVHSIMD::less(w0, zero), BVHSIMD::less(w1, zero)), BVHSIMD::less(w2, zero));
+
+				BVHSIMD::Float4 interpolated = BVHSIMD::add(BVHSIMD::splat(d), BVHSIMD::mul(BVHSIMD::splat(d_step), fx));
+				BVHSIMD::Float4 pixel_depth = orthogonal ? interpolated : BVHSIMD::div(one, interpolated);
+				BVHSIMD::Float4 current = BVHSIMD::load(&row[x]);
+				BVHSIMD::store(&row[x], BVHSIMD::select(outside, current, BVHSIMD::min(current, pixel_depth)));
+			}
+#endif
+			// Remaining pixels, or all of them on platforms without SIMD.
+			for (; x < count; x++) {
+				float fx = float(x);
+				bool inside = (e0 + e0_step * fx >= 0.0f) & (e1 + e1_step * fx >= 0.0f) & (e2 + e2_step * fx >= 0.0f);
+				float interpolated = d + d_step * fx;
+				float pixel_depth = orthogonal ? interpolated : 1.0f / interpolated;
+				row[x] = inside ? MIN(row[x], pixel_depth) : row[x];
+			}
+		}
+	}
+}
+
+void RendererSceneOcclusionCullRaster::RasterHZBuffer::end() {
+	if (is_empty()) {
+		return;
+	}
+
+	uint32_t band_count = band_triangles.size();
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_rasterize_band, (void *)nullptr, band_count, -1, true, SNAME("RasterOcclusionCull"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	update_mips();
+}
+
+////////////////////////////////////////////////////////
+
+bool RendererSceneOcclusionCullRaster::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RendererSceneOcclusionCullRaster::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RendererSceneOcclusionCullRaster::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RendererSceneOcclusionCullRaster::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_COND(!occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	for (const InstanceID &E : occluder->users) {
+		Scenario *scenario = scenarios.getptr(E.scenario);
+		ERR_CONTINUE(!scenario);
+		OccluderInstance *instance = scenario->instances.getptr(E.instance);
+		ERR_CONTINUE(!instance);
+		instance->dirty = true;
+	}
+}
+
+void RendererSceneOcclusionCullRaster::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_COND(!occluder);
+
+	// Instances still using it become empty until they get a new occluder.
+	for (const InstanceID &E : occluder->users) {
+		Scenario *scenario = scenarios.getptr(E.scenario);
+		ERR_CONTINUE(!scenario);
+		OccluderInstance *instance = scenario->instances.getptr(E.instance);
+		ERR_CONTINUE(!instance);
+		instance->occluder = RID();
+		instance->dirty = true;
+	}
+
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RendererSceneOcclusionCullRaster::add_scenario(RID p_scenario) {
+	if (!scenarios.has(p_scenario)) {
+		scenarios[p_scenario] = Scenario();
+	}
+}
+
+void RendererSceneOcclusionCullRaster::remove_scenario(RID p_scenario) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_COND(!scenario);
+
+	for (const KeyValue<RID, OccluderInstance> &E : scenario->instances) {
+		Occluder *occluder = occluder_owner.get_or_null(E.value.occluder);
+		if (occluder) {
+			occluder->users.erase(InstanceID(p_scenario, E.key));
+		}
+	}
+
+	scenarios.erase(p_scenario);
+}
+
+void RendererSceneOcclusionCullRaster::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_COND(!scenario);
+
+	OccluderInstance &instance = scenario->instances[p_instance];
+
+	if (instance.occluder != p_occluder) {
+		Occluder *old_occluder = occluder_owner.get_or_null(instance.occluder);
+		if (old_occluder) {
+			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		instance.occluder = p_occluder;
+
+		if (p_occluder.is_valid()) {
+			Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+			ERR_FAIL_COND(!occluder);
+			occluder->users.insert(InstanceID(p_scenario, p_instance));
+		}
+		instance.dirty = true;
+	}
+
+	if (instance.xform != p_xform) {
+		instance.xform = p_xform;
+		instance.dirty = true;
+	}
+
+	instance.enabled = p_enabled;
+}
+
+void RendererSceneOcclusionCullRaster::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_COND(!scenario);
+
+	OccluderInstance *instance = scenario->instances.getptr(p_instance);
+	if (!instance) {
+		return;
+	}
+
+	Occluder *occluder = occluder_owner.get_or_null(instance->occluder);
+	if (occluder) {
+		occluder->users.erase(InstanceID(p_scenario, p_instance));
+	}
+
+	scenario->instances.erase(p_instance);
+}
+
+void RendererSceneOcclusionCullRaster::_update_instance(OccluderInstance &r_instance) {
+	r_instance.dirty = false;
+	r_instance.xformed_vertices.clear();
+	r_instance.indices.clear();
+	r_instance.aabb = AABB();
+
+	Occluder *occluder = occluder_owner.get_or_null(r_instance.occluder);
+	if (!occluder || occluder->vertices.is_empty()) {
+		return;
+	}
+
+	int vertex_count = occluder->vertices.size();
+	const Vector3 *read = occluder->vertices.ptr();
+	r_instance.xformed_vertices.resize(vertex_count);
+	for (int i = 0; i < vertex_count; i++) {
+		Vector3 vertex = r_instance.xform.xform(read[i]);
+		r_instance.xformed_vertices[i] = vertex;
+		if (i == 0) {
+			r_instance.aabb.position = vertex;
+		} else {
+			r_instance.aabb.expand_to(vertex);
+		}
+	}
+
+	int index_count = occluder->indices.size();
+	const int32_t *indices = occluder->indices.ptr();
+	r_instance.indices.resize(index_count);
+	for (int i = 0; i < index_count; i++) {
+		r_instance.indices[i] = indices[i];
+	}
+}
+
+////////////////////////////////////////////////////////
+
+void RendererSceneOcclusionCullRaster::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RendererSceneOcclusionCullRaster::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+RendererSceneOcclusionCull::HZBuffer *RendererSceneOcclusionCullRaster::buffer_get_ptr(RID p_buffer) {
+	return buffers.getptr(p_buffer);
+}
+
+void RendererSceneOcclusionCullRaster::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RendererSceneOcclusionCullRaster::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RendererSceneOcclusionCullRaster::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	RasterHZBuffer *buffer = buffers.getptr(p_buffer);
+	if (!buffer || buffer->is_empty()) {
+		return;
+	}
+
+	Scenario *scenario = scenarios.getptr(buffer->scenario_rid);
+	if (!scenario) {
+		return;
+	}
+
+	Vector<Plane> planes = p_cam_projection.get_projection_planes(p_cam_transform);
+	Vector3 points[8];
+	p_cam_projection.get_endpoints(p_cam_transform, points);
+
+	buffer->begin(p_cam_transform, p_cam_projection, p_cam_orthogonal);
+
+	for (KeyValue<RID, OccluderInstance> &E : scenario->instances) {
+		OccluderInstance &instance = E.value;
+		if (!instance.enabled) {
+			continue;
+		}
+
+		if (instance.dirty) {
+			_update_instance(instance);
+		}
+
+		if (instance.xformed_vertices.is_empty() || !instance.aabb.intersects_convex_shape(planes.ptr(), planes.size(), points, 8)) {
+			continue;
+		}
+
+		buffer->add_occluder(instance.xformed_vertices.ptr(), instance.xformed_vertices.size(), instance.indices.ptr(), instance.indices.size());
+	}
+
+	buffer->end();
+}
+
+RID RendererSceneOcclusionCullRaster::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
@@ -0,0 +1,228 @@
+/**************************************************************************/
+/*  test_trace_recorder.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_TRACE_RECORDER_H
+#define TEST_TRACE_RECORDER_H
+
+#include "core/debugger/trace_recorder.h"
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestTraceRecorder {
+
+// Recorders can't be created for every test, see TraceRecorder.
+static TraceRecorder &get_recorder() {
+	static TraceRecorder recorder;
+	return recorder;
+}
+
+struct RecordingThread {
+	Thread thread;
+	SafeFlag exit;
+	uint32_t events = 0;
+	SafeNumeric<uint32_t> recorded;
+
+	static void run(void *p_userdata) {
+		RecordingThread *self = static_cast<RecordingThread *>(p_userdata);
+		TraceRecorder &recorder = get_recorder();
+		static TraceRecorder::NameCache name_cache;
+		// Either records a fixed number of events, or until asked to exit.
+		for (uint32_t i = 0; self->events == 0 || i < self->events; i++) {
+			if (self->events == 0 && self->exit.is_set()) {
+				break;
+			}
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			const uint32_t name = i % 2 ? recorder.get_name_index("Odd") : recorder.get_name_index(name_cache, []() { return String("Even"); });
+			recorder.record(name, begin, OS::get_singleton()->get_ticks_usec());
+			self->recorded.increment();
+		}
+	}
+};
+
+TEST_CASE("[TraceRecorder] Events are recorded for each thread") {
+	TraceRecorder &recorder = get_recorder();
+	recorder.start(1024);
+
+	RecordingThread threads[4];
+	for (RecordingThread &thread : threads) {
+		thread.events = 100;
+		thread.thread.start(RecordingThread::run, &thread);
+	}
+	for (RecordingThread &thread : threads) {
+		thread.thread.wait_to_finish();
+	}
+	recorder.stop();
+
+	LocalVector<TraceRecorder::ThreadEvents> recorded;
+	recorder.get_events(recorded);
+	REQUIRE(recorded.size() == 4);
+	for (const TraceRecorder::ThreadEvents &thread_events : recorded) {
+		CHECK(thread_events.thread_id != Thread::get_caller_id());
+		REQUIRE(thread_events.events.size() == 100);
+		CHECK(recorder.get_name(thread_events.events[0].name) == "Even");
+		CHECK(recorder.get_name(thread_events.events[1].name) == "Odd");
+		for (uint32_t i = 1; i < thread_events.events.size(); i++) {
+			CHECK(thread_events.events[i - 1].end <= thread_events.events[i].end);
+		}
+	}
+
+	recorder.clear();
+	recorded.clear();
+	recorder.get_events(recorded);
+	CHECK_MESSAGE(recorded.is_empty(), "The events of exited threads should be released when clearing the trace.");
+}
+
+TEST_CASE("[TraceRecorder] The oldest events are overwritten") {
+	TraceRecorder &recorder = get_recorder();
+	recorder.start(1500);
+	const uint32_t name = recorder.get_name_index("Event");
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec() + 1;
+	for (uint32_t i = 0; i < 3000; i++) {
+		recorder.record(name, begin + i, begin + i);
+	}
+	recorder.stop();
+
+	LocalVector<TraceRecorder::ThreadEvents> recorded;
+	recorder.get_events(recorded);
+	REQUIRE(recorded.size() == 1);
+	CHECK(recorded[0].thread_id == Thread::get_caller_id());
+	REQUIRE_MESSAGE(recorded[0].events.size() == 2048, "The buffer size should be rounded up to the next power of 2.");
+	CHECK(recorded[0].events[0].begin == begin + 3000 - 2048);
+	CHECK(recorded[0].events[2047].begin == begin + 2999);
+
+	recorder.clear();
+}
+
+TEST_CASE("[TraceRecorder] Names are registered again for each recording") {
+	TraceRecorder &recorder = get_recorder();
+	TraceRecorder::NameCache name_cache;
+	uint32_t calls = 0;
+	const auto get_name = [&calls]() {
+		calls++;
+		return String("Cached");
+	};
+
+	recorder.start(1024);
+	recorder.get_name_index("Other");
+	const uint32_t index = recorder.get_name_index(name_cache, get_name);
+	CHECK(recorder.get_name_index(name_cache, get_name) == index);
+	CHECK_MESSAGE(calls == 1, "The name should only be built when it isn't cached.");
+	CHECK(recorder.get_name(index) == "Cached");
+	recorder.stop();
+	recorder.clear();
+
+	recorder.start(1024);
+	const uint32_t new_index = recorder.get_name_index(name_cache, get_name);
+	CHECK(calls == 2);
+	CHECK(new_index == 0);
+	CHECK(recorder.get_name(new_index) == "Cached");
+	CHECK(recorder.get_name_index("Other") == 1);
+	recorder.stop();
+	recorder.clear();
+}
+
+TEST_CASE("[TraceRecorder] Recordings can be stopped and cleared while threads record") {
+	TraceRecorder &recorder = get_recorder();
+
+	RecordingThread threads[4];
+	for (RecordingThread &thread : threads) {
+		thread.thread.start(RecordingThread::run, &thread);
+	}
+
+	for (int i = 0; i < 50; i++) {
+		recorder.start(1024);
+		const uint32_t recorded_before = threads[0].recorded.get();
+		while (threads[0].recorded.get() - recorded_before < 10) {
+			OS::get_singleton()->delay_usec(10);
+		}
+		recorder.stop();
+
+		LocalVector<TraceRecorder::ThreadEvents> recorded;
+		recorder.get_events(recorded);
+		CHECK(recorded.size() <= 4);
+		uint32_t events = 0;
+		for (const TraceRecorder::ThreadEvents &thread_events : recorded) {
+			CHECK(thread_events.events.size() <= 1024);
+			events += thread_events.events.size();
+		}
+
+		// Let the threads try to record while stopped.
+		OS::get_singleton()->delay_usec(100);
+		recorded.clear();
+		recorder.get_events(recorded);
+		uint32_t events_after_stop = 0;
+		for (const TraceRecorder::ThreadEvents &thread_events : recorded) {
+			events_after_stop += thread_events.events.size();
+		}
+		CHECK_MESSAGE(events_after_stop == events, "No events should be recorded once stopped.");
+
+		recorder.clear();
+		recorded.clear();
+		recorder.get_events(recorded);
+		CHECK(recorded.is_empty());
+	}
+
+	for (RecordingThread &thread : threads) {
+		thread.exit.set();
+		thread.thread.wait_to_finish();
+	}
+}
+
+TEST_CASE("[TraceRecorder] Save a Chrome trace") {
+	TraceRecorder &recorder = get_recorder();
+	recorder.start(1024);
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec() + 1;
+	recorder.record(recorder.get_name_index("Quoted \"name\""), begin, begin + 10);
+	recorder.stop();
+
+	const String path = OS::get_singleton()->get_cache_path().path_join("trace_recorder.json");
+	CHECK(recorder.save_chrome_trace(path) == OK);
+	recorder.clear();
+
+	const Dictionary trace = JSON::parse_string(FileAccess::get_file_as_string(path));
+	const Array events = trace["traceEvents"];
+	REQUIRE(events.size() == 2);
+
+	const Dictionary thread_name = events[0];
+	CHECK(thread_name["ph"] == "M");
+	CHECK(Dictionary(thread_name["args"])["name"] == "Main thread");
+
+	const Dictionary event = events[1];
+	CHECK(event["name"] == "Quoted \"name\"");
+	CHECK(event["ph"] == "X");
+	CHECK(int(event["dur"]) == 10);
+}
+
+} // namespace TestTraceRecorder
+
+#endif // TEST_TRACE_RECORDER_H
@@ -105,6 +105,34 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+TEST_CASE("[FileAccess] Mapped buffer") {
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("line_endings_lf.test.txt"), FileAccess::READ);
+	REQUIRE(!f.is_null());
+	const String expected = "Hello darkness\nMy old friend\nI've come to talk\nWith you again\n";
+
+	CHECK(f->get_line() == "Hello darkness");
+	const uint64_t position = f->get_position();
+	const uint8_t *mapped = f->get_mapped_buffer();
+	if (!mapped) {
+		// Not every platform can map files.
+		return;
+	}
+
+	CHECK_MESSAGE(f->get_position() == position, "Mapping the file should not move the read position.");
+	CHECK(f->get_length() == uint64_t(expected.length()));
+	CHECK(String::utf8((const char *)mapped, f->get_length()) == expected);
+
+	// Reading goes on from the mapping.
+	CHECK(f->get_line() == "My old friend");
+	f->seek(0);
+	CHECK(f->get_line() == "Hello darkness");
+	f->seek_end(-15);
+	CHECK(f->get_line() == "With you again");
+	CHECK_FALSE(f->eof_reached());
+	f->get_8();
+	CHECK(f->eof_reached());
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
@@ -40,6 +40,13 @@
 
 namespace TestPCKPacker {
 
+// Removes the packs added by a test case from the global PackedData, even when it fails.
+struct PackedDataCleanup {
+	~PackedDataCleanup() {
+		PackedData::get_singleton()->clear();
+	}
+};
+
 TEST_CASE("[PCKPacker] Pack an empty PCK file") {
 	PCKPacker pck_packer;
 	const String output_pck_path = OS::get_singleton()->get_cache_path().path_join("output_empty.pck");
@@ -116,6 +123,127 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 	CHECK_MESSAGE(
 			f->get_length() <= 35000,
 			"The generated non-empty PCK file shouldn't be too large.");
+	f->seek(4);
+	CHECK_MESSAGE(
+			f->get_32() == PACK_FORMAT_VERSION_UNCOMPRESSED,
+			"A PCK file without compressed files should keep the version readable by older engines.");
+}
+
+TEST_CASE("[PCKPacker] Pack and read a compressed file") {
+	PCKPacker pck_packer;
+	const String output_pck_path = OS::get_singleton()->get_cache_path().path_join("output_compressed.pck");
+	const String source_path = OS::get_singleton()->get_cache_path().path_join("output_compressed_source.bin");
+
+	// Spans several blocks, the last one being partial.
+	Vector<uint8_t> data;
+	data.resize(PACK_COMPRESSED_BLOCK_SIZE * 3 + 1234);
+	for (int i = 0; i < data.size(); i++) {
+		data.write[i] = (i / 7) % 251;
+	}
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(data.ptr(), data.size());
+	}
+
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(
+			pck_packer.add_file("res://pck_packer_compressed.bin", source_path, true, true) != OK,
+			"Adding a file both encrypted and compressed should fail.");
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(
+			pck_packer.add_file("res://pck_packer_compressed.bin", source_path, false, true) == OK,
+			"Adding a compressed file to the PCK should return an OK error code.");
+	REQUIRE(pck_packer.flush() == OK);
+
+	{
+		Ref<FileAccess> f = FileAccess::open(output_pck_path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK_MESSAGE(
+				f->get_length() < uint64_t(data.size()),
+				"The generated PCK file should be smaller than the file it compresses.");
+		f->seek(4);
+		CHECK_MESSAGE(
+				f->get_32() == PACK_FORMAT_VERSION,
+				"A PCK file with compressed files should use the current version.");
+	}
+
+	PackedDataCleanup cleanup;
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, false, 0) == OK);
+	Ref<FileAccess> f = PackedData::get_singleton()->try_open_path("res://pck_packer_compressed.bin");
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == uint64_t(data.size()));
+
+	Vector<uint8_t> read_data;
+	read_data.resize(data.size());
+	CHECK(f->get_buffer(read_data.ptrw(), read_data.size()) == uint64_t(data.size()));
+	CHECK_MESSAGE(read_data == data, "Reading the whole compressed file should give back its contents.");
+
+	// Seek back to the middle of a block and read across the next one.
+	const uint64_t position = PACK_COMPRESSED_BLOCK_SIZE * 2 - 100;
+	f->seek(position);
+	uint8_t buffer[200];
+	CHECK(f->get_buffer(buffer, 200) == 200);
+	CHECK_MESSAGE(memcmp(buffer, data.ptr() + position, 200) == 0, "Reading across blocks after seeking should match the contents.");
+	f->seek(10);
+	CHECK(f->get_8() == data[10]);
+	f->seek_end(-1);
+	CHECK(f->get_8() == data[data.size() - 1]);
+	CHECK_FALSE(f->eof_reached());
+	f->get_8();
+	CHECK(f->eof_reached());
+}
+
+TEST_CASE("[PCKPacker] Look up files in the path index of packs") {
+	const String cache_path = OS::get_singleton()->get_cache_path();
+	const String first_path = cache_path.path_join("output_index_first.txt");
+	const String second_path = cache_path.path_join("output_index_second.txt");
+	FileAccess::open(first_path, FileAccess::WRITE)->store_string("first");
+	FileAccess::open(second_path, FileAccess::WRITE)->store_string("second");
+
+	const String first_pck_path = cache_path.path_join("output_index_first.pck");
+	PCKPacker first_packer;
+	REQUIRE(first_packer.pck_start(first_pck_path) == OK);
+	CHECK(first_packer.add_file("res://pck_packer_index/file.txt", second_path) == OK);
+	CHECK(first_packer.add_file("res://pck_packer_index/sub/other.txt", second_path) == OK);
+	// Adding a path again replaces it.
+	CHECK(first_packer.add_file("res://pck_packer_index/file.txt", first_path) == OK);
+	REQUIRE(first_packer.flush() == OK);
+
+	const String second_pck_path = cache_path.path_join("output_index_second.pck");
+	PCKPacker second_packer;
+	REQUIRE(second_packer.pck_start(second_pck_path) == OK);
+	CHECK(second_packer.add_file("res://pck_packer_index/file.txt", second_path) == OK);
+	REQUIRE(second_packer.flush() == OK);
+
+	PackedDataCleanup cleanup;
+	PackedData *packed_data = PackedData::get_singleton();
+	REQUIRE(packed_data->add_pack(first_pck_path, false, 0) == OK);
+	CHECK(packed_data->has_path("res://pck_packer_index/file.txt"));
+	CHECK(packed_data->has_path("res://pck_packer_index/sub/other.txt"));
+	CHECK_FALSE(packed_data->has_path("res://pck_packer_index/missing.txt"));
+
+	Ref<FileAccess> f = packed_data->try_open_path("res://pck_packer_index/file.txt");
+	REQUIRE(f.is_valid());
+	CHECK(f->get_as_utf8_string() == "first");
+
+	Ref<DirAccess> da = packed_data->try_open_directory("res://pck_packer_index");
+	REQUIRE(da.is_valid());
+	CHECK(da->file_exists("file.txt"));
+	CHECK(da->dir_exists("sub"));
+	CHECK(da->file_exists("sub/other.txt"));
+
+	// Packs added later only provide the files they have in common when replacing files.
+	REQUIRE(packed_data->add_pack(second_pck_path, false, 0) == OK);
+	f = packed_data->try_open_path("res://pck_packer_index/file.txt");
+	REQUIRE(f.is_valid());
+	CHECK(f->get_as_utf8_string() == "first");
+
+	REQUIRE(packed_data->add_pack(second_pck_path, true, 0) == OK);
+	f = packed_data->try_open_path("res://pck_packer_index/file.txt");
+	REQUIRE(f.is_valid());
+	CHECK(f->get_as_utf8_string() == "second");
 }
 } // namespace TestPCKPacker
 
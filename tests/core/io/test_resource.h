@@ -109,6 +109,47 @@ TEST_CASE("[Resource] Saving and loading") {
 			loaded_child_resource_text->get_name() == "I'm a child resource",
 			"The loaded child resource name should be equal to the expected value.");
 }
+
+TEST_CASE("[Resource] Threaded loading with sub-resources") {
+	const String cache_path = OS::get_singleton()->get_cache_path();
+	const String save_path_main = cache_path.path_join("resource_threaded.tres");
+
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("Main resource");
+	for (int i = 0; i < 8; i++) {
+		Ref<Resource> child_resource = memnew(Resource);
+		child_resource->set_name("Child resource " + itos(i));
+		// Saving the child resources on their own makes them external resources of the main one.
+		const String save_path_child = cache_path.path_join("resource_threaded_child_" + itos(i) + (i % 2 ? ".res" : ".tres"));
+		ResourceSaver::save(child_resource, save_path_child);
+		child_resource->set_path(save_path_child);
+		resource->set_meta("child_" + itos(i), child_resource);
+	}
+	ResourceSaver::save(resource, save_path_main);
+	resource.unref();
+
+	CHECK_EQ(ResourceLoader::load_threaded_request(save_path_main, "", true), OK);
+	CHECK_NE(ResourceLoader::load_threaded_get_status(save_path_main), ResourceLoader::THREAD_LOAD_INVALID_RESOURCE);
+
+	Error error = FAILED;
+	Ref<Resource> loaded_resource = ResourceLoader::load_threaded_get(save_path_main, &error);
+	CHECK_EQ(error, OK);
+	REQUIRE(loaded_resource.is_valid());
+	CHECK_MESSAGE(
+			loaded_resource->get_name() == "Main resource",
+			"The loaded resource name should be equal to the expected value.");
+	for (int i = 0; i < 8; i++) {
+		const Ref<Resource> &loaded_child_resource = loaded_resource->get_meta("child_" + itos(i));
+		REQUIRE(loaded_child_resource.is_valid());
+		CHECK_MESSAGE(
+				loaded_child_resource->get_name() == "Child resource " + itos(i),
+				"The sub-resources loaded on other threads should be equal to the expected values.");
+	}
+
+	CHECK_MESSAGE(
+			ResourceLoader::load_threaded_get_status(save_path_main) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE,
+			"The load should be forgotten once its only request was completed.");
+}
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
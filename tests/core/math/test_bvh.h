@@ -0,0 +1,177 @@
+/**************************************************************************/
+/*  test_bvh.h                                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BVH_H
+#define TEST_BVH_H
+
+#include "core/math/bvh.h"
+#include "core/math/random_pcg.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/hash_set.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBVH {
+
+template <class T>
+class PairTestFunction {
+public:
+	static bool user_pair_check(const T *p_a, const T *p_b) {
+		return true;
+	}
+};
+
+template <class T>
+class CullTestFunction {
+public:
+	static bool user_cull_check(const T *p_a, const T *p_b) {
+		return true;
+	}
+};
+
+typedef BVH_Manager<int, 1, true, 32, PairTestFunction<int>, CullTestFunction<int>> TestBVHManager;
+
+struct PairEvent {
+	bool paired = false;
+	int a = 0;
+	int b = 0;
+
+	bool operator==(const PairEvent &p_other) const {
+		return paired == p_other.paired && a == p_other.a && b == p_other.b;
+	}
+};
+
+struct PairRecorder {
+	LocalVector<PairEvent> events;
+	HashSet<uint64_t> pairs;
+
+	static uint64_t pair_key(int p_a, int p_b) {
+		return p_a < p_b ? (((uint64_t)p_a << 32) | (uint64_t)p_b) : (((uint64_t)p_b << 32) | (uint64_t)p_a);
+	}
+
+	static void *pair_callback(void *p_self, uint32_t p_id_a, int *p_a, int p_subindex_a, uint32_t p_id_b, int *p_b, int p_subindex_b) {
+		PairRecorder *self = static_cast<PairRecorder *>(p_self);
+		self->events.push_back({ true, *p_a, *p_b });
+		self->pairs.insert(pair_key(*p_a, *p_b));
+		return nullptr;
+	}
+
+	static void unpair_callback(void *p_self, uint32_t p_id_a, int *p_a, int p_subindex_a, uint32_t p_id_b, int *p_b, int p_subindex_b, void *p_pair_data) {
+		PairRecorder *self = static_cast<PairRecorder *>(p_self);
+		self->events.push_back({ false, *p_a, *p_b });
+		self->pairs.erase(pair_key(*p_a, *p_b));
+	}
+};
+
+static void worker_thread_pool_parallel_for(void *p_userdata, void (*p_job)(void *, uint32_t), void *p_job_userdata, uint32_t p_count) {
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(p_job, p_job_userdata, p_count, -1, true, "BVHPairingTest");
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+static AABB random_aabb(RandomPCG &p_rng) {
+	const Vector3 position(p_rng.random(-50.0f, 50.0f), p_rng.random(-50.0f, 50.0f), p_rng.random(-50.0f, 50.0f));
+	const Vector3 size(p_rng.random(0.5f, 8.0f), p_rng.random(0.5f, 8.0f), p_rng.random(0.5f, 8.0f));
+	return AABB(position, size);
+}
+
+TEST_CASE("[BVH] Threaded pairing matches serial pairing") {
+	const int item_count = 256;
+	RandomPCG rng(7);
+
+	TestBVHManager serial_bvh;
+	TestBVHManager threaded_bvh;
+	PairRecorder serial_recorder;
+	PairRecorder threaded_recorder;
+	serial_bvh.params_set_pairing_expansion(0);
+	threaded_bvh.params_set_pairing_expansion(0);
+	serial_bvh.set_pair_callback(PairRecorder::pair_callback, &serial_recorder);
+	serial_bvh.set_unpair_callback(PairRecorder::unpair_callback, &serial_recorder);
+	threaded_bvh.set_pair_callback(PairRecorder::pair_callback, &threaded_recorder);
+	threaded_bvh.set_unpair_callback(PairRecorder::unpair_callback, &threaded_recorder);
+	threaded_bvh.set_parallel_for_callback(worker_thread_pool_parallel_for, nullptr);
+
+	int values[item_count];
+	LocalVector<AABB> aabbs;
+	LocalVector<BVHHandle> serial_handles;
+	LocalVector<BVHHandle> threaded_handles;
+	for (int i = 0; i < item_count; i++) {
+		values[i] = i;
+		aabbs.push_back(random_aabb(rng));
+		serial_handles.push_back(serial_bvh.create(&values[i], true, 0, 1, aabbs[i]));
+		threaded_handles.push_back(threaded_bvh.create(&values[i], true, 0, 1, aabbs[i]));
+	}
+	serial_bvh.update();
+	threaded_bvh.update();
+
+	for (int frame = 0; frame < 4; frame++) {
+		// Move every item, so all of them are paired on the threads.
+		for (int i = 0; i < item_count; i++) {
+			aabbs[i] = random_aabb(rng);
+			serial_bvh.move(serial_handles[i], aabbs[i]);
+			threaded_bvh.move(threaded_handles[i], aabbs[i]);
+		}
+		serial_recorder.events.clear();
+		threaded_recorder.events.clear();
+		serial_bvh.update();
+		threaded_bvh.update();
+
+		REQUIRE(serial_recorder.events.size() > 0);
+		REQUIRE(threaded_recorder.events.size() == serial_recorder.events.size());
+		bool same_events = true;
+		for (uint32_t i = 0; i < serial_recorder.events.size(); i++) {
+			same_events = same_events && threaded_recorder.events[i] == serial_recorder.events[i];
+		}
+		CHECK_MESSAGE(same_events, "Pair and unpair callbacks should be sent in the same order as without threads.");
+
+		int missing_pairs = 0;
+		int expected_pair_count = 0;
+		for (int i = 0; i < item_count; i++) {
+			for (int j = i + 1; j < item_count; j++) {
+				if (aabbs[i].intersects(aabbs[j])) {
+					expected_pair_count++;
+					if (!threaded_recorder.pairs.has(PairRecorder::pair_key(i, j))) {
+						missing_pairs++;
+					}
+				}
+			}
+		}
+		CHECK_EQ(missing_pairs, 0);
+		CHECK_EQ((int)threaded_recorder.pairs.size(), expected_pair_count);
+	}
+
+	for (int i = 0; i < item_count; i++) {
+		serial_bvh.erase(serial_handles[i]);
+		threaded_bvh.erase(threaded_handles[i]);
+	}
+}
+
+} // namespace TestBVH
+
+#endif // TEST_BVH_H
@@ -0,0 +1,108 @@
+/**************************************************************************/
+/*  test_dynamic_bvh.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_DYNAMIC_BVH_H
+#define TEST_DYNAMIC_BVH_H
+
+#include "core/math/dynamic_bvh.h"
+#include "core/math/geometry_3d.h"
+#include "core/math/random_pcg.h"
+
+#include "tests/test_macros.h"
+
+namespace TestDynamicBVH {
+
+struct CollectResult {
+	LocalVector<bool> hits;
+
+	CollectResult(uint32_t p_count) {
+		hits.resize(p_count);
+		for (uint32_t i = 0; i < p_count; i++) {
+			hits[i] = false;
+		}
+	}
+
+	bool operator()(void *p_data) {
+		hits[(uint32_t)(uintptr_t)p_data] = true;
+		return false;
+	}
+};
+
+static Vector3 random_vector3(RandomPCG &p_rng, real_t p_from, real_t p_to) {
+	return Vector3(p_rng.random(p_from, p_to), p_rng.random(p_from, p_to), p_rng.random(p_from, p_to));
+}
+
+TEST_CASE("[DynamicBVH] Queries match brute force tests") {
+	RandomPCG rng(42);
+	DynamicBVH bvh;
+	LocalVector<AABB> boxes;
+
+	for (uint32_t i = 0; i < 256; i++) {
+		AABB box(random_vector3(rng, -50, 50), random_vector3(rng, 0.5, 5));
+		boxes.push_back(box);
+		bvh.insert(box, (void *)(uintptr_t)i);
+	}
+
+	for (int query = 0; query < 16; query++) {
+		const AABB query_box(random_vector3(rng, -50, 50), random_vector3(rng, 5, 25));
+
+		CollectResult aabb_result(boxes.size());
+		bvh.aabb_query(query_box, aabb_result);
+
+		// An axis aligned box as a convex shape, should find the same boxes as the AABB query.
+		Vector<Plane> planes = Geometry3D::build_box_planes(query_box.size * 0.5);
+		for (Plane &plane : planes) {
+			plane.d += plane.normal.dot(query_box.get_center());
+		}
+		Vector3 points[8];
+		for (int i = 0; i < 8; i++) {
+			points[i] = query_box.get_endpoint(i);
+		}
+
+		CollectResult convex_result(boxes.size());
+		bvh.convex_query(planes.ptr(), planes.size(), points, 8, convex_result);
+
+		const Vector3 from = random_vector3(rng, -60, 60);
+		const Vector3 to = random_vector3(rng, -60, 60);
+
+		CollectResult ray_result(boxes.size());
+		bvh.ray_query(from, to, ray_result);
+
+		for (uint32_t i = 0; i < boxes.size(); i++) {
+			CHECK_MESSAGE(aabb_result.hits[i] == boxes[i].intersects(query_box), "AABB query should find exactly the intersecting boxes.");
+			CHECK_MESSAGE(convex_result.hits[i] == boxes[i].intersects(query_box), "Convex query should find exactly the intersecting boxes.");
+			CHECK_MESSAGE(ray_result.hits[i] == boxes[i].intersects_segment(from, to), "Ray query should find exactly the boxes crossed by the segment.");
+		}
+	}
+}
+
+} // namespace TestDynamicBVH
+
+#endif // TEST_DYNAMIC_BVH_H
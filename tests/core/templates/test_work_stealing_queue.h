@@ -0,0 +1,154 @@
+/**************************************************************************/
+/*  test_work_stealing_queue.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_WORK_STEALING_QUEUE_H
+#define TEST_WORK_STEALING_QUEUE_H
+
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_queue.h"
+
+#include "tests/test_macros.h"
+
+namespace TestWorkStealingQueue {
+
+TEST_CASE("[WorkStealingQueue] Pop is LIFO, steal is FIFO") {
+	WorkStealingQueue<intptr_t> queue;
+	intptr_t value = 0;
+
+	CHECK(queue.is_empty());
+	CHECK(!queue.pop(value));
+	CHECK(!queue.steal(value));
+
+	for (intptr_t i = 1; i <= 4; i++) {
+		queue.push(i);
+	}
+	CHECK(queue.size() == 4);
+
+	CHECK(queue.pop(value));
+	CHECK(value == 4);
+	CHECK(queue.steal(value));
+	CHECK(value == 1);
+	CHECK(queue.pop(value));
+	CHECK(value == 3);
+	CHECK(queue.steal(value));
+	CHECK(value == 2);
+
+	CHECK(queue.is_empty());
+	CHECK(!queue.pop(value));
+}
+
+TEST_CASE("[WorkStealingQueue] Grow keeps elements") {
+	WorkStealingQueue<intptr_t> queue(2);
+	const intptr_t count = 1000;
+
+	for (intptr_t i = 0; i < count; i++) {
+		queue.push(i);
+	}
+	CHECK(queue.size() == count);
+
+	intptr_t value = 0;
+	bool in_order = true;
+	for (intptr_t i = 0; i < count; i++) {
+		if (!queue.steal(value) || value != i) {
+			in_order = false;
+		}
+	}
+	CHECK(in_order);
+	CHECK(queue.is_empty());
+}
+
+struct StealData {
+	WorkStealingQueue<intptr_t> *queue = nullptr;
+	SafeFlag *done = nullptr;
+	SafeNumeric<uint32_t> *counters = nullptr;
+};
+
+static void steal_thread(void *p_userdata) {
+	StealData *data = (StealData *)p_userdata;
+	intptr_t value = 0;
+	while (!data->done->is_set()) {
+		if (data->queue->steal(value)) {
+			data->counters[value].increment();
+		}
+	}
+	while (data->queue->steal(value)) {
+		data->counters[value].increment();
+	}
+}
+
+TEST_CASE("[WorkStealingQueue] Every element is taken exactly once with concurrent thieves") {
+	const int count = 20000;
+	const int thief_count = 4;
+
+	WorkStealingQueue<intptr_t> queue(4);
+	SafeFlag done;
+	LocalVector<SafeNumeric<uint32_t>> counters;
+	counters.resize(count);
+
+	StealData data;
+	data.queue = &queue;
+	data.done = &done;
+	data.counters = counters.ptr();
+
+	Thread thieves[thief_count];
+	for (int i = 0; i < thief_count; i++) {
+		thieves[i].start(steal_thread, &data);
+	}
+
+	intptr_t value = 0;
+	for (int i = 0; i < count; i++) {
+		queue.push(i);
+		if (i % 3 == 0 && queue.pop(value)) {
+			counters[value].increment();
+		}
+	}
+	while (queue.pop(value)) {
+		counters[value].increment();
+	}
+
+	done.set();
+	for (int i = 0; i < thief_count; i++) {
+		thieves[i].wait_to_finish();
+	}
+
+	bool all_once = true;
+	for (int i = 0; i < count; i++) {
+		if (counters[i].get() != 1) {
+			all_once = false;
+		}
+	}
+	CHECK(all_once);
+}
+
+} // namespace TestWorkStealingQueue
+
+#endif // TEST_WORK_STEALING_QUEUE_H
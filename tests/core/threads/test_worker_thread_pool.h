@@ -153,6 +153,230 @@ TEST_CASE("[WorkerThreadPool] Process 256 elements on native task group low prio
 	CHECK(callable_group_counter.get() == count - 1);
 }
 
+struct DependencyData {
+	SafeNumeric<uint32_t> step;
+	SafeNumeric<uint32_t> first_step_seen;
+	SafeNumeric<uint32_t> group_errors;
+};
+
+static void static_dependency_first(void *p_arg) {
+	DependencyData *data = (DependencyData *)p_arg;
+	OS::get_singleton()->delay_usec(10000);
+	data->step.set(1);
+}
+
+static void static_dependency_second(void *p_arg) {
+	DependencyData *data = (DependencyData *)p_arg;
+	data->first_step_seen.set(data->step.get());
+	OS::get_singleton()->delay_usec(10000);
+	data->step.set(2);
+}
+
+static void static_dependency_group(void *p_arg, uint32_t p_index) {
+	DependencyData *data = (DependencyData *)p_arg;
+	if (data->step.get() != 2) {
+		data->group_errors.increment();
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Tasks and groups wait for their dependencies") {
+	DependencyData data;
+
+	WorkerThreadPool::TaskID first = WorkerThreadPool::get_singleton()->add_native_task(static_dependency_first, &data, true);
+	Vector<WorkerThreadPool::TaskID> first_dependencies;
+	first_dependencies.push_back(first);
+	WorkerThreadPool::TaskID second = WorkerThreadPool::get_singleton()->add_native_task(static_dependency_second, &data, true, String(), first_dependencies);
+	Vector<WorkerThreadPool::TaskID> second_dependencies;
+	second_dependencies.push_back(second);
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_dependency_group, &data, 64, -1, true, String(), second_dependencies);
+
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	CHECK(data.first_step_seen.get() == 1);
+	CHECK(data.group_errors.get() == 0);
+
+	// Dependencies were all completed, so waiting on them must not block.
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(second);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(first);
+}
+
+TEST_CASE("[WorkerThreadPool] Completed dependencies are ignored") {
+	SafeNumeric<uint32_t> counter;
+	WorkerThreadPool::TaskID first = WorkerThreadPool::get_singleton()->add_native_task(static_test, &counter, true);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(first);
+
+	Vector<WorkerThreadPool::TaskID> dependencies;
+	dependencies.push_back(first);
+	WorkerThreadPool::TaskID second = WorkerThreadPool::get_singleton()->add_native_task(static_test, &counter, true, String(), dependencies);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(second);
+
+	CHECK(counter.get() == 2);
+}
+
+static void static_group_count_test(void *p_arg, uint32_t p_index) {
+	SafeNumeric<uint32_t> *counter = (SafeNumeric<uint32_t> *)p_arg;
+	counter->increment();
+}
+
+struct NestedData {
+	WorkerThreadPool *pool = nullptr;
+	SafeNumeric<uint32_t> counter;
+};
+
+static void static_nested_group_test(void *p_arg, uint32_t p_index) {
+	NestedData *data = (NestedData *)p_arg;
+	// Posted from inside a task, so in work stealing mode it goes to the queue of this thread.
+	WorkerThreadPool::GroupID group = data->pool->add_native_group_task(static_group_count_test, &data->counter, 64, -1, true);
+	data->pool->wait_for_group_task_completion(group);
+}
+
+static void static_nested_task_test(void *p_arg) {
+	NestedData *data = (NestedData *)p_arg;
+	WorkerThreadPool::TaskID task = data->pool->add_native_task(static_test, &data->counter, true);
+	data->pool->wait_for_task_completion(task);
+}
+
+TEST_CASE("[WorkerThreadPool] Work stealing mode processes group tasks") {
+	WorkerThreadPool *pool = memnew(WorkerThreadPool);
+	pool->init(4, false, 0.3, true);
+	REQUIRE(pool->is_using_work_stealing());
+	CHECK_MESSAGE(WorkerThreadPool::get_singleton() != pool, "Additional pools should not replace the singleton.");
+
+	const int count = 256;
+	SafeNumeric<uint32_t> counter;
+	WorkerThreadPool::GroupID group = pool->add_native_group_task(static_group_count_test, &counter, count, -1, true);
+	pool->wait_for_group_task_completion(group);
+	CHECK(counter.get() == count);
+
+	callable_group_counter.set(0);
+	group = pool->add_group_task(callable_mp_static(static_callable_group_test), count, -1, true);
+	pool->wait_for_group_task_completion(group);
+	CHECK(callable_group_counter.get() == count - 1);
+
+	memdelete(pool);
+}
+
+TEST_CASE("[WorkerThreadPool] Work stealing mode supports nested waits") {
+	WorkerThreadPool *pool = memnew(WorkerThreadPool);
+	pool->init(4, false, 0.3, true);
+
+	// More outer elements than threads, so every thread ends up waiting while tasks are still queued.
+	const int outer_count = 16;
+	NestedData data;
+	data.pool = pool;
+	WorkerThreadPool::GroupID group = pool->add_native_group_task(static_nested_group_test, &data, outer_count, -1, true);
+	pool->wait_for_group_task_completion(group);
+	CHECK(data.counter.get() == outer_count * 64);
+
+	data.counter.set(0);
+	WorkerThreadPool::TaskID tasks[outer_count];
+	for (int i = 0; i < outer_count; i++) {
+		tasks[i] = pool->add_native_task(static_nested_task_test, &data, true);
+	}
+	for (int i = 0; i < outer_count; i++) {
+		pool->wait_for_task_completion(tasks[i]);
+	}
+	CHECK(data.counter.get() == outer_count);
+
+	memdelete(pool);
+}
+
+TEST_CASE("[WorkerThreadPool] Work stealing mode processes low priority tasks") {
+	WorkerThreadPool *pool = memnew(WorkerThreadPool);
+	// Not using system threads, so low priority tasks are limited to a share of the pool and queued beyond that.
+	pool->init(4, false, 0.3, true);
+
+	const int count = 64;
+	SafeNumeric<uint32_t> counter;
+	WorkerThreadPool::TaskID tasks[count];
+	for (int i = 0; i < count; i++) {
+		tasks[i] = pool->add_native_task(static_test, &counter, false);
+	}
+	for (int i = 0; i < count; i++) {
+		pool->wait_for_task_completion(tasks[i]);
+	}
+	CHECK(counter.get() == count);
+
+	counter.set(0);
+	WorkerThreadPool::GroupID group = pool->add_native_group_task(static_group_count_test, &counter, 256, -1, false);
+	pool->wait_for_group_task_completion(group);
+	CHECK(counter.get() == 256);
+
+	memdelete(pool);
+}
+
+struct BlockedWaitData {
+	WorkerThreadPool *pool = nullptr;
+	WorkerThreadPool::TaskID dependency = WorkerThreadPool::INVALID_TASK_ID;
+	SafeNumeric<uint32_t> counter;
+};
+
+static void static_delayed_test(void *p_arg) {
+	// Long enough for every pool thread to block while waiting.
+	OS::get_singleton()->delay_usec(20000);
+}
+
+static void static_wait_for_dependent_test(void *p_arg) {
+	BlockedWaitData *data = (BlockedWaitData *)p_arg;
+	Vector<WorkerThreadPool::TaskID> dependencies;
+	dependencies.push_back(data->dependency);
+	WorkerThreadPool::TaskID task = data->pool->add_native_task(static_test, &data->counter, true, String(), dependencies);
+	data->pool->wait_for_task_completion(task);
+}
+
+TEST_CASE("[WorkerThreadPool] Work stealing mode wakes blocked waiters for new tasks") {
+	WorkerThreadPool *pool = memnew(WorkerThreadPool);
+	// Using system threads for low priority tasks, so the dependency completes outside the pool.
+	pool->init(4, true, 0.3, true);
+
+	BlockedWaitData data;
+	data.pool = pool;
+	data.dependency = pool->add_native_task(static_delayed_test, nullptr, false);
+
+	// Every pool thread waits for a task which is only posted, from outside the pool, once the dependency completes.
+	const int count = 4;
+	WorkerThreadPool::TaskID tasks[count];
+	for (int i = 0; i < count; i++) {
+		tasks[i] = pool->add_native_task(static_wait_for_dependent_test, &data, true);
+	}
+	for (int i = 0; i < count; i++) {
+		pool->wait_for_task_completion(tasks[i]);
+	}
+	CHECK(data.counter.get() == count);
+
+	pool->wait_for_task_completion(data.dependency);
+	memdelete(pool);
+}
+
+struct GroupDependentData {
+	WorkerThreadPool::GroupID group = WorkerThreadPool::INVALID_TASK_ID;
+	SafeNumeric<uint32_t> group_counter;
+	SafeNumeric<uint32_t> dependent_counter;
+};
+
+static void static_add_group_dependent(void *p_arg) {
+	GroupDependentData *data = (GroupDependentData *)p_arg;
+	Vector<WorkerThreadPool::TaskID> dependencies;
+	dependencies.push_back(data->group);
+	WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task(static_test, &data->dependent_counter, true, String(), dependencies);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+}
+
+TEST_CASE("[WorkerThreadPool] Tasks can depend on a group while it is waited for") {
+	const int iterations = 256;
+	GroupDependentData data;
+	for (int i = 0; i < iterations; i++) {
+		data.group = WorkerThreadPool::get_singleton()->add_native_group_task(static_group_count_test, &data.group_counter, 16, -1, true);
+		// Races the dependency registration against the group being completed and freed.
+		Thread thread;
+		thread.start(static_add_group_dependent, &data);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(data.group);
+		thread.wait_to_finish();
+	}
+
+	CHECK(data.group_counter.get() == iterations * 16);
+	CHECK(data.dependent_counter.get() == iterations);
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
@@ -37,6 +37,71 @@
 
 namespace TestNode {
 
+class ThreadGroupTestNode : public Node {
+	GDCLASS(ThreadGroupTestNode, Node);
+
+protected:
+	void _notification(int p_what) {
+		switch (p_what) {
+			case NOTIFICATION_PROCESS: {
+				process_count++;
+				process_thread = Thread::get_caller_id();
+				notify_deferred_thread_group(NOTIFICATION_TEST_DEFERRED);
+			} break;
+			case NOTIFICATION_TEST_DEFERRED: {
+				deferred_count++;
+				deferred_thread = Thread::get_caller_id();
+			} break;
+		}
+	}
+
+public:
+	enum {
+		NOTIFICATION_TEST_DEFERRED = 10000,
+	};
+
+	int process_count = 0;
+	int deferred_count = 0;
+	Thread::ID process_thread = 0;
+	Thread::ID deferred_thread = 0;
+};
+
+class ThreadGuardTestNode : public Node {
+	GDCLASS(ThreadGuardTestNode, Node);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what != NOTIFICATION_PROCESS) {
+			return;
+		}
+
+		// Accessing a node of another group.
+		if (foreign_node) {
+			foreign_node->set_multiplayer_authority(2, false);
+		}
+		// Changing the tree, even from inside the own group.
+		Node *child = memnew(Node);
+		add_child(child);
+		child_added = child->get_parent() == this;
+		if (!child_added) {
+			memdelete(child);
+		}
+		// Nodes outside the tree can be used freely.
+		Node *outside = memnew(Node);
+		Node *outside_child = memnew(Node);
+		outside->add_child(outside_child);
+		outside_child_added = outside_child->get_parent() == outside;
+		memdelete(outside);
+		// This node belongs to the caller's group.
+		set_multiplayer_authority(3, false);
+	}
+
+public:
+	Node *foreign_node = nullptr;
+	bool child_added = false;
+	bool outside_child_added = false;
+};
+
 TEST_CASE("[SceneTree][Node] Testing node operations with a very simple scene tree") {
 	Node *node = memnew(Node);
 
@@ -510,6 +575,90 @@ TEST_CASE("[Node] Processing") {
 	memdelete(node);
 }
 
+TEST_CASE("[SceneTree][Node] Process thread groups") {
+	ThreadGroupTestNode *group_a = memnew(ThreadGroupTestNode);
+	ThreadGroupTestNode *group_a_child = memnew(ThreadGroupTestNode);
+	ThreadGroupTestNode *group_b = memnew(ThreadGroupTestNode);
+	ThreadGroupTestNode *main_thread_node = memnew(ThreadGroupTestNode);
+
+	group_a->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+	group_b->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+	CHECK_EQ(group_a_child->get_process_thread_group(), Node::PROCESS_THREAD_GROUP_INHERIT);
+
+	group_a->add_child(group_a_child);
+	SceneTree::get_singleton()->get_root()->add_child(group_a);
+	SceneTree::get_singleton()->get_root()->add_child(group_b);
+	SceneTree::get_singleton()->get_root()->add_child(main_thread_node);
+
+	ThreadGroupTestNode *nodes[] = { group_a, group_a_child, group_b, main_thread_node };
+	for (ThreadGroupTestNode *node : nodes) {
+		node->set_process(true);
+	}
+
+	SceneTree::get_singleton()->process(0.0);
+
+	for (ThreadGroupTestNode *node : nodes) {
+		CHECK_EQ(node->process_count, 1);
+		CHECK_EQ(node->deferred_count, 1);
+		CHECK_EQ(node->deferred_thread, Thread::get_main_id());
+	}
+	CHECK_EQ(main_thread_node->process_thread, Thread::get_main_id());
+	CHECK_EQ(group_a->process_thread, group_a_child->process_thread);
+
+	SUBCASE("Changing the thread group of a node in the tree updates its children") {
+		group_a->set_process_thread_group(Node::PROCESS_THREAD_GROUP_MAIN_THREAD);
+
+		SceneTree::get_singleton()->process(0.0);
+
+		CHECK_EQ(group_a->process_count, 2);
+		CHECK_EQ(group_a_child->process_count, 2);
+		CHECK_EQ(group_a->process_thread, Thread::get_main_id());
+		CHECK_EQ(group_a_child->process_thread, Thread::get_main_id());
+	}
+
+	memdelete(group_a);
+	memdelete(group_b);
+	memdelete(main_thread_node);
+}
+
+TEST_CASE("[SceneTree][Node] Process thread groups reject accesses from other groups") {
+	ThreadGuardTestNode *group_node = memnew(ThreadGuardTestNode);
+	Node *other_group_node = memnew(Node);
+	Node *main_thread_node = memnew(Node);
+
+	group_node->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+	other_group_node->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+	SceneTree::get_singleton()->get_root()->add_child(group_node);
+	SceneTree::get_singleton()->get_root()->add_child(other_group_node);
+	SceneTree::get_singleton()->get_root()->add_child(main_thread_node);
+	group_node->set_process(true);
+
+	SUBCASE("Node of another sub-thread group") {
+		group_node->foreign_node = other_group_node;
+	}
+	SUBCASE("Node processed on the main thread") {
+		group_node->foreign_node = main_thread_node;
+	}
+
+	ERR_PRINT_OFF;
+	SceneTree::get_singleton()->process(0.0);
+	ERR_PRINT_ON;
+
+	CHECK_MESSAGE(group_node->foreign_node->get_multiplayer_authority() == 1, "Nodes of other groups should not be modified.");
+	CHECK_MESSAGE(group_node->get_multiplayer_authority() == 3, "Nodes of the caller's group should be modified.");
+	CHECK_FALSE_MESSAGE(group_node->child_added, "The scene tree should not be changed from a sub-thread group.");
+	CHECK_EQ(group_node->get_child_count(), 0);
+	CHECK_MESSAGE(group_node->outside_child_added, "Nodes outside the tree should be usable from a sub-thread group.");
+
+	// Outside of group processing, everything is accessible again.
+	CHECK(group_node->is_accessible_from_caller_thread());
+	CHECK(group_node->is_tree_editable_from_caller_thread());
+
+	memdelete(group_node);
+	memdelete(other_group_node);
+	memdelete(main_thread_node);
+}
+
 } // namespace TestNode
 
 #endif // TEST_NODE_H
@@ -0,0 +1,94 @@
+/**************************************************************************/
+/*  test_packed_scene.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PACKED_SCENE_H
+#define TEST_PACKED_SCENE_H
+
+#include "scene/2d/node_2d.h"
+#include "scene/gui/control.h"
+#include "scene/resources/packed_scene.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPackedScene {
+
+TEST_CASE("[PackedScene] Instantiation sets the packed properties") {
+	Node2D *root = memnew(Node2D);
+	root->set_name("Root");
+	root->set_position(Vector2(10, 20));
+	root->set_rotation(0.5);
+	root->add_to_group("packed");
+
+	Control *child = memnew(Control);
+	child->set_name("Child");
+	child->set_offset(SIDE_LEFT, 4);
+	child->set_offset(SIDE_BOTTOM, 32);
+	root->add_child(child);
+	child->set_owner(root);
+
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	REQUIRE(packed_scene->pack(root) == OK);
+	memdelete(root);
+
+	// The second instance reuses the setters resolved for the first one.
+	for (int i = 0; i < 2; i++) {
+		Node2D *instance = Object::cast_to<Node2D>(packed_scene->instantiate());
+		REQUIRE(instance != nullptr);
+		CHECK(instance->get_position().is_equal_approx(Vector2(10, 20)));
+		CHECK(Math::is_equal_approx(instance->get_rotation(), (real_t)0.5));
+		CHECK(instance->is_in_group("packed"));
+
+		Control *instance_child = Object::cast_to<Control>(instance->get_node_or_null(NodePath("Child")));
+		REQUIRE(instance_child != nullptr);
+		CHECK(instance_child->get_owner() == instance);
+		CHECK(instance_child->get_offset(SIDE_LEFT) == doctest::Approx(4));
+		CHECK(instance_child->get_offset(SIDE_BOTTOM) == doctest::Approx(32));
+		memdelete(instance);
+	}
+
+	// Packing again must not reuse the setters of the previous scene.
+	Node2D *other_root = memnew(Node2D);
+	other_root->set_name("Root");
+	other_root->set_scale(Vector2(2, 3));
+	REQUIRE(packed_scene->pack(other_root) == OK);
+	memdelete(other_root);
+
+	Node2D *instance = Object::cast_to<Node2D>(packed_scene->instantiate());
+	REQUIRE(instance != nullptr);
+	CHECK(instance->get_scale().is_equal_approx(Vector2(2, 3)));
+	CHECK(instance->get_position().is_equal_approx(Vector2()));
+	CHECK(instance->get_child_count() == 0);
+	memdelete(instance);
+}
+
+} // namespace TestPackedScene
+
+#endif // TEST_PACKED_SCENE_H
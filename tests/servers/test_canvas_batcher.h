@@ -0,0 +1,243 @@
+/**************************************************************************/
+/*  test_canvas_batcher.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_CANVAS_BATCHER_H
+#define TEST_CANVAS_BATCHER_H
+
+#include "servers/rendering/renderer_canvas_batcher.h"
+
+#include "tests/test_macros.h"
+
+namespace TestCanvasBatcher {
+typedef RendererCanvasRender::Item Item;
+typedef RendererCanvasBatcher::Batch Batch;
+typedef RendererCanvasBatcher::Vertex Vertex;
+
+static bool texture_size_func(void *p_userdata, RID p_texture, RS::CanvasItemTextureFilter p_filter, RS::CanvasItemTextureRepeat p_repeat, Size2 &r_size) {
+	if (p_texture.is_null()) {
+		return false;
+	}
+	r_size = Size2(64, 32);
+	return true;
+}
+
+static Item::CommandRect *add_rect(Item &r_item, const Rect2 &p_rect, RID p_texture, const Color &p_modulate = Color(1, 1, 1)) {
+	Item::CommandRect *rect = r_item.alloc_command<Item::CommandRect>();
+	rect->rect = p_rect;
+	rect->texture = p_texture;
+	rect->modulate = p_modulate;
+	return rect;
+}
+
+static void add_items(RendererCanvasBatcher &r_batcher, Item *p_items, int p_count, bool p_batchable = true) {
+	for (int i = 0; i < p_count; i++) {
+		r_batcher.add_item(&p_items[i], p_items[i].final_transform, RS::CANVAS_ITEM_TEXTURE_FILTER_LINEAR, RS::CANVAS_ITEM_TEXTURE_REPEAT_DISABLED, p_batchable);
+	}
+}
+
+TEST_CASE("[CanvasBatcher] Consecutive items sharing a texture are merged") {
+	const RID texture = RID::from_uint64(1);
+
+	Item items[3];
+	for (int i = 0; i < 3; i++) {
+		add_rect(items[i], Rect2(0, 0, 10, 10), texture, Color(0.5, 1, 1));
+		items[i].final_transform = Transform2D(0, Vector2(100 * i, 0));
+	}
+	items[1].final_modulate = Color(1, 1, 1, 0.5);
+
+	RendererCanvasBatcher batcher;
+	batcher.begin(texture_size_func, nullptr);
+	add_items(batcher, items, 3);
+
+	const LocalVector<Batch> &batches = batcher.get_batches();
+	REQUIRE(batches.size() == 1);
+	CHECK(batches[0].batched);
+	CHECK(batches[0].item_from == 0);
+	CHECK(batches[0].item_count == 3);
+	CHECK(batches[0].texture == texture);
+	CHECK(batches[0].vertex_from == 0);
+	CHECK(batches[0].vertex_count == 18);
+
+	// Two triangles per rect, following the quad index order.
+	const LocalVector<Vertex> &vertices = batcher.get_vertices();
+	REQUIRE(vertices.size() == 18);
+	const Vector2 expected_positions[6] = { Vector2(100, 0), Vector2(100, 10), Vector2(110, 10), Vector2(100, 0), Vector2(110, 10), Vector2(110, 0) };
+	const Vector2 expected_uvs[6] = { Vector2(0, 0), Vector2(0, 1), Vector2(1, 1), Vector2(0, 0), Vector2(1, 1), Vector2(1, 0) };
+	for (int i = 0; i < 6; i++) {
+		const Vertex &vertex = vertices[6 + i];
+		CHECK(Vector2(vertex.position[0], vertex.position[1]).is_equal_approx(expected_positions[i]));
+		CHECK(Vector2(vertex.uv[0], vertex.uv[1]).is_equal_approx(expected_uvs[i]));
+		CHECK(Color(vertex.color[0], vertex.color[1], vertex.color[2], vertex.color[3]).is_equal_approx(Color(0.5, 1, 1, 0.5)));
+	}
+}
+
+TEST_CASE("[CanvasBatcher] Batches are split by texture, clip and unbatchable items") {
+	const RID texture_a = RID::from_uint64(1);
+	const RID texture_b = RID::from_uint64(2);
+
+	Item clip;
+	Item items[6];
+	add_rect(items[0], Rect2(0, 0, 10, 10), texture_a);
+	add_rect(items[1], Rect2(0, 0, 10, 10), texture_b);
+	add_rect(items[2], Rect2(0, 0, 10, 10), texture_b);
+	items[2].final_clip_owner = &clip;
+	add_rect(items[3], Rect2(0, 0, 10, 10), texture_b)->flags |= RendererCanvasRender::CANVAS_RECT_MSDF;
+	items[3].final_clip_owner = &clip;
+	add_rect(items[4], Rect2(0, 0, 10, 10), texture_b);
+	items[4].final_clip_owner = &clip;
+	// Only transforms, joins the current batch without drawing.
+	items[5].alloc_command<Item::CommandTransform>();
+	items[5].final_clip_owner = &clip;
+
+	RendererCanvasBatcher batcher;
+	batcher.begin(texture_size_func, nullptr);
+	add_items(batcher, items, 6);
+
+	const LocalVector<Batch> &batches = batcher.get_batches();
+	REQUIRE(batches.size() == 5);
+	CHECK(batches[0].texture == texture_a);
+	CHECK(batches[1].texture == texture_b);
+	CHECK(batches[2].clip_owner == &clip);
+	CHECK(batches[2].item_count == 1);
+	CHECK_FALSE(batches[3].batched);
+	CHECK(batches[3].item_from == 3);
+	CHECK(batches[3].vertex_count == 0);
+	CHECK(batches[4].batched);
+	CHECK(batches[4].item_from == 4);
+	CHECK(batches[4].item_count == 2);
+	CHECK(batches[4].vertex_count == 6);
+	CHECK(batcher.get_vertices().size() == 24);
+
+	// Items the renderer can't batch always get their own run.
+	batcher.begin(texture_size_func, nullptr);
+	add_items(batcher, items, 2, false);
+	REQUIRE(batcher.get_batches().size() == 2);
+	CHECK_FALSE(batcher.get_batches()[0].batched);
+	CHECK(batcher.get_vertices().is_empty());
+}
+
+TEST_CASE("[CanvasBatcher] Regions, flips and tiling") {
+	const RID texture = RID::from_uint64(1);
+
+	Item item;
+	item.final_transform = Transform2D();
+	Item::CommandRect *rect = add_rect(item, Rect2(0, 0, 16, 16), texture);
+	rect->source = Rect2(16, 8, 32, 16);
+	rect->flags = RendererCanvasRender::CANVAS_RECT_REGION | RendererCanvasRender::CANVAS_RECT_FLIP_H;
+
+	RendererCanvasBatcher batcher;
+	batcher.begin(texture_size_func, nullptr);
+	add_items(batcher, &item, 1);
+
+	// Flipping mirrors the vertices, the UVs cover the region in the same order.
+	const LocalVector<Vertex> &vertices = batcher.get_vertices();
+	REQUIRE(vertices.size() == 6);
+	CHECK(Vector2(vertices[0].uv[0], vertices[0].uv[1]).is_equal_approx(Vector2(0.25, 0.25)));
+	CHECK(Vector2(vertices[0].position[0], vertices[0].position[1]).is_equal_approx(Vector2(16, 0)));
+	CHECK(Vector2(vertices[2].uv[0], vertices[2].uv[1]).is_equal_approx(Vector2(0.75, 0.75)));
+	CHECK(Vector2(vertices[2].position[0], vertices[2].position[1]).is_equal_approx(Vector2(0, 16)));
+
+	// Tiling enables repeat for the batch.
+	rect->flags |= RendererCanvasRender::CANVAS_RECT_TILE;
+	batcher.begin(texture_size_func, nullptr);
+	add_items(batcher, &item, 1);
+	REQUIRE(batcher.get_batches().size() == 1);
+	CHECK(batcher.get_batches()[0].repeat == RS::CANVAS_ITEM_TEXTURE_REPEAT_ENABLED);
+
+	// Regions can't be mapped without knowing the texture size.
+	batcher.begin(nullptr, nullptr);
+	add_items(batcher, &item, 1);
+	REQUIRE(batcher.get_batches().size() == 1);
+	CHECK_FALSE(batcher.get_batches()[0].batched);
+}
+
+TEST_CASE("[CanvasBatcher] Nine-patches and primitives") {
+	const RID texture = RID::from_uint64(1);
+
+	Item item;
+	item.final_transform = Transform2D();
+	Item::CommandNinePatch *np = item.alloc_command<Item::CommandNinePatch>();
+	np->rect = Rect2(0, 0, 100, 50);
+	np->source = Rect2();
+	np->texture = texture;
+	np->color = Color(1, 1, 1);
+	np->axis_x = RS::NINE_PATCH_STRETCH;
+	np->axis_y = RS::NINE_PATCH_STRETCH;
+	np->margin[SIDE_LEFT] = 8;
+	np->margin[SIDE_TOP] = 4;
+	np->margin[SIDE_RIGHT] = 8;
+	np->margin[SIDE_BOTTOM] = 4;
+
+	RendererCanvasBatcher batcher;
+	batcher.begin(texture_size_func, nullptr);
+	add_items(batcher, &item, 1);
+	REQUIRE(batcher.get_batches().size() == 1);
+	CHECK(batcher.get_batches()[0].batched);
+	CHECK(batcher.get_vertices().size() == 9 * 6);
+
+	// The center patch starts at the margins, both on screen and in the 64x32 texture.
+	const Vertex &center = batcher.get_vertices()[4 * 6];
+	CHECK(Vector2(center.position[0], center.position[1]).is_equal_approx(Vector2(8, 4)));
+	CHECK(Vector2(center.uv[0], center.uv[1]).is_equal_approx(Vector2(0.125, 0.125)));
+
+	np->draw_center = false;
+	batcher.begin(texture_size_func, nullptr);
+	add_items(batcher, &item, 1);
+	CHECK(batcher.get_vertices().size() == 8 * 6);
+
+	// Tiled axes are mapped per pixel by the shader.
+	np->axis_x = RS::NINE_PATCH_TILE;
+	batcher.begin(texture_size_func, nullptr);
+	add_items(batcher, &item, 1);
+	CHECK_FALSE(batcher.get_batches()[0].batched);
+
+	Item primitive_item;
+	primitive_item.final_transform = Transform2D();
+	Item::CommandPrimitive *primitive = primitive_item.alloc_command<Item::CommandPrimitive>();
+	primitive->point_count = 4;
+	for (int i = 0; i < 4; i++) {
+		primitive->points[i] = Vector2(i, i);
+		primitive->uvs[i] = Vector2();
+		primitive->colors[i] = Color(1, 1, 1);
+	}
+	batcher.begin(texture_size_func, nullptr);
+	add_items(batcher, &primitive_item, 1);
+	REQUIRE(batcher.get_vertices().size() == 6);
+	CHECK(batcher.get_vertices()[5].position[0] == doctest::Approx(3));
+
+	// Lines and points aren't batched.
+	primitive->point_count = 2;
+	batcher.begin(texture_size_func, nullptr);
+	add_items(batcher, &primitive_item, 1);
+	CHECK_FALSE(batcher.get_batches()[0].batched);
+}
+} // namespace TestCanvasBatcher
+
+#endif // TEST_CANVAS_BATCHER_H
@@ -31,16 +31,345 @@
 #ifndef TEST_NAVIGATION_SERVER_3D_H
 #define TEST_NAVIGATION_SERVER_3D_H
 
+#include "core/config/project_settings.h"
 #include "servers/navigation_server_3d.h"
 
 #include "tests/test_macros.h"
 
 namespace TestNavigationServer3D {
+class PathQueryBatchReceiver : public Object {
+public:
+	int calls = 0;
+	uint32_t batch_id = 0;
+	TypedArray<NavigationPathQueryResult3D> results;
+
+	void receive(uint32_t p_batch_id, const TypedArray<NavigationPathQueryResult3D> &p_results) {
+		calls++;
+		batch_id = p_batch_id;
+		results = p_results;
+	}
+};
+
+// Queues another batch from its callback, the first time it's called.
+class PathQueryBatchRequeuer : public PathQueryBatchReceiver {
+public:
+	TypedArray<NavigationPathQueryParameters3D> parameters;
+	uint32_t requeued_batch_id = 0;
+
+	void receive_and_requeue(uint32_t p_batch_id, const TypedArray<NavigationPathQueryResult3D> &p_results) {
+		receive(p_batch_id, p_results);
+		if (calls == 1) {
+			requeued_batch_id = NavigationServer3D::get_singleton()->query_path_batch(parameters, callable_mp(this, &PathQueryBatchRequeuer::receive_and_requeue));
+		}
+	}
+};
+
+// Creates a navigation mesh with a unit square polygon for every '#' cell, rows along the z axis.
+static Ref<NavigationMesh> create_grid_navigation_mesh(const Vector<String> &p_rows) {
+	const int width = p_rows[0].length();
+	Vector<Vector3> vertices;
+	for (int z = 0; z <= p_rows.size(); z++) {
+		for (int x = 0; x <= width; x++) {
+			vertices.push_back(Vector3(x, 0, z));
+		}
+	}
+
+	Ref<NavigationMesh> navigation_mesh;
+	navigation_mesh.instantiate();
+	navigation_mesh->set_vertices(vertices);
+	for (int z = 0; z < p_rows.size(); z++) {
+		for (int x = 0; x < width; x++) {
+			if (p_rows[z][x] != '#') {
+				continue;
+			}
+			Vector<int> polygon;
+			polygon.push_back(z * (width + 1) + x);
+			polygon.push_back((z + 1) * (width + 1) + x);
+			polygon.push_back((z + 1) * (width + 1) + x + 1);
+			polygon.push_back(z * (width + 1) + x + 1);
+			navigation_mesh->add_polygon(polygon);
+		}
+	}
+	return navigation_mesh;
+}
+
+// The search limit is read when the map is created.
+static RID create_grid_map(const Vector<String> &p_rows, int p_max_search_polygons, RID &r_region) {
+	NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+	const Variant max_search_polygons = GLOBAL_GET("navigation/pathfinding/max_search_polygons");
+	ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/max_search_polygons", p_max_search_polygons);
+	RID map = navigation_server->map_create();
+	ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/max_search_polygons", max_search_polygons);
+	navigation_server->map_set_active(map, true);
+
+	r_region = navigation_server->region_create();
+	navigation_server->region_set_navigation_mesh(r_region, create_grid_navigation_mesh(p_rows));
+	navigation_server->region_set_map(r_region, map);
+	navigation_server->process(0.0);
+	return map;
+}
+
+static void free_grid_map(RID p_map, RID p_region) {
+	NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+	navigation_server->free(p_region);
+	navigation_server->free(p_map);
+	navigation_server->process(0.0);
+}
+
 TEST_SUITE("[Navigation]") {
 	TEST_CASE("[NavigationServer3D] Server should be empty when initialized") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
 		CHECK_EQ(navigation_server->get_maps().size(), 0);
 	}
+
+	TEST_CASE("[NavigationServer3D] Path query batches should be dispatched on process") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->process(0.0); // Apply the map changes.
+
+		Ref<NavigationPathQueryParameters3D> query_parameters;
+		query_parameters.instantiate();
+		query_parameters->set_map(map);
+		query_parameters->set_start_position(Vector3(0, 0, 0));
+		query_parameters->set_target_position(Vector3(10, 0, 0));
+
+		TypedArray<NavigationPathQueryParameters3D> batch;
+		batch.push_back(query_parameters);
+		batch.push_back(query_parameters);
+
+		PathQueryBatchReceiver receiver;
+		const uint32_t batch_id = navigation_server->query_path_batch(batch, callable_mp(&receiver, &PathQueryBatchReceiver::receive));
+		CHECK_NE(batch_id, 0);
+		CHECK_EQ(receiver.calls, 0);
+
+		navigation_server->process(0.0);
+		CHECK(navigation_server->is_path_query_batch_completed(batch_id));
+		CHECK_EQ(receiver.calls, 1);
+		CHECK_EQ(receiver.batch_id, batch_id);
+		REQUIRE_EQ(receiver.results.size(), 2);
+
+		// The map has no regions, so there is no path to find.
+		Ref<NavigationPathQueryResult3D> result = receiver.results[0];
+		REQUIRE(result.is_valid());
+		CHECK(result->get_path().is_empty());
+
+		navigation_server->free(map);
+		navigation_server->process(0.0);
+	}
+
+	TEST_CASE("[NavigationServer3D] Path query batches should not be affected by maps created while they run") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Vector<String> rows;
+		rows.push_back("################");
+		RID region;
+		RID map = create_grid_map(rows, 0, region);
+
+		const Vector3 destination(15.5, 0, 0.5);
+		Ref<NavigationPathQueryParameters3D> query_parameters;
+		query_parameters.instantiate();
+		query_parameters->set_map(map);
+		query_parameters->set_start_position(Vector3(0.5, 0, 0.5));
+		query_parameters->set_target_position(destination);
+
+		TypedArray<NavigationPathQueryParameters3D> batch;
+		for (int i = 0; i < 64; i++) {
+			batch.push_back(query_parameters);
+		}
+
+		PathQueryBatchReceiver receiver;
+		const uint32_t batch_id = navigation_server->query_path_batch(batch, callable_mp(&receiver, &PathQueryBatchReceiver::receive));
+		REQUIRE_NE(batch_id, 0);
+
+		// Creating maps grows the map storage while the queries are running.
+		LocalVector<RID> created_maps;
+		for (int i = 0; i < 256; i++) {
+			created_maps.push_back(navigation_server->map_create());
+		}
+
+		navigation_server->process(0.0);
+		CHECK_EQ(receiver.calls, 1);
+		REQUIRE_EQ(receiver.results.size(), 64);
+		int wrong_paths = 0;
+		for (int i = 0; i < receiver.results.size(); i++) {
+			Ref<NavigationPathQueryResult3D> result = receiver.results[i];
+			const Vector<Vector3> path = result->get_path();
+			if (path.is_empty() || !path[path.size() - 1].is_equal_approx(destination)) {
+				wrong_paths++;
+			}
+		}
+		CHECK_EQ(wrong_paths, 0);
+
+		for (const RID &created_map : created_maps) {
+			navigation_server->free(created_map);
+		}
+		free_grid_map(map, region);
+	}
+
+	TEST_CASE("[NavigationServer3D] Path query batches queued by callbacks should be dispatched on the next process") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Vector<String> rows;
+		rows.push_back("####");
+		RID region;
+		RID map = create_grid_map(rows, 0, region);
+
+		Ref<NavigationPathQueryParameters3D> query_parameters;
+		query_parameters.instantiate();
+		query_parameters->set_map(map);
+		query_parameters->set_start_position(Vector3(0.5, 0, 0.5));
+		query_parameters->set_target_position(Vector3(3.5, 0, 0.5));
+
+		PathQueryBatchRequeuer receiver;
+		receiver.parameters.push_back(query_parameters);
+		const uint32_t batch_id = navigation_server->query_path_batch(receiver.parameters, callable_mp(&receiver, &PathQueryBatchRequeuer::receive_and_requeue));
+		REQUIRE_NE(batch_id, 0);
+
+		navigation_server->process(0.0);
+		CHECK_EQ(receiver.calls, 1);
+		REQUIRE_NE(receiver.requeued_batch_id, 0);
+
+		navigation_server->process(0.0);
+		CHECK_EQ(receiver.calls, 2);
+		CHECK_EQ(receiver.batch_id, receiver.requeued_batch_id);
+		REQUIRE_EQ(receiver.results.size(), 1);
+		Ref<NavigationPathQueryResult3D> result = receiver.results[0];
+		const Vector<Vector3> path = result->get_path();
+		REQUIRE_FALSE(path.is_empty());
+		CHECK(path[path.size() - 1].is_equal_approx(Vector3(3.5, 0, 0.5)));
+
+		free_grid_map(map, region);
+	}
+
+	TEST_CASE("[NavigationServer3D] Map should reconnect regions that changed since the last sync") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+
+		Ref<NavigationMesh> navigation_mesh;
+		navigation_mesh.instantiate();
+		Vector<Vector3> vertices;
+		vertices.push_back(Vector3(0, 0, 0));
+		vertices.push_back(Vector3(0, 0, 1));
+		vertices.push_back(Vector3(1, 0, 1));
+		vertices.push_back(Vector3(1, 0, 0));
+		navigation_mesh->set_vertices(vertices);
+		Vector<int> polygon;
+		polygon.push_back(0);
+		polygon.push_back(1);
+		polygon.push_back(2);
+		polygon.push_back(3);
+		navigation_mesh->add_polygon(polygon);
+
+		RID region_a = navigation_server->region_create();
+		navigation_server->region_set_navigation_mesh(region_a, navigation_mesh);
+		navigation_server->region_set_map(region_a, map);
+		RID region_b = navigation_server->region_create();
+		navigation_server->region_set_navigation_mesh(region_b, navigation_mesh);
+		navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(1, 0, 0)));
+		navigation_server->region_set_map(region_b, map);
+		navigation_server->process(0.0);
+
+		const Vector3 origin(0.5, 0, 0.5);
+		const Vector3 destination(1.5, 0, 0.5);
+
+		// The regions share an edge, so the path reaches the destination.
+		Vector<Vector3> path = navigation_server->map_get_path(map, origin, destination, true);
+		REQUIRE_FALSE(path.is_empty());
+		CHECK(path[path.size() - 1].is_equal_approx(destination));
+
+		// Moving one region away disconnects it.
+		navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(5, 0, 0)));
+		navigation_server->process(0.0);
+		path = navigation_server->map_get_path(map, origin, Vector3(5.5, 0, 0.5), true);
+		REQUIRE_FALSE(path.is_empty());
+		CHECK(path[path.size() - 1].x <= 1.0 + CMP_EPSILON);
+
+		// Moving it back within the edge connection margin connects it again.
+		navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(1.1, 0, 0)));
+		navigation_server->process(0.0);
+		path = navigation_server->map_get_path(map, origin, Vector3(1.6, 0, 0.5), true);
+		REQUIRE_FALSE(path.is_empty());
+		CHECK(path[path.size() - 1].is_equal_approx(Vector3(1.6, 0, 0.5)));
+
+		// Removing the region disconnects it for good.
+		navigation_server->region_set_map(region_b, RID());
+		navigation_server->process(0.0);
+		path = navigation_server->map_get_path(map, origin, Vector3(1.6, 0, 0.5), true);
+		REQUIRE_FALSE(path.is_empty());
+		CHECK(path[path.size() - 1].x <= 1.0 + CMP_EPSILON);
+
+		navigation_server->free(region_b);
+		navigation_server->free(region_a);
+		navigation_server->free(map);
+		navigation_server->process(0.0);
+	}
+
+	TEST_CASE("[NavigationServer3D] Path queries should take the shortest route") {
+		Vector<String> rows;
+		rows.push_back("#######");
+		rows.push_back("#.....#");
+		rows.push_back("#.....#");
+		rows.push_back("#######");
+		RID region;
+		RID map = create_grid_map(rows, 0, region);
+
+		// Both sides of the ring lead to the destination, the left one is much shorter.
+		const Vector3 destination(1.5, 0, 3.5);
+		Vector<Vector3> path = NavigationServer3D::get_singleton()->map_get_path(map, Vector3(1.5, 0, 0.5), destination, true);
+		REQUIRE_FALSE(path.is_empty());
+		CHECK(path[path.size() - 1].is_equal_approx(destination));
+		for (const Vector3 &point : path) {
+			CHECK_MESSAGE(point.x <= 1.5 + CMP_EPSILON, "The path should go around the left side of the ring.");
+		}
+
+		free_grid_map(map, region);
+	}
+
+	TEST_CASE("[NavigationServer3D] Path queries should stop at the search limit") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Vector<String> rows;
+		rows.push_back("####################");
+		const Vector3 origin(0.5, 0, 0.5);
+		const Vector3 destination(19.5, 0, 0.5);
+
+		RID region;
+		RID map = create_grid_map(rows, 0, region);
+		Vector<Vector3> path = navigation_server->map_get_path(map, origin, destination, true);
+		REQUIRE_FALSE(path.is_empty());
+		CHECK(path[path.size() - 1].is_equal_approx(destination));
+		free_grid_map(map, region);
+
+		map = create_grid_map(rows, 4, region);
+		path = navigation_server->map_get_path(map, origin, destination, true);
+		REQUIRE_MESSAGE(!path.is_empty(), "The path should lead to the closest polygon visited before the limit.");
+		CHECK(path[path.size() - 1].x > 1.0);
+		CHECK(path[path.size() - 1].x < 19.0);
+		free_grid_map(map, region);
+	}
+
+	TEST_CASE("[NavigationServer3D] Path queries towards unreachable positions should stop at the search limit") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		// The destination is on a polygon which isn't connected to the others.
+		Vector<String> rows;
+		rows.push_back("##########..........#");
+		const Vector3 origin(0.5, 0, 0.5);
+		const Vector3 destination(20.5, 0, 0.5);
+
+		RID region;
+		RID map = create_grid_map(rows, 0, region);
+		Vector<Vector3> path = navigation_server->map_get_path(map, origin, destination, true);
+		REQUIRE_FALSE(path.is_empty());
+		CHECK(path[path.size() - 1].is_equal_approx(Vector3(10, 0, 0.5)));
+		free_grid_map(map, region);
+
+		// All 10 reachable polygons are visited to find the closest one, the limit is reached while searching a path to it.
+		map = create_grid_map(rows, 12, region);
+		path = navigation_server->map_get_path(map, origin, destination, true);
+		REQUIRE_MESSAGE(!path.is_empty(), "The path should lead to the closest polygon visited before the limit.");
+		CHECK(path[path.size() - 1].x > 1.0);
+		CHECK(path[path.size() - 1].x < 10.0 - CMP_EPSILON);
+		free_grid_map(map, region);
+	}
 }
 } //namespace TestNavigationServer3D
 
@@ -0,0 +1,129 @@
+/**************************************************************************/
+/*  test_occlusion_cull_raster.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_OCCLUSION_CULL_RASTER_H
+#define TEST_OCCLUSION_CULL_RASTER_H
+
+#include "servers/rendering/renderer_scene_occlusion_cull_raster.h"
+
+#include "tests/test_macros.h"
+
+namespace TestOcclusionCullRaster {
+
+typedef RendererSceneOcclusionCullRaster::RasterHZBuffer RasterHZBuffer;
+
+static void add_quad(RasterHZBuffer &r_buffer, const Vector3 &p_min, const Vector3 &p_max) {
+	const Vector3 vertices[4] = {
+		Vector3(p_min.x, p_min.y, p_min.z),
+		Vector3(p_max.x, p_min.y, p_max.z),
+		Vector3(p_max.x, p_max.y, p_max.z),
+		Vector3(p_min.x, p_max.y, p_min.z),
+	};
+	const uint32_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+	r_buffer.add_occluder(vertices, 4, indices, 6);
+}
+
+static bool is_box_occluded(const RasterHZBuffer &p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, const AABB &p_box) {
+	const Vector3 end = p_box.get_end();
+	const real_t bounds[6] = { p_box.position.x, p_box.position.y, p_box.position.z, end.x, end.y, end.z };
+	return p_buffer.is_occluded(bounds, p_cam_transform.origin, p_cam_transform.affine_inverse(), p_cam_projection, p_cam_projection.get_z_near());
+}
+
+TEST_CASE("[OcclusionCullRaster] Boxes behind a wall are occluded") {
+	RasterHZBuffer buffer;
+	buffer.resize(Size2i(64, 64));
+
+	Transform3D cam_transform;
+	Projection cam_projection;
+	cam_projection.set_perspective(60, 1.0, 0.1, 100.0);
+
+	buffer.begin(cam_transform, cam_projection, false);
+	// Only covers the left half of the view.
+	add_quad(buffer, Vector3(-20, -20, -5), Vector3(0, 20, -5));
+	buffer.end();
+
+	CHECK_MESSAGE(
+			is_box_occluded(buffer, cam_transform, cam_projection, AABB(Vector3(-3, -0.5, -9), Vector3(1, 1, 1))),
+			"A box behind the wall should be occluded.");
+	CHECK_FALSE_MESSAGE(
+			is_box_occluded(buffer, cam_transform, cam_projection, AABB(Vector3(-3, -0.5, -3), Vector3(1, 1, 1))),
+			"A box in front of the wall should not be occluded.");
+	CHECK_FALSE_MESSAGE(
+			is_box_occluded(buffer, cam_transform, cam_projection, AABB(Vector3(2, -0.5, -9), Vector3(1, 1, 1))),
+			"A box beside the wall should not be occluded.");
+
+	// Rebuilding without occluders clears the previous frame.
+	buffer.begin(cam_transform, cam_projection, false);
+	buffer.end();
+	CHECK_FALSE(is_box_occluded(buffer, cam_transform, cam_projection, AABB(Vector3(-3, -0.5, -9), Vector3(1, 1, 1))));
+}
+
+TEST_CASE("[OcclusionCullRaster] Occluders crossing the near plane are clipped") {
+	RasterHZBuffer buffer;
+	buffer.resize(Size2i(64, 64));
+
+	Transform3D cam_transform;
+	Projection cam_projection;
+	cam_projection.set_perspective(60, 1.0, 0.1, 100.0);
+
+	// A wall going from behind the camera into the distance, on its left side.
+	buffer.begin(cam_transform, cam_projection, false);
+	add_quad(buffer, Vector3(-1, -20, 10), Vector3(-1, 20, -50));
+	buffer.end();
+
+	CHECK_MESSAGE(
+			is_box_occluded(buffer, cam_transform, cam_projection, AABB(Vector3(-6, -0.5, -11), Vector3(1, 1, 1))),
+			"A box behind the clipped wall should be occluded.");
+	CHECK_FALSE_MESSAGE(
+			is_box_occluded(buffer, cam_transform, cam_projection, AABB(Vector3(2, -0.5, -11), Vector3(1, 1, 1))),
+			"A box on the other side of the camera should not be occluded.");
+}
+
+TEST_CASE("[OcclusionCullRaster] Orthogonal cameras") {
+	RasterHZBuffer buffer;
+	buffer.resize(Size2i(64, 64));
+
+	Transform3D cam_transform;
+	Projection cam_projection;
+	cam_projection.set_orthogonal(20, 1.0, 0.1, 100.0);
+
+	buffer.begin(cam_transform, cam_projection, true);
+	// Tilted, so its depth has to be interpolated.
+	add_quad(buffer, Vector3(-20, -20, -4), Vector3(0, 20, -6));
+	buffer.end();
+
+	CHECK(is_box_occluded(buffer, cam_transform, cam_projection, AABB(Vector3(-6, -0.5, -12), Vector3(1, 1, 1))));
+	CHECK_FALSE(is_box_occluded(buffer, cam_transform, cam_projection, AABB(Vector3(-6, -0.5, -3), Vector3(1, 1, 1))));
+	CHECK_FALSE(is_box_occluded(buffer, cam_transform, cam_projection, AABB(Vector3(3, -0.5, -12), Vector3(1, 1, 1))));
+}
+
+} // namespace TestOcclusionCullRaster
+
+#endif // TEST_OCCLUSION_CULL_RASTER_H
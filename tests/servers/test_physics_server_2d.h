@@ -0,0 +1,148 @@
+/**************************************************************************/
+/*  test_physics_server_2d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_2D_H
+#define TEST_PHYSICS_SERVER_2D_H
+
+#include "servers/physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer2D {
+
+static RID create_body(RID p_space, RID p_shape, const Transform2D &p_transform, PhysicsServer2D::BodyMode p_mode) {
+	PhysicsServer2D *physics_server = PhysicsServer2D::get_singleton();
+	RID body = physics_server->body_create();
+	physics_server->body_set_mode(body, p_mode);
+	physics_server->body_add_shape(body, p_shape);
+	physics_server->body_set_space(body, p_space);
+	physics_server->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, p_transform);
+	return body;
+}
+
+static RID create_box_shape(const Vector2 &p_half_extents) {
+	RID shape = PhysicsServer2D::get_singleton()->rectangle_shape_create();
+	PhysicsServer2D::get_singleton()->shape_set_data(shape, p_half_extents);
+	return shape;
+}
+
+static bool is_sleeping(RID p_body) {
+	return PhysicsServer2D::get_singleton()->body_get_state(p_body, PhysicsServer2D::BODY_STATE_SLEEPING);
+}
+
+TEST_SUITE("[Physics]") {
+	TEST_CASE("[PhysicsServer2D] Bodies are integrated the same way on every thread") {
+		PhysicsServer2D *physics_server = PhysicsServer2D::get_singleton();
+		RID space = physics_server->space_create();
+		physics_server->space_set_active(space, true);
+		RID shape = create_box_shape(Vector2(10, 10));
+
+		// Many identical bodies which can't collide, so they are spread over the worker threads but must all end up in the same state.
+		const int body_count = 256;
+		LocalVector<RID> bodies;
+		for (int i = 0; i < body_count; i++) {
+			RID body = create_body(space, shape, Transform2D(0.3, Vector2(0, -100)), PhysicsServer2D::BODY_MODE_RIGID);
+			physics_server->body_set_collision_layer(body, 0);
+			physics_server->body_set_collision_mask(body, 0);
+			physics_server->body_set_param(body, PhysicsServer2D::BODY_PARAM_LINEAR_DAMP, 0.5);
+			physics_server->body_set_state(body, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, Vector2(10, -20));
+			physics_server->body_set_state(body, PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY, 2.5);
+			physics_server->body_set_constant_force(body, Vector2(30, -10));
+			bodies.push_back(body);
+		}
+
+		for (int i = 0; i < 60; i++) {
+			physics_server->step(1.0 / 60.0);
+		}
+
+		const Transform2D expected = physics_server->body_get_state(bodies[0], PhysicsServer2D::BODY_STATE_TRANSFORM);
+		CHECK_MESSAGE(expected.get_origin().y > -100.0, "Bodies should have fallen.");
+		int mismatches = 0;
+		for (const RID &body : bodies) {
+			Transform2D transform = physics_server->body_get_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM);
+			if (transform != expected) {
+				mismatches++;
+			}
+		}
+		CHECK_EQ(mismatches, 0);
+
+		for (const RID &body : bodies) {
+			physics_server->free(body);
+		}
+		physics_server->free(shape);
+		physics_server->free(space);
+	}
+
+	TEST_CASE("[PhysicsServer2D] Islands fall asleep and wake up independently") {
+		PhysicsServer2D *physics_server = PhysicsServer2D::get_singleton();
+		RID space = physics_server->space_create();
+		physics_server->space_set_active(space, true);
+		RID floor_shape = create_box_shape(Vector2(1000, 10));
+		RID box_shape = create_box_shape(Vector2(10, 10));
+
+		RID floor = create_body(space, floor_shape, Transform2D(0, Vector2(0, 10)), PhysicsServer2D::BODY_MODE_STATIC);
+		// A stack of two boxes, and a box on its own far from it.
+		RID stack_bottom = create_body(space, box_shape, Transform2D(0, Vector2(0, -10)), PhysicsServer2D::BODY_MODE_RIGID);
+		RID stack_top = create_body(space, box_shape, Transform2D(0, Vector2(0, -30)), PhysicsServer2D::BODY_MODE_RIGID);
+		RID lone_box = create_body(space, box_shape, Transform2D(0, Vector2(200, -10)), PhysicsServer2D::BODY_MODE_RIGID);
+
+		for (int i = 0; i < 10; i++) {
+			physics_server->step(1.0 / 60.0);
+		}
+		CHECK_MESSAGE(physics_server->get_process_info(PhysicsServer2D::INFO_ISLAND_COUNT) == 2, "The stack and the lone box should be separate islands.");
+
+		for (int i = 0; i < 600 && !(is_sleeping(stack_bottom) && is_sleeping(stack_top) && is_sleeping(lone_box)); i++) {
+			physics_server->step(1.0 / 60.0);
+		}
+		REQUIRE(is_sleeping(stack_bottom));
+		REQUIRE(is_sleeping(stack_top));
+		REQUIRE(is_sleeping(lone_box));
+		CHECK_EQ(physics_server->get_process_info(PhysicsServer2D::INFO_ISLAND_COUNT), 0);
+
+		physics_server->body_apply_central_impulse(lone_box, Vector2(0, -200));
+		physics_server->step(1.0 / 60.0);
+		physics_server->step(1.0 / 60.0);
+		CHECK_FALSE(is_sleeping(lone_box));
+		CHECK_MESSAGE(is_sleeping(stack_bottom), "Waking up a body should not wake up other islands.");
+		CHECK(is_sleeping(stack_top));
+
+		physics_server->free(lone_box);
+		physics_server->free(stack_top);
+		physics_server->free(stack_bottom);
+		physics_server->free(floor);
+		physics_server->free(box_shape);
+		physics_server->free(floor_shape);
+		physics_server->free(space);
+	}
+}
+
+} // namespace TestPhysicsServer2D
+
+#endif // TEST_PHYSICS_SERVER_2D_H
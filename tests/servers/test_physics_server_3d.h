@@ -0,0 +1,148 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "servers/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+static RID create_body(RID p_space, RID p_shape, const Transform3D &p_transform, PhysicsServer3D::BodyMode p_mode) {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	RID body = physics_server->body_create();
+	physics_server->body_set_mode(body, p_mode);
+	physics_server->body_add_shape(body, p_shape);
+	physics_server->body_set_space(body, p_space);
+	physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, p_transform);
+	return body;
+}
+
+static RID create_box_shape(const Vector3 &p_half_extents) {
+	RID shape = PhysicsServer3D::get_singleton()->box_shape_create();
+	PhysicsServer3D::get_singleton()->shape_set_data(shape, p_half_extents);
+	return shape;
+}
+
+static bool is_sleeping(RID p_body) {
+	return PhysicsServer3D::get_singleton()->body_get_state(p_body, PhysicsServer3D::BODY_STATE_SLEEPING);
+}
+
+TEST_SUITE("[Physics]") {
+	TEST_CASE("[PhysicsServer3D] Bodies are integrated the same way on every thread") {
+		PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+		RID space = physics_server->space_create();
+		physics_server->space_set_active(space, true);
+		RID shape = create_box_shape(Vector3(0.5, 0.5, 0.5));
+
+		// Many identical bodies which can't collide, so they are spread over the worker threads but must all end up in the same state.
+		const int body_count = 256;
+		LocalVector<RID> bodies;
+		for (int i = 0; i < body_count; i++) {
+			RID body = create_body(space, shape, Transform3D(Basis(Vector3(1, 1, 0).normalized(), 0.3), Vector3(0, 10, 0)), PhysicsServer3D::BODY_MODE_RIGID);
+			physics_server->body_set_collision_layer(body, 0);
+			physics_server->body_set_collision_mask(body, 0);
+			physics_server->body_set_param(body, PhysicsServer3D::BODY_PARAM_LINEAR_DAMP, 0.5);
+			physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(1, 2, 3));
+			physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY, Vector3(0.5, -1, 2));
+			physics_server->body_set_constant_force(body, Vector3(3, 0, -1));
+			bodies.push_back(body);
+		}
+
+		for (int i = 0; i < 60; i++) {
+			physics_server->step(1.0 / 60.0);
+		}
+
+		const Transform3D expected = physics_server->body_get_state(bodies[0], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK_MESSAGE(expected.origin.y < 10.0, "Bodies should have fallen.");
+		int mismatches = 0;
+		for (const RID &body : bodies) {
+			Transform3D transform = physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+			if (transform != expected) {
+				mismatches++;
+			}
+		}
+		CHECK_EQ(mismatches, 0);
+
+		for (const RID &body : bodies) {
+			physics_server->free(body);
+		}
+		physics_server->free(shape);
+		physics_server->free(space);
+	}
+
+	TEST_CASE("[PhysicsServer3D] Islands fall asleep and wake up independently") {
+		PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+		RID space = physics_server->space_create();
+		physics_server->space_set_active(space, true);
+		RID floor_shape = create_box_shape(Vector3(50, 0.5, 50));
+		RID box_shape = create_box_shape(Vector3(0.5, 0.5, 0.5));
+
+		RID floor = create_body(space, floor_shape, Transform3D(Basis(), Vector3(0, -0.5, 0)), PhysicsServer3D::BODY_MODE_STATIC);
+		// A stack of two boxes, and a box on its own far from it.
+		RID stack_bottom = create_body(space, box_shape, Transform3D(Basis(), Vector3(0, 0.5, 0)), PhysicsServer3D::BODY_MODE_RIGID);
+		RID stack_top = create_body(space, box_shape, Transform3D(Basis(), Vector3(0, 1.5, 0)), PhysicsServer3D::BODY_MODE_RIGID);
+		RID lone_box = create_body(space, box_shape, Transform3D(Basis(), Vector3(10, 0.5, 0)), PhysicsServer3D::BODY_MODE_RIGID);
+
+		for (int i = 0; i < 10; i++) {
+			physics_server->step(1.0 / 60.0);
+		}
+		CHECK_MESSAGE(physics_server->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT) == 2, "The stack and the lone box should be separate islands.");
+
+		for (int i = 0; i < 600 && !(is_sleeping(stack_bottom) && is_sleeping(stack_top) && is_sleeping(lone_box)); i++) {
+			physics_server->step(1.0 / 60.0);
+		}
+		REQUIRE(is_sleeping(stack_bottom));
+		REQUIRE(is_sleeping(stack_top));
+		REQUIRE(is_sleeping(lone_box));
+		CHECK_EQ(physics_server->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT), 0);
+
+		physics_server->body_apply_central_impulse(lone_box, Vector3(0, 2, 0));
+		physics_server->step(1.0 / 60.0);
+		physics_server->step(1.0 / 60.0);
+		CHECK_FALSE(is_sleeping(lone_box));
+		CHECK_MESSAGE(is_sleeping(stack_bottom), "Waking up a body should not wake up other islands.");
+		CHECK(is_sleeping(stack_top));
+
+		physics_server->free(lone_box);
+		physics_server->free(stack_top);
+		physics_server->free(stack_bottom);
+		physics_server->free(floor);
+		physics_server->free(box_shape);
+		physics_server->free(floor_shape);
+		physics_server->free(space);
+	}
+}
+
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H
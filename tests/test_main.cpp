@@ -31,6 +31,7 @@
 #include "test_main.h"
 
 #include "tests/core/config/test_project_settings.h"
+#include "tests/core/debugger/test_trace_recorder.h"
 #include "tests/core/input/test_input_event_key.h"
 #include "tests/core/input/test_input_event_mouse.h"
 #include "tests/core/input/test_shortcut.h"
@@ -45,7 +46,9 @@
 #include "tests/core/math/test_aabb.h"
 #include "tests/core/math/test_astar.h"
 #include "tests/core/math/test_basis.h"
+#include "tests/core/math/test_bvh.h"
 #include "tests/core/math/test_color.h"
+#include "tests/core/math/test_dynamic_bvh.h"
 #include "tests/core/math/test_expression.h"
 #include "tests/core/math/test_geometry_2d.h"
 #include "tests/core/math/test_geometry_3d.h"
@@ -79,6 +82,7 @@
 #include "tests/core/templates/test_paged_array.h"
 #include "tests/core/templates/test_rid.h"
 #include "tests/core/templates/test_vector.h"
+#include "tests/core/templates/test_work_stealing_queue.h"
 #include "tests/core/test_crypto.h"
 #include "tests/core/test_hashing_context.h"
 #include "tests/core/test_time.h"
@@ -97,6 +101,7 @@
 #include "tests/scene/test_navigation_agent_2d.h"
 #include "tests/scene/test_navigation_agent_3d.h"
 #include "tests/scene/test_node.h"
+#include "tests/scene/test_packed_scene.h"
 #include "tests/scene/test_path_2d.h"
 #include "tests/scene/test_path_3d.h"
 #include "tests/scene/test_primitives.h"
@@ -105,8 +110,12 @@
 #include "tests/scene/test_theme.h"
 #include "tests/scene/test_viewport.h"
 #include "tests/scene/test_visual_shader.h"
+#include "tests/servers/test_canvas_batcher.h"
 #include "tests/servers/test_navigation_server_2d.h"
 #include "tests/servers/test_navigation_server_3d.h"
+#include "tests/servers/test_occlusion_cull_raster.h"
+#include "tests/servers/test_physics_server_2d.h"
+#include "tests/servers/test_physics_server_3d.h"
 #include "tests/servers/test_text_server.h"
 #include "tests/test_validate_testing.h"
 
@@ -259,6 +268,14 @@ struct GodotTestCaseListener : public doctest::IReporter {
 			navigation_server_3d = NavigationServer3DManager::new_default_server();
 			return;
 		}
+
+		if (suite_name.find("[Physics]") != -1 && physics_server_2d == nullptr && physics_server_3d == nullptr) {
+			physics_server_3d = PhysicsServer3DManager::get_singleton()->new_default_server();
+			physics_server_3d->init();
+			physics_server_2d = PhysicsServer2DManager::get_singleton()->new_default_server();
+			physics_server_2d->init();
+			return;
+		}
 	}
 
 	void test_case_end(const doctest::CurrentTestCaseStats &) override {